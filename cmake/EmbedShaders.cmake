@@ -0,0 +1,20 @@
+# Writes a header embedding GLSL files as raw string literals.
+#
+# Usage: cmake -DOUTPUT=<header> -DBASE=<dir> -DINPUTS=<file|file|...> -P EmbedShaders.cmake
+# Each shader is stored under its path relative to BASE (e.g. "shaders/Vert.glsl"),
+# the same path Utils::Shader is constructed with.
+
+string(REPLACE "|" ";" INPUTS "${INPUTS}")
+
+set(CONTENT "// Generated by cmake/EmbedShaders.cmake. Do not edit.\n")
+string(APPEND CONTENT "#pragma once\n\nnamespace Utils::Embedded {\n\n")
+string(APPEND CONTENT "struct ShaderSource {\n   const char* Path;\n   const char* Source;\n};\n\n")
+string(APPEND CONTENT "inline constexpr ShaderSource SHADERS[] = {\n")
+foreach(INPUT ${INPUTS})
+    file(READ "${INPUT}" SOURCE)
+    file(RELATIVE_PATH NAME "${BASE}" "${INPUT}")
+    string(APPEND CONTENT "   {\"${NAME}\", R\"ECHO2D_GLSL(${SOURCE})ECHO2D_GLSL\"},\n")
+endforeach()
+string(APPEND CONTENT "};\n\n} // namespace Utils::Embedded\n")
+
+file(WRITE "${OUTPUT}" "${CONTENT}")
@@ -31,23 +31,23 @@ public:
 
 
    void Init() override {
-      Textures.push_back(new Echo2D::Texture("assets/dvd.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_292.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_293.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_294.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_295.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_296.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_297.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_298.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_299.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_300.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_301.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_302.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_303.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_304.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_305.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_306.png"));
-      Textures.push_back(new Echo2D::Texture("assets/sprite_307.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/dvd.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_292.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_293.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_294.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_295.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_296.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_297.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_298.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_299.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_300.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_301.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_302.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_303.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_304.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_305.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_306.png"));
+      Textures.push_back(Echo2D::TextureLoader::Load("assets/sprite_307.png"));
       font = new Echo2D::Font("assets/myFont.ttf", 48);
       my_camera = new Echo2D::Camera2D(800, 600);
       
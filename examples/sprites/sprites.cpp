@@ -12,26 +12,23 @@ public:
    }
 
    void Init() override {
-      RunSheet = new Echo2D::Spritesheet("assets/Sprites/RUN.png", 96, 96, 0.05f, 9);
-      IdleSheet = new Echo2D::Spritesheet("assets/Sprites/IDLE.png", 96, 96, 0.05f, 10);
-      HurtSheet = new Echo2D::Spritesheet("assets/Sprites/HURT.png", 96, 96, 0.1f, 4);
-      AttackSheet = new Echo2D::Spritesheet("assets/Sprites/ATTACK.png", 96, 96, 0.05f, 7);
+      RunAnim = AddAnimation("assets/Sprites/RUN.png", 9, 0.05f);
+      IdleAnim = AddAnimation("assets/Sprites/IDLE.png", 10, 0.05f);
+      HurtAnim = AddAnimation("assets/Sprites/HURT.png", 4, 0.1f);
+      AttackAnim = AddAnimation("assets/Sprites/ATTACK.png", 7, 0.05f);
       Debug();
    }
 
    void Update(float dt) override {
-      RunSheet->SpriteUpdate(dt);
-      IdleSheet->SpriteUpdate(dt);
-      HurtSheet->SpriteUpdate(dt);
-      AttackSheet->SpriteUpdate(dt);
+
    }
 
    void Render() const override {
       Echo2D::Renderer::ClearScreenColor(Gray);
-      Echo2D::Renderer::DrawRectSprite(Dimensions, Pos1, *RunSheet, RunSheet->GetCount(), 0);
-      Echo2D::Renderer::DrawRectSprite(Dimensions, Pos2, *IdleSheet, IdleSheet->GetCount(), 0);
-      Echo2D::Renderer::DrawRectSprite(Dimensions, Pos3, *HurtSheet, HurtSheet->GetCount(), 0);
-      Echo2D::Renderer::DrawRectSprite(Dimensions, Pos4, *AttackSheet, AttackSheet->GetCount(), 0);
+      Echo2D::Renderer::DrawAnimation(Dimensions, Pos1, RunAnim);
+      Echo2D::Renderer::DrawAnimation(Dimensions, Pos2, IdleAnim);
+      Echo2D::Renderer::DrawAnimation(Dimensions, Pos3, HurtAnim);
+      Echo2D::Renderer::DrawAnimation(Dimensions, Pos4, AttackAnim);
 
    };
 
@@ -40,10 +37,10 @@ public:
    };
 
 private:
-   Echo2D::Spritesheet *RunSheet = nullptr;
-   Echo2D::Spritesheet *IdleSheet = nullptr;
-   Echo2D::Spritesheet *HurtSheet = nullptr;
-   Echo2D::Spritesheet *AttackSheet = nullptr;
+   uint32_t RunAnim;
+   uint32_t IdleAnim;
+   uint32_t HurtAnim;
+   uint32_t AttackAnim;
    glm::vec2 Dimensions = {192.0f, 192.0f}; // enlarged sprites
    glm::vec2 Pos1 = {400.0f - Dimensions.x / 2.0f - 100.0f, 300.0f - Dimensions.y / 2.0f}; 
    glm::vec2 Pos2 = {400.0f - Dimensions.x / 2.0f + 100.0f, 300.0f - Dimensions.y / 2.0f}; 
@@ -54,6 +51,15 @@ private:
    glm::vec4 White = {255.0f, 255.0f, 255.0f, 255.0f};
    glm::vec4 Gray = {128.0f, 128.0f, 128.0f, 255.0f};
 
+   // One row of 96x96 frames per sheet
+   static uint32_t AddAnimation(const std::string& Path, int Frames, float FrameDuration) {
+      Echo2D::AnimationClip Clip;
+      Clip.Sheet = Echo2D::AssetCache::LoadSpritesheet(Path, 96, 96);
+      Clip.FrameCount = Frames;
+      Clip.FrameDuration = FrameDuration;
+      return Echo2D::Animator::Create(Echo2D::Animator::AddClip(Clip));
+   }
+
 };
 
 int main() {
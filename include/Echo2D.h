@@ -3,11 +3,30 @@
 
 #include "engine/Application.h"
 #include "engine/InputHandler.h"
+#include "engine/InputRecording.h"
 #include "engine/Renderer.h"
+#include "engine/RenderThread.h"
 #include "engine/Texture.h"
+#include "engine/TextureLoader.h"
+#include "engine/TextureResidency.h"
 #include "engine/Camera.h"
 #include "engine/Spritesheet.h"
+#include "engine/Animator.h"
+#include "engine/Broadphase.h"
+#include "engine/Collision.h"
+#include "engine/Physics.h"
+#include "engine/Picker.h"
+#include "engine/FramePacer.h"
+#include "engine/FrameStats.h"
+#include "engine/JobSystem.h"
+#include "engine/Log.h"
+#include "engine/World.h"
+#include "engine/Components.h"
+#include "engine/AssetArchive.h"
+#include "engine/AssetCache.h"
+#include "engine/AssetWatcher.h"
 #include "engine/Font.h"
+#include "engine/TextLayout.h"
 #include "engine/Colors.h"
 
 #endif
@@ -0,0 +1,209 @@
+#ifndef ANIMATOR_H
+#define ANIMATOR_H
+
+#include "core/core.h"
+#include "engine/AssetCache.h"
+#include "engine/AssetHandle.h"
+#include "engine/Spritesheet.h"
+#include "utils/Utils.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @enum LoopMode
+ * @brief What an animation does after its last frame.
+ */
+enum class LoopMode : uint8_t {
+   Loop,    ///< Wrap around to the first frame.
+   Once,    ///< Hold the last frame and stop.
+   PingPong ///< Play backwards to the first frame, then forwards again.
+};
+
+/**
+ * @struct FrameEvent
+ * @brief A user tag raised whenever an animation advances into a frame.
+ */
+struct FrameEvent {
+   int Frame;    ///< Frame index within the clip.
+   uint32_t Tag; ///< Game-defined meaning (footstep, hit window, ...).
+};
+
+/**
+ * @struct AnimationClip
+ * @brief A sequence of spritesheet frames: a run on one row of a grid, or an explicit frame list.
+ */
+struct AnimationClip {
+   SpritesheetHandle Sheet;         ///< Sheet the frames are cut from (kept alive by the clip).
+   int Row = 0;                     ///< Sheet row of the frames.
+   int FirstColumn = 0;             ///< Sheet column of the first frame.
+   int FrameCount = 1;              ///< Number of consecutive frames.
+   float FrameDuration = 0.1f;      ///< Seconds per frame at speed 1.
+   std::vector<int> Frames;         ///< Sheet frame indices to play instead of the Row/FirstColumn/FrameCount run.
+   bool SheetDurations = false;     ///< Show each frame for its SpriteFrame::Duration instead of FrameDuration.
+   LoopMode Loop = LoopMode::Loop;  ///< Default loop mode of instances playing the clip.
+   std::vector<FrameEvent> Events;  ///< Tags raised on frame entry.
+
+   /**
+     * @brief Builds a clip playing a frame tag of a sheet with the sheet's frame durations.
+     *
+     * Reverse tags list their frames backwards; ping-pong tags use LoopMode::PingPong.
+     * An unknown tag plays every frame of the sheet.
+     */
+   static AnimationClip FromTag(const SpritesheetHandle& Sheet, const std::string& Tag);
+};
+
+/**
+ * @enum AnimationEventType
+ * @brief Why an AnimationEvent was raised.
+ */
+enum class AnimationEventType : uint8_t {
+   Frame,   ///< Entered a frame with a FrameEvent; Tag holds its tag.
+   Looped,  ///< Wrapped around (Loop) or turned around (PingPong).
+   Finished ///< Reached the last frame of a LoopMode::Once animation.
+};
+
+/**
+ * @struct AnimationEvent
+ * @brief Something that happened to an instance during the last Animator::Update().
+ */
+struct AnimationEvent {
+   uint32_t Instance;
+   uint32_t Clip;
+   int Frame;
+   AnimationEventType Type;
+   uint32_t Tag = 0;
+};
+
+/**
+ * @class Animator
+ * @brief Advances every sprite animation in the game in one pass per frame.
+ *
+ * Clips are registered once and shared; each animated entity owns an
+ * instance holding only its own playback state (clip, time, speed, loop mode,
+ * current frame). Instance state is stored as parallel arrays, so Update()
+ * advances thousands of instances with a tight loop over contiguous floats
+ * that the compiler vectorizes, and only instances whose time passed the end
+ * of their current frame are looked at again to step frames and raise events.
+ * Every clip keeps its own copy of its frames' UVs and trim offsets, so
+ * drawing an instance is a lookup.
+ *
+ * Application calls Update() at the start of every frame; events raised by
+ * it are readable through GetEvents() until the next call.
+ */
+class Animator : public Utils::Singleton<Animator> {
+   friend class Utils::Singleton<Animator>;
+
+public:
+   /// Sentinel returned for failed lookups.
+   static constexpr uint32_t INVALID = UINT32_MAX;
+
+   /**
+     * @brief Registers a clip.
+     * @return Clip identifier, valid for the lifetime of the animator.
+     */
+   static uint32_t AddClip(const AnimationClip& Clip);
+
+   /**
+     * @brief Creates an instance playing a clip from its first frame.
+     * @param Clip Clip identifier from AddClip().
+     * @param Speed Playback rate (1: clip speed, negative values are clamped to 0).
+     * @return Instance identifier to pass to the other functions.
+     */
+   static uint32_t Create(uint32_t Clip, float Speed = 1.0f);
+
+   /// Destroys an instance. Its identifier may be reused by a later Create().
+   static void Destroy(uint32_t Instance);
+
+   /**
+     * @brief Switches an instance to another clip.
+     * @param Restart Start from the first frame even if the clip is already playing.
+     */
+   static void Play(uint32_t Instance, uint32_t Clip, bool Restart = true);
+
+   /// Sets an instance's playback rate.
+   static void SetSpeed(uint32_t Instance, float Speed);
+
+   /// Overrides the clip's loop mode for one instance.
+   static void SetLoopMode(uint32_t Instance, LoopMode Mode);
+
+   /// Pauses or resumes an instance.
+   static void SetPlaying(uint32_t Instance, bool Playing);
+
+   /**
+     * @brief Advances every playing instance and collects the events raised.
+     * @param dt Seconds since the last update.
+     */
+   static void Update(float dt);
+
+   /// @return Frame index within the instance's clip.
+   static int GetFrame(uint32_t Instance);
+
+   /// @return Clip the instance is playing.
+   static uint32_t GetClip(uint32_t Instance);
+
+   /// @return Whether the instance is advancing (false when paused or a Once clip finished).
+   static bool IsPlaying(uint32_t Instance);
+
+   /// @return (u, v, width, height) of the instance's current frame.
+   static glm::vec4 GetTexCoords(uint32_t Instance);
+
+   /// @return UVs and trim placement of the instance's current frame.
+   static const SpriteFrame& GetSpriteFrame(uint32_t Instance);
+
+   /// @return Texture of the instance's clip, or nullptr if the instance is not live or its clip has no sheet.
+   static Texture* GetTexture(uint32_t Instance);
+
+   /// @return Events raised by the last Update().
+   static const std::vector<AnimationEvent>& GetEvents();
+
+   /// @return Number of live instances.
+   static size_t GetInstanceCount();
+
+private:
+   struct Clip {
+      AnimationClip Source;
+      std::vector<SpriteFrame> Frames; ///< Precomputed UVs and trim placement per clip frame.
+      std::vector<float> Durations;    ///< Seconds per clip frame.
+      float Length = 0.0f;             ///< Seconds per cycle when looping.
+      float PingPongLength = 0.0f;     ///< Seconds per cycle in ping-pong (inner frames twice).
+   };
+
+   std::vector<Clip> m_Clips;
+
+   // Instance state, one entry per live instance (dense, swap-removed)
+   std::vector<float> m_Time;          ///< Seconds into the clip, at clip speed.
+   std::vector<float> m_Speed;         ///< Effective rate: m_BaseSpeed while playing, else 0.
+   std::vector<float> m_BaseSpeed;     ///< Rate set by Create() / SetSpeed().
+   std::vector<uint8_t> m_Playing;     ///< 0 while paused or after a Once clip finished.
+   std::vector<float> m_NextTime;      ///< Time the current step ends.
+   std::vector<int32_t> m_FrameCount;  ///< Frames in the clip.
+   std::vector<int32_t> m_Step;        ///< Frames advanced within the current loop cycle.
+   std::vector<int32_t> m_Frame;       ///< Current frame within the clip.
+   std::vector<uint32_t> m_ClipIndex;
+   std::vector<LoopMode> m_Loop;
+   std::vector<uint32_t> m_Owner;      ///< Instance identifier of each dense entry.
+
+   // Instance identifier -> dense index
+   std::vector<uint32_t> m_Sparse;
+   std::vector<uint32_t> m_FreeIDs;
+
+   std::vector<AnimationEvent> m_Events;
+
+   uint32_t Dense(uint32_t Instance) const;
+   void Restart(uint32_t Index, uint32_t ClipID);
+   int FrameAt(uint32_t Index, int32_t Step) const;
+   void Advance(uint32_t Index);
+   void RaiseFrameEvents(uint32_t Index, int Frame);
+
+   // Constructed after AssetCache so clips can still release their sheets on shutdown
+   Animator() { AssetCache::GetInstance(); }
+   ~Animator() = default;
+};
+
+} // namespace Echo2D
+
+#endif // ANIMATOR_H
@@ -1,8 +1,14 @@
 #ifndef APPLICATION_H
 #define APPLICATION_H
 
+#include "engine/FramePacer.h"
+#include "engine/FrameStats.h"
+#include "engine/InputRecording.h"
+#include "engine/JobSystem.h"
+#include "engine/Physics.h"
 #include "engine/WindowHandler.h"
-#include <vector>
+#include "engine/World.h"
+#include <string>
 
 namespace Echo2D {
 
@@ -14,6 +20,24 @@ namespace Echo2D {
  * handling, and an optional debug overlay (FPS counter). To use, subclass this
  * class and override the Init, Update, Render, and optionally RenderImGui
  * methods.
+ *
+ * The simulation advances in fixed ticks: FixedUpdate() runs as many times as
+ * the elapsed time covers (SetTickRate(), 60 per second by default), so it
+ * behaves the same at any framerate, while Update(), Render() and
+ * RenderImGui() run once per rendered frame. Render() can blend between the
+ * last two ticks with GetInterpolationAlpha().
+ *
+ * Entities created in GetWorld() are updated and drawn by the engine: their
+ * Velocity is applied after every FixedUpdate() and their Sprite is drawn
+ * before Render(). Bodies created in GetPhysics() are stepped after every
+ * FixedUpdate(), and entities with a RigidBody follow their body.
+ *
+ * A session's input can be recorded with SetInputRecording() and played back
+ * with SetInputReplay(): every frame then gets the recorded input and delta
+ * time, so a captured play session runs identically on every build.
+ *
+ * The JobSystem workers start with the application; Update() can split work
+ * with JobSystem::ParallelFor() or queue jobs with JobSystem::Run().
  */
 class Application {
 public:
@@ -42,10 +66,95 @@ public:
 
    /**
    * @brief Sets the target framerate (FPS) for the application.
-   * @param FPS The target FPS to cap the game at.
+   * @param FPS The target FPS to cap the game at (0 for uncapped, default 60).
    */
    void SetFPS(int FPS);
 
+   /**
+   * @brief Sets whether swaps wait for the display's vertical blank.
+   * @param Mode Off (default), On or Adaptive.
+   */
+   void SetVSync(VSyncMode Mode);
+
+   /// @return The frame pacer, for frame-time jitter and input latency statistics.
+   const FramePacer& GetFramePacer() const;
+
+   /// @return Frame-time histogram of the whole session; safe to read from any thread.
+   const FrameStats& GetFrameStats() const;
+
+   /**
+   * @brief Writes the frame-time histogram to a file when Run() returns.
+   * @param Path Output file; ".json" writes JSON, anything else CSV. Empty disables the export.
+   */
+   void SetFrameStatsExport(const std::string& Path);
+
+   /**
+   * @brief Sets how often FixedUpdate() runs.
+   * @param TicksPerSecond Simulation ticks per second (default 60).
+   */
+   void SetTickRate(int TicksPerSecond);
+
+   /**
+   * @brief Limits the ticks run in one frame to catch up after a slow frame.
+   *
+   * Time beyond the limit is dropped, so the game slows down instead of
+   * spending ever longer frames catching up.
+   *
+   * @param Ticks Maximum ticks per frame (default 5).
+   */
+   void SetMaxTicksPerFrame(int Ticks);
+
+   /**
+   * @brief Returns how far the current frame lies between the last two ticks.
+   * @return 0 right at the last tick, approaching 1 just before the next one.
+   */
+   float GetInterpolationAlpha() const;
+
+   /**
+   * @brief Submits GL work from a separate render thread, one frame behind the main loop.
+   *
+   * The main thread then builds frame N+1 while the render thread draws frame
+   * N (see RenderThread). Takes effect when Run() starts; off by default.
+   *
+   * @param Enabled Whether Run() starts the render thread.
+   */
+   void SetRenderThread(bool Enabled);
+
+   /**
+   * @brief Records every frame's input and delta time to a file while Run() runs.
+   * @param Path Output file (see InputRecorder). Empty disables recording.
+   */
+   void SetInputRecording(const std::string& Path);
+
+   /**
+   * @brief Replays a recording instead of live input; Run() returns after its last frame.
+   *
+   * Updates and ticks see exactly the recorded input and delta times, so a
+   * deterministic game reproduces the session bit for bit. Frame pacing
+   * still follows SetFPS(); use SetFPS(0) to replay as fast as possible.
+   * FrameStats measure the real frame times.
+   *
+   * @param Path A file written by SetInputRecording(). Empty disables replay.
+   * @param FixedDelta Delta time of every frame instead of the recorded ones; 0 keeps them.
+   * @param Headless Skip drawing, Render(), RenderImGui() and buffer swaps, for simulation-only runs.
+   */
+   void SetInputReplay(const std::string& Path, double FixedDelta = 0.0, bool Headless = false);
+
+   /// @return The entities updated and drawn by the main loop.
+   World& GetWorld();
+
+   /// @return The rigid-body simulation stepped every tick.
+   PhysicsWorld& GetPhysics();
+
+   /**
+   * @brief Draws physics shapes and contacts over the world sprites.
+   * @param Enabled Whether PhysicsWorld::DebugDraw() runs every frame (off by default).
+   */
+   void SetPhysicsDebugDraw(bool Enabled);
+
+   /// @return The thread pool shared by the engine and Update(); its API is static.
+   JobSystem& GetJobSystem();
+
 protected:
    /**
    * @brief Initialization hook that runs once before the main loop.
@@ -58,6 +167,12 @@ protected:
    */
    virtual void Update(float dt);
 
+   /**
+   * @brief Advances the simulation by one fixed tick; put physics and movement here.
+   * @param dt The tick length in seconds (1 / tick rate).
+   */
+   virtual void FixedUpdate(float dt);
+
    /**
    * @brief Renders the scene every frame.
    */
@@ -71,33 +186,62 @@ protected:
 private:
    // Core Systems
    WindowHandler *m_Window = nullptr; ///< Manages window and input handling.
+   PhysicsWorld m_Physics;            ///< Declared before m_World, which destroys RigidBody bodies.
+   World m_World;                     ///< Entities of the built-in systems.
 
    // Timing and FPS Management
    double m_LastFrameTime = 0.0; ///< Timestamp of the last frame.
-   double m_DeltaTime = 0.0;     ///< Time elapsed between frames.
+   double m_DeltaTime = 0.0;     ///< Time elapsed between frames, as seen by Update() and the ticks.
+   double m_FrameTime = 0.0;     ///< Measured length of the last frame; differs from m_DeltaTime in replays.
    double m_FpsTimer = 0.0;      ///< Accumulates time for FPS measurement.
-   double m_TargetFrameTime = 1.0 / 60.0;      ///< Target time per frame (based on 60 FPS).
+   double m_InputTime = 0.0;     ///< FramePacer::Now() when input was last polled.
+   FramePacer m_Pacer;           ///< Paces frames to the target FPS.
    double m_CurrentFPS = 0.0; ///< Calculated FPS for the current second.
 
+   // Fixed Timestep
+   double m_TickTime = 1.0 / 60.0; ///< Length of one FixedUpdate() tick.
+   double m_Accumulator = 0.0;     ///< Elapsed time not yet simulated.
+   int m_MaxTicksPerFrame = 5;     ///< Catch-up limit per frame.
+   float m_Alpha = 0.0f;           ///< m_Accumulator as a fraction of a tick.
+
    // FPS Counter
    int m_FrameCount = 0;       ///< Frames counted in the current second.
    int m_RollingFPS = 0;       ///< Smoothed FPS value over a period of time.
    const int MAX_SAMPLES = 30; ///< Number of samples for FPS rolling average.
-   std::vector<double> m_FrameTimeHistory; ///< History of frame times.
+   FrameStats m_FrameStats;    ///< Frame times of the whole session.
+   std::string m_FrameStatsPath; ///< Export destination, empty for none.
 
    // Debugging State
    bool m_ShowFPS = false; ///< Whether to display FPS overlay.
+   bool m_PhysicsDebugDraw = false; ///< Whether to draw physics shapes.
+
+   bool m_UseRenderThread = false; ///< Whether Run() pipelines GL submission.
+
+   // Input Recording and Replay
+   std::string m_RecordPath;     ///< Recording destination, empty for none.
+   std::string m_ReplayPath;     ///< Recording to replay, empty for live input.
+   double m_ReplayDelta = 0.0;   ///< Fixed replay delta time, 0 for the recorded ones.
+   bool m_ReplayHeadless = false;
+   bool m_Headless = false;      ///< Whether the running loop skips rendering.
+   InputRecorder m_Recorder;
+   InputReplay m_Replay;
+   bool m_Replaying = false;
 
    // Internal Loop Helpers
    void UpdateFpsCounter();
    void BeginFrame();
    void EndFrame();
+   void RunTicks();
+
+   /**
+   * @brief Waits for the frame's deadline, then polls input and measures the frame time.
+   */
+   void PaceFrame();
 
    /**
-   * @brief Caps the framerate by sleeping if the frame completes early.
-   * @param FrameStartTime The time when the current frame started.
+   * @brief Builds the next frame's input snapshot and delta time, live or from the replay.
    */
-   void CapFrameRate(double FrameStartTime);
+   void NextInput();
 };
 
 } // namespace Echo2D
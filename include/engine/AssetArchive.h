@@ -0,0 +1,162 @@
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include "core/core.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @enum ArchiveEntryType
+ * @brief What the bytes of an archive entry hold.
+ */
+enum class ArchiveEntryType : uint32_t {
+   Raw = 0,       ///< File copied verbatim (fonts, data files).
+   Texture = 1,   ///< Pre-decoded RGBA8 pixels, Width x Height.
+   FontAtlas = 2, ///< Baked font atlas in the Font cache format (see Font::Bake).
+   Shader = 3     ///< Shader source text.
+};
+
+/**
+ * @class AssetArchive
+ * @brief Read-only view of a packed asset archive produced by `echo2d_pack`.
+ *
+ * The whole archive is memory-mapped once; entries are looked up by the path
+ * the game would have used for the loose file (e.g. "assets/dvd.png"), and
+ * uncompressed entries are handed out as pointers straight into the mapping
+ * so texture data goes from the page cache to the driver without copies.
+ *
+ * Mounted archives are consulted by Texture, TextureLoader, Font and
+ * Utils::Shader before the file system, so packing a directory needs no
+ * changes to loading code. Mount archives before loading assets; lookups
+ * are read-only and safe from loader threads.
+ *
+ * File layout (little endian): Header, entry data (each aligned to
+ * DATA_ALIGNMENT), the table of contents (Header::EntryCount TocEntry
+ * records) and the name table they point into.
+ */
+class AssetArchive {
+public:
+   static constexpr char MAGIC[8] = {'E', '2', 'D', 'P', 'A', 'K', '\0', '\0'};
+   static constexpr uint32_t VERSION = 1;
+   static constexpr uint32_t FLAG_LZ4 = 1u << 0;   ///< Entry bytes are an LZ4 block.
+   static constexpr uint64_t DATA_ALIGNMENT = 16;  ///< Alignment of every entry's data.
+
+   struct Header {
+      char Magic[8];
+      uint32_t Version;
+      uint32_t EntryCount;
+      uint64_t TocOffset;
+      uint64_t NamesOffset;
+      uint64_t NamesSize;
+   };
+
+   struct TocEntry {
+      uint32_t Type;        ///< ArchiveEntryType.
+      uint32_t Flags;       ///< FLAG_* bits.
+      uint64_t NameOffset;  ///< Offset of the name in the name table.
+      uint64_t NameLength;
+      uint64_t DataOffset;  ///< Offset of the data from the start of the archive.
+      uint64_t StoredSize;  ///< Bytes in the archive.
+      uint64_t Size;        ///< Bytes once decompressed.
+      uint32_t Width;       ///< Texture width (0 for other types).
+      uint32_t Height;      ///< Texture height (0 for other types).
+   };
+
+   /**
+     * @struct Entry
+     * @brief A located archive entry.
+     */
+   struct Entry {
+      ArchiveEntryType Type;
+      uint32_t Flags;
+      const unsigned char* Data; ///< Stored bytes inside the mapping.
+      size_t StoredSize;
+      size_t Size;
+      int Width;
+      int Height;
+
+      bool IsCompressed() const { return (Flags & FLAG_LZ4) != 0; }
+   };
+
+   /**
+     * @brief Maps an archive file and indexes its table of contents.
+     * @param Path Path to the archive.
+     */
+   explicit AssetArchive(const std::string& Path);
+
+   /// Unmaps the archive. Entry pointers become invalid.
+   ~AssetArchive();
+
+   AssetArchive(const AssetArchive&) = delete;
+   AssetArchive& operator=(const AssetArchive&) = delete;
+
+   /// @return Whether the archive was mapped and its table of contents is valid.
+   bool IsOpen() const;
+
+   /// @return The entry stored under Name, or nullptr.
+   const Entry* Find(const std::string& Name) const;
+
+   /// @return Number of entries in the archive.
+   size_t GetEntryCount() const;
+
+   /**
+     * @brief Returns an entry's decompressed bytes.
+     *
+     * Uncompressed entries are returned straight from the mapping; compressed
+     * ones are decompressed into Scratch, whose data is returned.
+     *
+     * @return Pointer to Entry::Size bytes, or nullptr if decompression failed.
+     */
+   static const unsigned char* View(const Entry& Item, std::vector<unsigned char>& Scratch);
+
+   /**
+     * @brief Maps an archive and adds it to the archives searched by asset loads.
+     *
+     * Archives mounted later take precedence, so patches can shadow entries.
+     *
+     * @return false if the archive could not be opened.
+     */
+   static bool Mount(const std::string& Path);
+
+   /// Unmounts every archive. Assets loaded from them must already be released.
+   static void UnmountAll();
+
+   /**
+     * @brief Looks an asset path up in the mounted archives.
+     * @return The entry of the most recently mounted archive that has it, or nullptr.
+     */
+   static const Entry* FindMounted(const std::string& Name);
+
+   /// Normalizes a path the way names are stored ("./a//b.png" -> "a/b.png").
+   static std::string NormalizeName(const std::string& Name);
+
+private:
+   std::string m_Path;
+   const unsigned char* m_Base = nullptr; ///< Start of the mapping.
+   size_t m_Size = 0;
+#ifdef _WIN32
+   void* m_File = nullptr;
+   void* m_Mapping = nullptr;
+#else
+   int m_File = -1;
+#endif
+   std::vector<Entry> m_Entries;
+   std::unordered_map<std::string_view, size_t> m_Index; ///< Names point into the mapping.
+
+   bool Map();
+   void Unmap();
+   bool Index();
+
+   /// Mounted archives, most recent last.
+   static std::vector<std::unique_ptr<AssetArchive>>& Mounted();
+};
+
+} // namespace Echo2D
+
+#endif // ASSETARCHIVE_H
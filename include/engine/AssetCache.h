@@ -0,0 +1,210 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include "core/core.h"
+#include "engine/AssetHandle.h"
+#include "engine/AssetWatcher.h"
+#include "engine/Font.h"
+#include "engine/Spritesheet.h"
+#include "engine/Texture.h"
+#include "utils/ShaderUtils.h"
+#include "utils/Utils.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @class AssetPool
+ * @brief Slot storage for one asset type, keyed by a load description string.
+ *
+ * Assets whose last handle goes away are only queued; Collect() destroys the
+ * whole batch at a point where nothing can still be drawing with them, and an
+ * asset requested again before that is revived without reloading.
+ */
+template <typename T> class AssetPool {
+public:
+   /**
+     * @brief Returns a handle to the asset stored under Key, creating it on a miss.
+     * @param Key Unique description of the load (path plus parameters).
+     * @param Create Callable returning a std::unique_ptr<T>.
+     */
+   template <typename Factory> AssetHandle<T> Acquire(const std::string& Key, Factory&& Create) {
+      auto It = m_Index.find(Key);
+      if (It != m_Index.end()) {
+         Slot& Existing = m_Slots[It->second];
+         Existing.RefCount++;
+         return AssetHandle<T>(It->second, Existing.Generation);
+      }
+
+      // Create first: loading one asset may acquire others and grow their pools
+      std::unique_ptr<T> Asset = Create();
+
+      uint32_t Index;
+      if (!m_Free.empty()) {
+         Index = m_Free.back();
+         m_Free.pop_back();
+      } else {
+         Index = static_cast<uint32_t>(m_Slots.size());
+         m_Slots.emplace_back();
+      }
+
+      Slot& New = m_Slots[Index];
+      New.Asset = std::move(Asset);
+      New.Key = Key;
+      New.RefCount = 1;
+      m_Index.emplace(Key, Index);
+      return AssetHandle<T>(Index, New.Generation);
+   }
+
+   T* Get(uint32_t Index, uint32_t Generation) const {
+      if (Index >= m_Slots.size() || m_Slots[Index].Generation != Generation) return nullptr;
+      return m_Slots[Index].Asset.get();
+   }
+
+   void Retain(uint32_t Index, uint32_t Generation) {
+      if (Index < m_Slots.size() && m_Slots[Index].Generation == Generation) {
+         m_Slots[Index].RefCount++;
+      }
+   }
+
+   void Release(uint32_t Index, uint32_t Generation) {
+      if (Index >= m_Slots.size() || m_Slots[Index].Generation != Generation) return;
+      Slot& Released = m_Slots[Index];
+      if (Released.RefCount > 0 && --Released.RefCount == 0 && !Released.Queued) {
+         Released.Queued = true;
+         m_Unreferenced.push_back(Index);
+      }
+   }
+
+   /**
+     * @brief Destroys every queued asset that is still unreferenced.
+     * @param Everything Also destroy referenced assets, invalidating their handles.
+     * @return Number of assets destroyed.
+     */
+   size_t Collect(bool Everything = false) {
+      if (Everything) {
+         m_Unreferenced.clear();
+         for (uint32_t i = 0; i < m_Slots.size(); i++) {
+            if (m_Slots[i].Asset) m_Unreferenced.push_back(i);
+         }
+      }
+
+      size_t Destroyed = 0;
+      for (uint32_t Index : m_Unreferenced) {
+         Slot& Queued = m_Slots[Index];
+         Queued.Queued = false;
+         if (!Queued.Asset || (Queued.RefCount > 0 && !Everything)) continue;
+
+         Queued.Asset.reset();
+         m_Index.erase(Queued.Key);
+         Queued.Key.clear();
+         Queued.RefCount = 0;
+         if (++Queued.Generation == 0) Queued.Generation = 1;
+         m_Free.push_back(Index);
+         Destroyed++;
+      }
+      m_Unreferenced.clear();
+      return Destroyed;
+   }
+
+   /// @return Number of assets currently loaded.
+   size_t Size() const { return m_Index.size(); }
+
+private:
+   struct Slot {
+      std::unique_ptr<T> Asset;
+      std::string Key;
+      uint32_t Generation = 1;
+      uint32_t RefCount = 0;
+      bool Queued = false; ///< Listed in m_Unreferenced.
+   };
+
+   std::vector<Slot> m_Slots;
+   std::vector<uint32_t> m_Free;
+   std::unordered_map<std::string, uint32_t> m_Index;
+   std::vector<uint32_t> m_Unreferenced;
+};
+
+/**
+ * @class AssetCache
+ * @brief Shares loaded textures, spritesheets, fonts and shaders between all their users.
+ *
+ * Every load is keyed by its path and parameters, so asking for the same
+ * asset twice returns a second handle to the first load instead of decoding
+ * and uploading it again. Unreferenced assets are released in batches by
+ * Collect(), which Application calls at the end of every frame after the
+ * batches have been flushed.
+ */
+class AssetCache : public Utils::Singleton<AssetCache> {
+   friend class Utils::Singleton<AssetCache>;
+
+public:
+   /// Loads (or shares) a texture, decoding it synchronously on a miss.
+   static TextureHandle LoadTexture(const std::string& FilePath);
+
+   /**
+     * @brief Loads (or shares) a texture, streaming it in through TextureLoader on a miss.
+     *
+     * Cached separately from LoadTexture(), so a synchronous load of the same
+     * path never receives a texture that is still showing the placeholder.
+     */
+   static TextureHandle LoadTextureAsync(const std::string& FilePath);
+
+   /// Loads (or shares) a spritesheet; its texture is shared with LoadTexture() of the same path.
+   static SpritesheetHandle LoadSpritesheet(const std::string& FilePath, int SpriteWidth, int SpriteHeight);
+
+   /// Loads (or shares) a packed spritesheet described by TexturePacker / Aseprite JSON metadata.
+   static SpritesheetHandle LoadSpritesheet(const std::string& MetadataPath);
+
+   /// Loads (or shares) a font at a pixel size and mode.
+   static FontHandle LoadFont(const std::string& FilePath, GLuint FontSize, FontMode Mode = FontMode::Bitmap);
+
+   /// Loads (or shares) a shader program built from a vertex and fragment source file.
+   static ShaderHandle LoadShader(const std::string& VertexPath, const std::string& FragmentPath);
+
+   /**
+     * @brief Destroys every asset whose last handle was dropped since the previous call.
+     * @return Number of assets destroyed.
+     */
+   static size_t Collect();
+
+   /**
+     * @brief Destroys every asset, referenced or not. Outstanding handles become stale.
+     *
+     * Must run while the GL context is still alive.
+     */
+   static void Clear();
+
+   /// @return Number of assets currently loaded across all types.
+   static size_t GetAssetCount();
+
+   /// @return The pool holding assets of type T.
+   template <typename T> static AssetPool<T>& Pool() {
+      auto& Cache = GetInstance();
+      if constexpr (std::is_same_v<T, Texture>) return Cache.m_Textures;
+      else if constexpr (std::is_same_v<T, Spritesheet>) return Cache.m_Spritesheets;
+      else if constexpr (std::is_same_v<T, Font>) return Cache.m_Fonts;
+      else return Cache.m_Shaders;
+   }
+
+private:
+   // Members are destroyed in reverse order, so spritesheets drop their texture handles first
+   AssetPool<Texture> m_Textures;
+   AssetPool<Font> m_Fonts;
+   AssetPool<Utils::Shader> m_Shaders;
+   AssetPool<Spritesheet> m_Spritesheets;
+
+   // Constructed first so the watcher outlives the assets that unregister from it
+   AssetCache() { AssetWatcher::GetInstance(); }
+   ~AssetCache() = default;
+};
+
+} // namespace Echo2D
+
+#endif // ASSETCACHE_H
@@ -0,0 +1,74 @@
+#ifndef ASSETHANDLE_H
+#define ASSETHANDLE_H
+
+#include <cstdint>
+
+namespace Utils {
+class Shader;
+}
+
+namespace Echo2D {
+
+class Texture;
+class Spritesheet;
+class Font;
+template <typename T> class AssetPool;
+
+/**
+ * @class AssetHandle
+ * @brief Refcounted, generational reference to an asset owned by AssetCache.
+ *
+ * Copying a handle adds a reference and destroying one drops it; the asset
+ * stays loaded while any handle refers to it. The slot index is paired with
+ * a generation, so a handle whose asset was released (e.g. by
+ * AssetCache::Clear) resolves to nullptr instead of to whatever reuses the
+ * slot. Handles, Get() included, must only be used on the main thread;
+ * jobs are handed the resolved asset pointer instead.
+ */
+template <typename T> class AssetHandle {
+public:
+   AssetHandle() = default;
+   AssetHandle(const AssetHandle& Other);
+   AssetHandle(AssetHandle&& Other) noexcept;
+   AssetHandle& operator=(const AssetHandle& Other);
+   AssetHandle& operator=(AssetHandle&& Other) noexcept;
+   ~AssetHandle();
+
+   /// @return The asset, or nullptr for an empty or stale handle.
+   T* Get() const;
+
+   T* operator->() const { return Get(); }
+   T& operator*() const { return *Get(); }
+   explicit operator bool() const { return Get() != nullptr; }
+
+   bool operator==(const AssetHandle& Other) const {
+      return m_Index == Other.m_Index && m_Generation == Other.m_Generation;
+   }
+
+   /// Drops this handle's reference and empties it.
+   void Reset();
+
+private:
+   friend class AssetPool<T>;
+
+   /// Adopts a reference already counted by the pool.
+   AssetHandle(uint32_t Index, uint32_t Generation) : m_Index(Index), m_Generation(Generation) {}
+
+   static constexpr uint32_t INVALID = UINT32_MAX;
+   uint32_t m_Index = INVALID;
+   uint32_t m_Generation = 0;
+};
+
+extern template class AssetHandle<Texture>;
+extern template class AssetHandle<Spritesheet>;
+extern template class AssetHandle<Font>;
+extern template class AssetHandle<Utils::Shader>;
+
+using TextureHandle = AssetHandle<Texture>;
+using SpritesheetHandle = AssetHandle<Spritesheet>;
+using FontHandle = AssetHandle<Font>;
+using ShaderHandle = AssetHandle<Utils::Shader>;
+
+} // namespace Echo2D
+
+#endif // ASSETHANDLE_H
@@ -0,0 +1,123 @@
+#ifndef ASSETWATCHER_H
+#define ASSETWATCHER_H
+
+#include "core/core.h"
+#include "utils/Utils.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @class AssetWatcher
+ * @brief Hot-reloads assets whose source files change on disk.
+ *
+ * Textures, fonts and shaders register their source files here when they are
+ * created. Once Start() has been called, a background thread waits for file
+ * changes (inotify on Linux, modification time polling elsewhere), debounces
+ * editors' save bursts, and runs each changed asset's prepare step on that
+ * thread: reading sources, rasterizing glyphs and the like. The GL work that
+ * step hands back is applied by Update(), which Application calls at the
+ * start of every frame, so an asset is never swapped halfway through a frame.
+ *
+ * Registration is cheap and always on; nothing is watched until Start().
+ */
+class AssetWatcher : public Utils::Singleton<AssetWatcher> {
+   friend class Utils::Singleton<AssetWatcher>;
+
+public:
+   /// Work to run on the GL thread at the next frame boundary.
+   using Apply = std::function<void()>;
+
+   /**
+     * @brief Work to run on the watcher thread when the file changes.
+     *
+     * Returns the Apply step, or an empty function to skip the reload (e.g.
+     * when the new file does not parse, so the old asset stays in use).
+     */
+   using Prepare = std::function<Apply()>;
+
+   /**
+     * @brief Registers a file whose changes should reload an asset.
+     * @param Path Source file of the asset.
+     * @param OnChange Runs on the watcher thread after the file changed.
+     * @return Identifier to pass to Unwatch(), 0 if Path is empty.
+     */
+   static uint64_t Watch(const std::string& Path, Prepare OnChange);
+
+   /**
+     * @brief Stops watching. Waits for a running prepare step and drops any unapplied reload.
+     *
+     * Assets call this from their destructor, so a reload never outlives its asset.
+     */
+   static void Unwatch(uint64_t ID);
+
+   /// Starts the watcher thread. Call once content iteration is wanted (e.g. in debug builds).
+   static void Start();
+
+   /// Stops the watcher thread. Pending reloads are dropped.
+   static void Stop();
+
+   /// @return Whether the watcher thread is running.
+   static bool IsRunning();
+
+   /**
+     * @brief Applies every reload prepared since the last call. Must run on the GL thread.
+     * @return Number of reloads applied.
+     */
+   static size_t Update();
+
+   /// Quiet time after the last change to a file before it is reloaded.
+   static constexpr std::chrono::milliseconds DEBOUNCE{100};
+
+   /// Interval between modification time checks where inotify is unavailable.
+   static constexpr std::chrono::milliseconds POLL_INTERVAL{250};
+
+private:
+   struct Watched {
+      std::string Path; ///< Absolute, normalized.
+      Prepare OnChange;
+      std::filesystem::file_time_type LastWrite; ///< Polling fallback only.
+      bool Dirty = false;
+   };
+
+   std::thread m_Thread;
+   std::atomic<bool> m_Running = false;
+   std::mutex m_PrepareMutex; ///< Held while prepare steps run, so Unwatch can wait them out.
+   std::mutex m_Mutex;        ///< Guards everything below.
+   std::unordered_map<uint64_t, Watched> m_Watches;
+   std::unordered_map<std::string, std::vector<uint64_t>> m_ByPath;
+   std::vector<std::pair<uint64_t, Apply>> m_Ready; ///< Prepared reloads waiting for Update().
+   uint64_t m_NextID = 1;
+   bool m_HasDirty = false;
+   std::chrono::steady_clock::time_point m_LastChange; ///< Time of the most recent change event.
+
+#ifdef __linux__
+   int m_Inotify = -1;
+   int m_WakeFd = -1;                               ///< eventfd that interrupts the thread's poll().
+   std::unordered_map<int, std::string> m_Directories; ///< inotify watch descriptor -> directory.
+
+   void WatchDirectory(const std::string& Directory);
+#endif
+
+   void ThreadLoop();
+   void MarkChanged(const std::string& Path);
+   void PollModificationTimes();
+   void PrepareDirty();
+
+   AssetWatcher() = default;
+   ~AssetWatcher();
+};
+
+} // namespace Echo2D
+
+#endif // ASSETWATCHER_H
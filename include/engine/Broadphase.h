@@ -0,0 +1,214 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @struct AABB
+ * @brief Axis-aligned box in world units.
+ */
+struct AABB {
+   glm::vec2 Min = {0.0f, 0.0f};
+   glm::vec2 Max = {0.0f, 0.0f};
+
+   /// @return Whether the boxes overlap (touching counts).
+   bool Overlaps(const AABB& Other) const {
+      return Min.x <= Other.Max.x && Other.Min.x <= Max.x && Min.y <= Other.Max.y && Other.Min.y <= Max.y;
+   }
+};
+
+/**
+ * @struct ProxyPair
+ * @brief Two overlapping proxies, with A < B.
+ */
+struct ProxyPair {
+   uint32_t A;
+   uint32_t B;
+};
+
+/**
+ * @struct RayHit
+ * @brief A proxy crossed by a ray, and how far along the ray it was entered.
+ */
+struct RayHit {
+   uint32_t Proxy;
+   float Distance; ///< 0 when the ray starts inside the proxy.
+};
+
+/**
+ * @class Broadphase
+ * @brief Finds overlapping shapes among many moving boxes and circles without testing every pair.
+ *
+ * Shapes are registered as proxies and moved every frame with MoveBox() or
+ * MoveCircle(); a move that stays within the same grid cells only updates
+ * the bounds. FindPairs() then reports every overlapping pair in one batch,
+ * using either of two algorithms:
+ *
+ *   - SpatialHash: each proxy is bucketed into the uniform grid cells it
+ *     covers and only proxies sharing a cell are tested. Best when objects
+ *     are of similar size and the cell size is close to that size.
+ *   - SweepAndPrune: proxies are kept sorted along one axis and swept for
+ *     overlapping intervals. The order is repaired by insertion sort, which
+ *     is near linear as objects move a little per frame; insensitive to
+ *     object size.
+ *
+ * Large grids generate their pairs on the JobSystem. Region, radius and ray
+ * queries always go through the grid; rays walk only the cells they cross. Circles are tested exactly against
+ * circles and boxes; everything else by bounds. Not thread safe: use one
+ * thread per Broadphase at a time.
+ */
+class Broadphase {
+public:
+   enum class Method {
+      SpatialHash,
+      SweepAndPrune
+   };
+
+   /// Proxy ID that never refers to a proxy.
+   static constexpr uint32_t INVALID = UINT32_MAX;
+
+   /**
+     * @param CellSize Grid cell edge in world units; about the size of a typical object.
+     * @param PairMethod Algorithm FindPairs() uses.
+     */
+   explicit Broadphase(float CellSize = 64.0f, Method PairMethod = Method::SpatialHash);
+
+   /**
+     * @brief Registers a box.
+     * @param UserData Value handed back by GetUserData(), e.g. an entity ID.
+     * @return The proxy ID, reused after Remove().
+     */
+   uint32_t AddBox(const AABB& Bounds, uint32_t UserData = 0);
+
+   /// @brief Registers a circle. @see AddBox
+   uint32_t AddCircle(glm::vec2 Center, float Radius, uint32_t UserData = 0);
+
+   /// Moves a box proxy to new bounds.
+   void MoveBox(uint32_t Proxy, const AABB& Bounds);
+
+   /// Moves a circle proxy.
+   void MoveCircle(uint32_t Proxy, glm::vec2 Center, float Radius);
+
+   /// Unregisters a proxy; its ID may be handed out again.
+   void Remove(uint32_t Proxy);
+
+   /// Removes every proxy.
+   void Clear();
+
+   /**
+     * @brief Finds every pair of overlapping proxies.
+     * @return The pairs, each once with A < B, in no particular order. Valid until the next call.
+     */
+   const std::vector<ProxyPair>& FindPairs();
+
+   /**
+     * @brief Appends the proxies overlapping a box.
+     * @param Out Receives proxy IDs, each once.
+     */
+   void QueryRegion(const AABB& Region, std::vector<uint32_t>& Out);
+
+   /**
+     * @brief Appends the proxies overlapping a circle.
+     * @param Out Receives proxy IDs, each once.
+     */
+   void QueryRadius(glm::vec2 Center, float Radius, std::vector<uint32_t>& Out);
+
+   /**
+     * @brief Appends the proxies a ray segment crosses.
+     * @param Direction Need not be normalized; Distance is measured in world units along it.
+     * @param Out Receives each proxy once, in no particular order.
+     */
+   void QueryRay(glm::vec2 Origin, glm::vec2 Direction, float MaxDistance, std::vector<RayHit>& Out);
+
+   void SetMethod(Method PairMethod);
+   Method GetMethod() const { return m_Method; }
+
+   /// Changes the cell size; the grid is rebuilt on the next query.
+   void SetCellSize(float CellSize);
+   float GetCellSize() const { return m_CellSize; }
+
+   const AABB& GetBounds(uint32_t Proxy) const { return m_Bounds[Proxy]; }
+   uint32_t GetUserData(uint32_t Proxy) const { return m_UserData[Proxy]; }
+   bool IsValid(uint32_t Proxy) const { return Proxy < m_Alive.size() && m_Alive[Proxy]; }
+
+   /// @return Number of live proxies.
+   size_t GetProxyCount() const { return m_Count; }
+
+private:
+   /// Inclusive range of grid cells a proxy covers.
+   struct CellRange {
+      int32_t MinX, MinY, MaxX, MaxY;
+      bool operator==(const CellRange&) const = default;
+   };
+
+   /// One proxy in one grid cell, with a copy of what the pair test reads so buckets are scanned linearly.
+   struct CellEntry {
+      uint32_t Proxy;
+      int32_t X, Y;
+      int32_t FirstX, FirstY; ///< Lowest cell the proxy covers.
+      AABB Bounds;
+   };
+
+   Method m_Method;
+   float m_CellSize;
+   float m_InvCellSize;
+
+   // Proxies, indexed by ID (structure of arrays; slots of removed proxies are dead)
+   std::vector<AABB> m_Bounds;
+   std::vector<glm::vec2> m_Centers;  ///< Circle centers.
+   std::vector<float> m_Radii;        ///< Circle radii, negative for boxes.
+   std::vector<uint32_t> m_UserData;
+   std::vector<CellRange> m_Cells;
+   std::vector<uint8_t> m_Alive;
+   std::vector<uint32_t> m_FreeIDs;
+   size_t m_Count = 0;
+
+   // Grid: entries bucketed by hashed cell (counting sort)
+   std::vector<CellEntry> m_Entries;
+   std::vector<uint32_t> m_EntryBuckets; ///< Scratch: bucket of each entry in proxy order.
+   std::vector<uint32_t> m_BucketStart; ///< Bucket b holds m_Entries[m_BucketStart[b], m_BucketStart[b + 1]).
+   std::vector<uint32_t> m_BucketFill;
+   std::vector<uint32_t> m_BusyBuckets; ///< Buckets holding two or more entries: the only ones with pairs.
+   uint32_t m_BucketMask = 0;
+   bool m_GridDirty = true;            ///< A proxy was added, removed or changed cells.
+   bool m_BoundsDirty = false;         ///< A proxy moved within its cells; the entries' bounds are stale.
+
+   // Sweep and prune: proxies sorted by minimum on m_Axis, with copies of their bounds in that order
+   std::vector<uint32_t> m_Order;
+   std::vector<float> m_SortMin, m_SortMax, m_SortLow, m_SortHigh;
+   int m_Axis = 0;
+   bool m_OrderDirty = true;           ///< A proxy was added or removed.
+
+   std::vector<uint32_t> m_QueryMarks; ///< Per proxy: last query that reported it.
+   uint32_t m_QueryMark = 0;
+
+   std::vector<ProxyPair> m_Pairs;
+   std::vector<std::vector<ProxyPair>> m_BlockPairs; ///< Per-job output of parallel pair generation.
+
+   uint32_t Allocate(const AABB& Bounds, glm::vec2 Center, float Radius, uint32_t UserData);
+   void Place(uint32_t Proxy, const AABB& Bounds);
+   CellRange CellsOf(const AABB& Bounds) const;
+   uint32_t BucketOf(int32_t X, int32_t Y) const;
+   bool ShapesOverlap(uint32_t A, uint32_t B) const;
+   bool Touches(uint32_t Proxy, const AABB& Region, glm::vec2 Center, float Radius) const;
+   bool RayEnters(uint32_t Proxy, glm::vec2 Origin, glm::vec2 Direction, float MaxDistance, float& Distance) const;
+   int32_t CellOf(float Coordinate) const;
+
+   void RebuildGrid();
+   void RefreshEntryBounds();
+   void PairsFromGrid();
+   void PairsInBuckets(size_t First, size_t Last, std::vector<ProxyPair>& Out) const;
+   void PairsFromSweep();
+   void BeginQuery();
+   template <typename Visit>
+   void VisitCells(const AABB& Region, Visit&& Fn);
+};
+
+} // namespace Echo2D
+
+#endif // BROADPHASE_H
@@ -76,6 +76,26 @@ public:
     */
    const glm::mat4& GetViewMatrix() const;
 
+   /**
+    * @brief Get the camera's combined projection * view matrix.
+    * @return The matrix mapping world positions to clip space.
+    */
+   const glm::mat4& GetViewProjectionMatrix() const;
+
+   /**
+    * @brief Convert a point in window pixels (origin top-left, as MouseListener::GetX/GetY) to world space.
+    * @param Screen The point in pixels within the viewport.
+    * @return The world position under that pixel.
+    */
+   glm::vec2 ScreenToWorld(glm::vec2 Screen) const;
+
+   /**
+    * @brief Convert a world position to window pixels.
+    * @param WorldPosition The point in world space.
+    * @return The pixel it is drawn at, with the origin at the viewport's top-left.
+    */
+   glm::vec2 WorldToScreen(glm::vec2 WorldPosition) const;
+
    /**
     * @brief Move the camera by a delta.
     * @param Delta The movement in x and y.
@@ -99,6 +119,8 @@ private:
    glm::vec2 m_ViewportSize; ///< The size of the viewport.
    glm::mat4 m_ProjectionMatrix; ///< The camera's projection matrix.
    glm::mat4 m_ViewMatrix; ///< The camera's view matrix.
+   glm::mat4 m_ViewProjection; ///< Projection * view, cached with the view matrix.
+   glm::mat4 m_InverseViewProjection; ///< Its inverse, for screen-to-world conversion.
    float m_Zoom; ///< The camera's zoom factor.
    float m_Rotation; ///< The camera's rotation in degrees.
 
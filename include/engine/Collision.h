@@ -0,0 +1,105 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Echo2D {
+
+/// Most vertices a convex polygon shape may have.
+static constexpr int MAX_POLYGON_VERTICES = 8;
+
+/**
+ * @struct Pose
+ * @brief Position and rotation of a shape in the world.
+ *
+ * Angles follow Transform::Rotation: radians, clockwise on screen (the y
+ * axis points down).
+ */
+struct Pose {
+   glm::vec2 Position = {0.0f, 0.0f};
+   float Cos = 1.0f;
+   float Sin = 0.0f;
+
+   Pose() = default;
+   Pose(glm::vec2 Position, float Angle);
+
+   /// @return A local point in world space.
+   glm::vec2 Apply(glm::vec2 Local) const { return Position + Rotate(Local); }
+
+   /// @return A local direction in world space.
+   glm::vec2 Rotate(glm::vec2 Local) const { return {Cos * Local.x - Sin * Local.y, Sin * Local.x + Cos * Local.y}; }
+};
+
+/**
+ * @struct Shape
+ * @brief Collision geometry of a rigid body, centered on its center of mass.
+ */
+struct Shape {
+   enum class Type : uint8_t {
+      Circle,
+      Polygon
+   };
+
+   Type Kind = Type::Circle;
+   float Radius = 0.0f;                             ///< Circles only.
+   int Count = 0;                                   ///< Polygon vertex count.
+   glm::vec2 Vertices[MAX_POLYGON_VERTICES] = {};   ///< Convex, in winding order, relative to the centroid.
+   glm::vec2 Normals[MAX_POLYGON_VERTICES] = {};    ///< Outward normal of the edge starting at each vertex.
+
+   static Shape Circle(float Radius);
+
+   /// A box of the given half size. Give its body FixedRotation for an axis-aligned box (AABB).
+   static Shape Box(glm::vec2 HalfExtents);
+
+   /**
+     * @brief A convex polygon.
+     *
+     * Points are used in either winding and moved so their centroid is the
+     * origin; extra points beyond MAX_POLYGON_VERTICES are ignored.
+     */
+   static Shape Polygon(const glm::vec2* Points, int Count);
+
+   /// @return Area in square pixels.
+   float GetArea() const;
+
+   /// @return Rotational inertia about the center per unit of mass.
+   float GetUnitInertia() const;
+
+   /// Computes the world-space bounds at a pose.
+   void GetBounds(const Pose& At, glm::vec2& Min, glm::vec2& Max) const;
+};
+
+/**
+ * @struct ManifoldPoint
+ * @brief One contact point, with the impulses the solver accumulated on it.
+ */
+struct ManifoldPoint {
+   glm::vec2 Position = {0.0f, 0.0f}; ///< World space, midway between the surfaces.
+   float Separation = 0.0f;           ///< Negative when penetrating.
+   uint32_t Feature = 0;              ///< Identifies the features in contact, to match points across steps.
+   float NormalImpulse = 0.0f;
+   float TangentImpulse = 0.0f;
+};
+
+/**
+ * @struct Manifold
+ * @brief Contact geometry between two shapes.
+ */
+struct Manifold {
+   glm::vec2 Normal = {0.0f, 0.0f}; ///< From shape A towards shape B.
+   ManifoldPoint Points[2];
+   int PointCount = 0;              ///< 0 when the shapes are further apart than the margin.
+};
+
+/**
+ * @brief Computes the contact manifold of two shapes.
+ *
+ * Points are reported up to Margin apart as well as when penetrating, so
+ * the solver can stop approaching bodies before they overlap.
+ */
+void Collide(const Shape& A, const Pose& PoseA, const Shape& B, const Pose& PoseB, float Margin, Manifold& Out);
+
+} // namespace Echo2D
+
+#endif // COLLISION_H
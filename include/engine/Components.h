@@ -0,0 +1,156 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include "core/core.h"
+#include "engine/Animator.h"
+#include "engine/AssetHandle.h"
+#include "engine/Colors.h"
+#include "engine/Physics.h"
+#include "engine/World.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <utility>
+
+namespace Echo2D {
+
+/**
+ * @struct Transform
+ * @brief Placement of an entity. Position is the top-left of its sprite rect, as in the Renderer draw calls.
+ */
+struct Transform {
+   glm::vec2 Position = {0.0f, 0.0f};
+   glm::vec2 Scale = {1.0f, 1.0f};  ///< Multiplies Sprite::Size.
+   float Rotation = 0.0f;           ///< Radians, clockwise on screen, about the rect's center.
+};
+
+/**
+ * @struct Velocity
+ * @brief Motion applied to the Transform every frame by UpdateMovement().
+ */
+struct Velocity {
+   glm::vec2 Linear = {0.0f, 0.0f}; ///< Pixels per second.
+   float Angular = 0.0f;            ///< Radians per second.
+};
+
+/**
+ * @struct Interpolation
+ * @brief Transform of the previous fixed tick, so Renderer::DrawWorld() can draw between ticks.
+ *
+ * Add it to entities that move every tick; without it they are drawn at
+ * their latest Transform and visibly step when frames outnumber ticks.
+ * SaveInterpolation() fills it before every tick.
+ */
+struct Interpolation {
+   glm::vec2 Position = {0.0f, 0.0f};
+   float Rotation = 0.0f;
+   bool Valid = false; ///< false until the first tick after the component was added.
+};
+
+/**
+ * @struct Sprite
+ * @brief A textured rect drawn at the entity's Transform by Renderer::DrawWorld().
+ *
+ * With an Animation component, the animation's current frame replaces
+ * Texture and Region.
+ */
+struct Sprite {
+   glm::vec2 Size = {0.0f, 0.0f};           ///< Untransformed size in pixels.
+   TextureHandle Texture;
+   glm::vec4 Region = {0.0f, 0.0f, 1.0f, 1.0f}; ///< (u, v, width, height) of Texture to show.
+   glm::vec4 Tint = WHITE;
+};
+
+/**
+ * @struct Pickable
+ * @brief Makes a sprite entity findable by a Picker.
+ */
+struct Pickable {
+   uint32_t Layers = 1;  ///< Layer bits; queries only report entities on a layer in their mask.
+   float Depth = 0.0f;   ///< Higher is in front; equal depths are ordered as drawn.
+};
+
+/**
+ * @struct Animation
+ * @brief Owns an Animator instance; destroying the component (or its entity) destroys the instance.
+ */
+struct Animation {
+   uint32_t Instance = Animator::INVALID;
+
+   Animation() = default;
+
+   /// Starts playing a clip registered with Animator::AddClip().
+   explicit Animation(uint32_t Clip, float Speed = 1.0f) : Instance(Animator::Create(Clip, Speed)) {}
+
+   Animation(Animation&& Other) noexcept : Instance(std::exchange(Other.Instance, Animator::INVALID)) {}
+
+   Animation& operator=(Animation&& Other) noexcept {
+      if (this != &Other) {
+         if (Instance != Animator::INVALID) Animator::Destroy(Instance);
+         Instance = std::exchange(Other.Instance, Animator::INVALID);
+      }
+      return *this;
+   }
+
+   Animation(const Animation&) = delete;
+   Animation& operator=(const Animation&) = delete;
+
+   ~Animation() {
+      if (Instance != Animator::INVALID) Animator::Destroy(Instance);
+   }
+};
+
+/**
+ * @struct RigidBody
+ * @brief Owns a PhysicsWorld body that drives the entity's Transform; destroying the component destroys the body.
+ *
+ * SyncRigidBodies() copies the body's pose into the Transform after every
+ * physics step. Give physics entities no Velocity, or both would move them.
+ */
+struct RigidBody {
+   PhysicsWorld* Physics = nullptr;
+   uint32_t Body = PhysicsWorld::INVALID;
+   glm::vec2 Offset = {0.0f, 0.0f}; ///< Body center relative to Transform::Position, usually half the sprite size.
+
+   RigidBody() = default;
+
+   /// Creates a body; Def.Position is its center in the world.
+   RigidBody(PhysicsWorld& World, const BodyDef& Def, const Shape& Geometry, glm::vec2 Offset)
+       : Physics(&World), Body(World.CreateBody(Def, Geometry)), Offset(Offset) {}
+
+   RigidBody(RigidBody&& Other) noexcept
+       : Physics(Other.Physics), Body(std::exchange(Other.Body, PhysicsWorld::INVALID)), Offset(Other.Offset) {}
+
+   RigidBody& operator=(RigidBody&& Other) noexcept {
+      if (this != &Other) {
+         if (Body != PhysicsWorld::INVALID) Physics->DestroyBody(Body);
+         Physics = Other.Physics;
+         Body = std::exchange(Other.Body, PhysicsWorld::INVALID);
+         Offset = Other.Offset;
+      }
+      return *this;
+   }
+
+   RigidBody(const RigidBody&) = delete;
+   RigidBody& operator=(const RigidBody&) = delete;
+
+   ~RigidBody() {
+      if (Body != PhysicsWorld::INVALID) Physics->DestroyBody(Body);
+   }
+};
+
+/**
+ * @brief Built-in movement system: integrates every Velocity into its Transform.
+ *
+ * Application runs it after every FixedUpdate(); chunks are processed in parallel.
+ */
+void UpdateMovement(World& Entities, float dt);
+
+/// Copies every Transform into its Interpolation component; Application runs it before every tick.
+void SaveInterpolation(World& Entities);
+
+/// Moves every RigidBody's Transform to its body; Application runs it after every physics step.
+void SyncRigidBodies(World& Entities, const PhysicsWorld& Physics);
+
+} // namespace Echo2D
+
+#endif // COMPONENTS_H
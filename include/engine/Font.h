@@ -1,35 +1,57 @@
 #ifndef FONT_H
 #define FONT_H
 
-#include <map>
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <core/core.h>
 #include <glm/glm.hpp>
 #include <engine/Texture.h>
 
 namespace Echo2D {
 
+/**
+ * @enum FontMode
+ * @brief Selects how glyph bitmaps are generated and sampled.
+ *
+ * `Bitmap` rasterizes coverage at the requested pixel size and is sharpest at
+ * exactly that size. `SDF` stores a signed distance field per glyph, which the
+ * renderer thresholds per pixel so one set of glyphs stays crisp at any
+ * `scale` or camera zoom.
+ */
+enum class FontMode {
+    Bitmap, /**< Plain 8-bit coverage bitmaps. */
+    SDF     /**< Signed distance fields rendered by FreeType's SDF rasterizer. */
+};
+
 /**
  * @struct Character
  * @brief Holds all state information relevant to a single glyph character.
  *
  * The `Character` struct stores all the necessary information for rendering
- * an individual character, such as its texture, size, bearing, and the
- * advance offset used when rendering text.
+ * an individual character, such as the atlas page and rectangle it lives in,
+ * size, bearing, and the advance offset used when rendering text.
  */
 struct Character {
-    Texture* m_Texture;    /**< Pointer to the glyph's texture. */
+    Texture* m_Atlas;      /**< Atlas page holding the glyph (nullptr for glyphs without pixels, e.g. space). */
+    glm::vec4 m_UV;        /**< Glyph rectangle in the atlas page as normalized (u, v, width, height). */
     glm::ivec2 m_Size;     /**< Size of the glyph (width and height). */
     glm::ivec2 m_Bearing;  /**< Offset from baseline to top-left of glyph. */
-    GLuint m_Advance;      /**< Horizontal offset to advance to next glyph (in pixels). */
+    GLuint m_Advance;      /**< Horizontal offset to advance to next glyph (in 1/64 pixels). */
 };
 
 /**
  * @class Font
  * @brief Manages font loading and provides access to glyph Characters.
  *
- * The `Font` class loads a font from a TrueType font file and makes it
- * available for use in rendering. It provides access to individual glyph
- * characters and stores the associated textures and metadata.
+ * The `Font` class keeps a FreeType face open and rasterizes glyphs the first
+ * time a code point is requested. Glyphs are shelf-packed into fixed-size
+ * single-channel atlas pages; once the pages reach the font's memory budget,
+ * the least recently used page is cleared and reused. Lookups for the Basic
+ * Multilingual Plane go through a lazily allocated two-level direct table, so
+ * only the blocks a game actually uses cost memory.
  */
 class Font {
 public:
@@ -37,37 +59,227 @@ public:
      * @brief Constructs a Font by loading a font file at a specific pixel size.
      *
      * Initializes FreeType, loads the font file, sets the desired pixel size,
-     * and generates textures for the first 128 ASCII characters.
+     * and preloads the printable ASCII range, from the baked font cache when
+     * possible. Every other code point is rasterized on first use.
+     *
+     * In `FontMode::SDF` the pixel size is only the resolution the distance
+     * field is baked at; the font can then be drawn at any scale.
      *
      * @param fontPath Path to the TrueType font (.ttf) file.
      * @param fontSize Size (in pixels) to load the font at.
+     * @param mode Glyph generation mode (default: FontMode::Bitmap).
+     * @param atlasBudget Maximum bytes of atlas pages kept resident (default: DEFAULT_ATLAS_BUDGET).
      */
-    Font(const char* fontPath, GLuint fontSize);
+    Font(const char* fontPath, GLuint fontSize, FontMode mode = FontMode::Bitmap,
+         size_t atlasBudget = DEFAULT_ATLAS_BUDGET);
 
     /**
      * @brief Destructor. Frees associated font resources.
      *
-     * Cleans up dynamically allocated textures and releases font resources.
+     * Releases the atlas pages and the FreeType face.
      */
     ~Font();
 
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
+    /**
+     * @brief Retrieves the glyph for a Unicode code point, rasterizing it if needed.
+     *
+     * The returned reference stays valid until a later lookup evicts the page
+     * it lives on, so callers should copy what they need before requesting
+     * another glyph. Code points the face does not cover resolve to its
+     * `.notdef` glyph.
+     *
+     * @param codepoint Unicode scalar value.
+     * @return Reference to the Character object.
+     */
+    const Character& GetGlyph(char32_t codepoint);
+
     /**
      * @brief Retrieves the Character struct corresponding to a given character.
      *
-     * This function returns a reference to the `Character` object that contains
-     * the texture and metadata for the specified character.
+     * Byte-sized convenience wrapper around GetGlyph().
      *
-     * @param c ASCII character to look up.
+     * @param c Character to look up (interpreted as Latin-1).
      * @return Reference to the Character object.
      */
-    Character& GetCharacter(char c);
+    const Character& GetCharacter(char c);
+
+    /**
+     * @brief Rasterizes every code point of a UTF-8 string ahead of time.
+     *
+     * Useful during loading screens to avoid rasterizing on the first frame
+     * a piece of text appears. Atlas pages are uploaded once at the end.
+     *
+     * @param text UTF-8 encoded text.
+     */
+    void Preload(const std::string& text);
+
+    /**
+     * @brief Returns the mode the glyphs of this font were generated with.
+     * @return FontMode::Bitmap or FontMode::SDF.
+     */
+    FontMode GetMode() const;
+
+    /**
+     * @brief Bakes the current atlas pages and glyph metrics to the font cache.
+     *
+     * The constructor already bakes the preloaded ASCII set on a cache miss;
+     * call this after Preload() to make a localized glyph set load instantly
+     * on the next launch.
+     *
+     * @return true if the blob was written.
+     */
+    bool SaveCache() const;
+
+    /**
+     * @brief Sets the directory baked font blobs are stored in.
+     *
+     * Blobs are keyed by font file hash, pixel size and mode. Defaults to
+     * ".echo2d_cache" relative to the working directory; an empty string
+     * disables the cache. Affects fonts constructed afterwards.
+     */
+    static void SetCacheDirectory(const std::string& directory);
+
+    /**
+     * @brief Rasterizes a font into a cache blob without touching OpenGL.
+     *
+     * Used by `echo2d_pack` to store pre-rasterized atlases in asset archives;
+     * a Font constructed while the archive is mounted restores them instead of
+     * rasterizing.
+     *
+     * @param fontData Contents of the font file.
+     * @param fontDataSize Size of the font file in bytes.
+     * @param fontSize Pixel size the font will be loaded at.
+     * @param mode Glyph generation mode the font will be loaded with.
+     * @param text UTF-8 text whose glyphs are baked.
+     * @param blob Receives the serialized atlas.
+     * @return false if the font could not be opened.
+     */
+    static bool Bake(const unsigned char* fontData, size_t fontDataSize, GLuint fontSize, FontMode mode,
+                     const std::string& text, std::string& blob);
+
+    /// @return Archive entry name of a baked atlas for a font file, size and mode.
+    static std::string GetArchiveEntryName(const std::string& fontPath, GLuint fontSize, FontMode mode);
+
+    /// @return Number of atlas pages currently allocated.
+    size_t GetPageCount() const;
+
+    /**
+     * @brief Horizontal kerning adjustment between two code points.
+     * @return Offset in 1/64 pixels to add to the pen after `left` (0 if the face has no kerning).
+     */
+    int GetKerning(char32_t left, char32_t right) const;
+
+    /// @return Distance between consecutive baselines in pixels at the loaded size.
+    float GetLineHeight() const;
+
+    /// @return Process-unique identifier of this font, never reused after destruction.
+    uint64_t GetID() const;
+
+    /**
+     * @brief Counter bumped whenever an atlas page is evicted or the font file is reloaded.
+     *
+     * Anything that caches glyph UVs (e.g. TextLayout) compares it to detect stale rectangles.
+     */
+    uint64_t GetGeneration() const;
+
+    /// @return Index of the atlas page backed by `atlas`, or -1 if it is not one of this font's pages.
+    int GetPageIndex(const Texture* atlas) const;
+
+    /**
+     * @brief Marks an atlas page as just used, so LRU eviction keeps it.
+     *
+     * Glyph lookups do this themselves; callers drawing cached glyph UVs (e.g. TextLayout) must call it.
+     */
+    void TouchPage(int page);
+
+    /// Distance (in pixels at the bake size) covered by the SDF gradient on each side of an edge.
+    static constexpr int SDF_SPREAD = 8;
+
+    /// Empty texels kept between packed glyphs so filtering never bleeds into a neighbour.
+    static constexpr int ATLAS_PADDING = 1;
+
+    /// Default atlas memory budget per font (8 MiB of R8 pages).
+    static constexpr size_t DEFAULT_ATLAS_BUDGET = 8u << 20;
 
 private:
-    FT_Face m_Face; /**< FreeType font face object. */
-    std::map<char, Character> m_Characters; /**< Map from character codes to their glyph information. */
+    /// Cache key of the face's `.notdef` glyph, shared by every code point the face lacks.
+    static constexpr char32_t NOTDEF_KEY = 0x110000;
+
+    /// Minimum glyphs per worker before Preload rasterizes on more than one thread.
+    static constexpr size_t PARALLEL_GLYPHS_PER_THREAD = 16;
+
+    struct RasterizedGlyph;
+    struct HeadlessTag {};
+
+    Font(HeadlessTag, const unsigned char* fontData, size_t fontDataSize, GLuint fontSize, FontMode mode,
+         size_t atlasBudget);
+
+    /**
+     * @struct AtlasPage
+     * @brief One square R8 texture plus the CPU copy and shelf state used to fill it.
+     */
+    struct AtlasPage {
+        Texture* m_Texture = nullptr;        /**< GPU copy of the page. */
+        std::vector<unsigned char> m_Pixels; /**< CPU copy, so evicted regions can be re-uploaded cleared. */
+        std::vector<glm::ivec3> m_Shelves;   /**< Open shelves as (y, height, next free x). */
+        int m_NextShelfY = ATLAS_PADDING;    /**< Top of the unused area below the last shelf. */
+        std::vector<char32_t> m_Codepoints;  /**< Code points resolving to glyphs on this page, invalidated on eviction. */
+        uint64_t m_LastUse = 0;              /**< Tick of the most recent glyph placed on or looked up from this page. */
+        glm::ivec4 m_Dirty = {0, 0, 0, 0};   /**< Pending upload rectangle as (minX, minY, maxX, maxY). */
+    };
+
+    FT_Library m_Library = nullptr; /**< FreeType library handle, kept for lazy rasterization. */
+    FT_Face m_Face = nullptr; /**< FreeType font face object. */
+    FontMode m_Mode = FontMode::Bitmap; /**< How the glyph textures were generated. */
+    GLuint m_FontSize = 0; /**< Pixel size the face is set to. */
+    std::vector<unsigned char> m_FileData; /**< Font file contents, when not used in place from an archive. */
+    const unsigned char* m_FontData = nullptr; /**< Font file bytes backing every FreeType face. */
+    size_t m_FontDataSize = 0; /**< Size of m_FontData in bytes. */
+    bool m_Headless = false; /**< Baking offline: pages get no textures and nothing touches OpenGL. */
+    std::string m_CachePath; /**< Baked blob location, empty when caching is disabled. */
+    int m_PageSize = 512; /**< Width and height of every atlas page in pixels. */
+    size_t m_AtlasBudget = DEFAULT_ATLAS_BUDGET; /**< Bytes of atlas pages allowed, as passed to the constructor. */
+    size_t m_MaxPages = 1; /**< Page count allowed by the memory budget. */
+    uint64_t m_UseTick = 0; /**< Monotonic counter stamping page use for LRU eviction. */
+    bool m_DeferUpload = false; /**< Set while Preload batches page uploads. */
+    uint64_t m_ID = 0; /**< Unique font identifier. */
+    uint64_t m_Generation = 0; /**< Number of page evictions and reloads so far. */
+    uint64_t m_WatchID = 0; /**< AssetWatcher registration of the font file, 0 if not watched. */
+
+    std::vector<AtlasPage> m_Pages; /**< Atlas pages, at most m_MaxPages. */
+    std::vector<Character> m_Glyphs; /**< Glyph slots referenced by the lookup tables. */
+    std::vector<int32_t> m_FreeSlots; /**< Slots released by page eviction. */
+    std::vector<int32_t> m_GlyphPage; /**< Page index of each glyph slot (-1 when it owns no pixels). */
+
+    /// Two-level direct table for U+0000..U+FFFF: 256 lazily allocated blocks of 256 slot indices.
+    std::array<std::unique_ptr<std::array<int32_t, 256>>, 256> m_BMPTable;
+    /// Slot indices for code points outside the BMP.
+    std::unordered_map<char32_t, int32_t> m_AstralTable;
+
+    int32_t* FindSlot(char32_t codepoint, bool create);
+    bool Setup(size_t atlasBudget);
+    void UpdateCachePath();
+    void WatchSource(const std::string& fontPath);
+    void Rebuild(std::vector<unsigned char>&& fileData, const std::string& blob);
+    bool OpenFace(FT_Library& library, FT_Face& face) const;
+    void RasterizeParallel(const std::vector<char32_t>& codepoints, std::vector<RasterizedGlyph>& out) const;
+    static void Rasterize(FT_Face face, FontMode mode, char32_t codepoint, RasterizedGlyph& out);
+    int32_t LoadGlyph(char32_t codepoint);
+    int32_t InsertGlyph(const RasterizedGlyph& glyph);
+    int32_t AddSlot(const Character& character, int32_t page);
+    int CreatePage(const unsigned char* pixels);
+    void SerializeCache(std::string& buffer) const;
+    bool LoadCache();
+    bool ApplyCache(const unsigned char* blob, size_t blobSize);
+    bool AllocateRect(int width, int height, int& page, glm::ivec2& pos);
+    bool AllocateOnPage(AtlasPage& page, int width, int height, glm::ivec2& pos);
+    int EvictLeastRecentlyUsedPage();
+    void UploadDirty(AtlasPage& page);
 };
 
 } // namespace Echo2D
 
 #endif
-
@@ -0,0 +1,92 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <array>
+#include <cstddef>
+
+namespace Echo2D {
+
+/**
+ * @enum VSyncMode
+ * @brief How buffer swaps wait for the display.
+ */
+enum class VSyncMode {
+   Off,      ///< Swap immediately (tearing possible).
+   On,       ///< Wait for vertical blank.
+   Adaptive  ///< Wait for vertical blank, but swap immediately when the frame is late (falls back to On if unsupported).
+};
+
+/**
+ * @class FramePacer
+ * @brief Ends frames on a fixed cadence and measures how steady that cadence is.
+ *
+ * Wait() paces against absolute deadlines on a monotonic clock, so errors do
+ * not accumulate: it sleeps while the remaining time is comfortably longer
+ * than the OS usually oversleeps, then spins for the rest. The spin window
+ * follows the oversleep actually observed, so it stays short where sleeping
+ * is precise and grows where it is not.
+ *
+ * It also keeps the last SAMPLES frame intervals for jitter statistics and
+ * the input-to-present latency reported with RecordLatency().
+ */
+class FramePacer {
+public:
+   /// Number of frames the statistics cover.
+   static constexpr size_t SAMPLES = 128;
+
+   /**
+     * @brief Sets the frame interval to pace to.
+     * @param Seconds Target time per frame; 0 disables pacing.
+     */
+   void SetTargetFrameTime(double Seconds);
+
+   /// @return The target time per frame (0 when uncapped).
+   double GetTargetFrameTime() const;
+
+   /// Blocks until the current frame's deadline, then starts the next frame.
+   void Wait();
+
+   /**
+     * @brief Reports the time from sampling input to presenting the frame that used it.
+     * @param Seconds Latency of the latest presented frame.
+     */
+   void RecordLatency(double Seconds);
+
+   /// @return Mean frame interval over the last SAMPLES frames.
+   double GetAverageFrameTime() const;
+
+   /// @return Standard deviation of the frame interval over the last SAMPLES frames.
+   double GetJitter() const;
+
+   /// @return Longest frame interval over the last SAMPLES frames.
+   double GetMaxFrameTime() const;
+
+   /// @return Mean input-to-present latency over the last SAMPLES frames.
+   double GetAverageLatency() const;
+
+   /// @return Current spin window: time before a deadline spent spinning instead of sleeping.
+   double GetSpinWindow() const;
+
+   /// @return Seconds on a monotonic clock.
+   static double Now();
+
+private:
+   static constexpr double MIN_SPIN = 0.0002; ///< Spin at least this long; even precise sleeps wake late.
+   static constexpr double MAX_SPIN = 0.004;  ///< Never spin longer; a coarser timer just costs precision.
+
+   double m_TargetFrameTime = 0.0;
+   double m_Deadline = 0.0;          ///< Absolute time the current frame should end.
+   double m_LastFrameEnd = 0.0;
+   double m_Oversleep = 0.001;       ///< Decaying maximum of observed sleep overshoot.
+
+   std::array<double, SAMPLES> m_FrameTimes = {};
+   std::array<double, SAMPLES> m_Latencies = {};
+   size_t m_FrameCount = 0;
+   size_t m_LatencyCount = 0;
+
+   void RecordFrame(double Now);
+};
+
+} // namespace Echo2D
+
+#endif // FRAMEPACER_H
@@ -0,0 +1,106 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Echo2D {
+
+/**
+ * @class FrameStats
+ * @brief Frame-time telemetry for whole sessions: a log-bucketed histogram plus a ring of recent frames.
+ *
+ * The histogram is HDR-style: times are counted in microseconds, exactly
+ * below SUB_BUCKETS and otherwise in SUB_BUCKETS linear buckets per power of
+ * two, so every percentile is within about 3% of the true value however long
+ * the session runs, in a fixed 7 KiB.
+ *
+ * One thread records (Application, once per frame); every counter is an
+ * atomic, so any other thread can read percentiles or the recent frames
+ * without locks. A reader racing Record() may see that frame only partially
+ * counted, never a corrupted value.
+ */
+class FrameStats {
+public:
+   /// Recent frame times kept for rolling averages.
+   static constexpr size_t HISTORY = 256;
+
+   /// Linear buckets per power of two (relative precision 1 / SUB_BUCKETS).
+   static constexpr uint64_t SUB_BUCKETS = 32;
+
+   /// Longest time tracked, in microseconds (about 71 minutes); longer frames count as this.
+   static constexpr uint64_t MAX_MICROSECONDS = (uint64_t(1) << 32) - 1;
+
+   /**
+     * @brief Counts one frame. Only one thread may record.
+     * @param Seconds Frame time.
+     */
+   void Record(double Seconds);
+
+   /// Forgets everything recorded. Must not race Record().
+   void Reset();
+
+   /**
+     * @brief Returns the frame time below which a fraction of the frames fall.
+     * @param Percentile Fraction in [0, 1], e.g. 0.99 for p99.
+     * @return Seconds (upper edge of the bucket holding the percentile), 0 if nothing was recorded.
+     */
+   double GetPercentile(double Percentile) const;
+
+   /// @return Longest frame time recorded, in seconds.
+   double GetMax() const;
+
+   /// @return Shortest frame time recorded, in seconds.
+   double GetMin() const;
+
+   /// @return Mean frame time over the whole session, in seconds.
+   double GetMean() const;
+
+   /// @return Number of frames recorded.
+   uint64_t GetCount() const;
+
+   /**
+     * @brief Averages the most recent frames.
+     * @param Count Frames to average (at most HISTORY).
+     */
+   double GetRecentMean(size_t Count) const;
+
+   /**
+     * @brief Copies the most recent frame times, oldest first.
+     * @return Number of values written (at most MaxCount and HISTORY).
+     */
+   size_t GetRecent(double* Out, size_t MaxCount) const;
+
+   /**
+     * @brief Writes the summary and the non-empty histogram buckets.
+     *
+     * The format follows the extension: ".json" writes JSON, anything else CSV
+     * (one row per bucket with its bounds in milliseconds, count and
+     * cumulative fraction, after commented summary lines).
+     *
+     * @return false if the file could not be written.
+     */
+   bool Export(const std::string& Path) const;
+
+private:
+   static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (32 - 5) * SUB_BUCKETS; ///< 5 = log2(SUB_BUCKETS).
+
+   std::atomic<uint64_t> m_Buckets[BUCKET_COUNT] = {};
+   std::atomic<uint64_t> m_Count = 0;
+   std::atomic<uint64_t> m_Total = 0;       ///< Sum of all frame times in microseconds.
+   std::atomic<uint64_t> m_Max = 0;
+   std::atomic<uint64_t> m_Min = UINT64_MAX;
+
+   std::atomic<double> m_Recent[HISTORY] = {};
+   std::atomic<uint64_t> m_Written = 0;     ///< Frames written to m_Recent.
+
+   static size_t BucketOf(uint64_t Microseconds);
+   static uint64_t BucketLow(size_t Bucket);
+   static uint64_t BucketHigh(size_t Bucket);
+};
+
+} // namespace Echo2D
+
+#endif // FRAMESTATS_H
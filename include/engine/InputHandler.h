@@ -3,15 +3,193 @@
 
 #include "core/core.h"
 #include <utils/Utils.h>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
 
 namespace Echo2D {
 
+/// Number of GLFW key codes (GLFW_KEY_LAST + 1).
+static constexpr int KEY_COUNT = GLFW_KEY_LAST + 1;
+
+/// Number of GLFW mouse buttons (GLFW_MOUSE_BUTTON_LAST + 1).
+static constexpr int MOUSE_BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+/**
+ * @enum InputEventType
+ * @brief Kind of an InputEvent.
+ */
+enum class InputEventType : uint8_t {
+    Key,          ///< Code is a GLFW key, Action GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT.
+    MouseButton,  ///< Code is a GLFW mouse button, Action GLFW_PRESS or GLFW_RELEASE.
+    MouseMove,    ///< X, Y is the new cursor position in window pixels.
+    Scroll        ///< X, Y is the scroll offset.
+};
+
+/**
+ * @struct InputEvent
+ * @brief One GLFW input callback, as recorded in the InputQueue.
+ */
+struct InputEvent {
+    double Time = 0.0;                           ///< FramePacer::Now() when the callback ran.
+    InputEventType Type = InputEventType::Key;
+    int16_t Code = 0;
+    int8_t Action = 0;
+    uint8_t Mods = 0;                            ///< GLFW modifier bits.
+    float X = 0.0f;
+    float Y = 0.0f;
+};
+
+/**
+ * @class InputQueue
+ * @brief Lock-free single-producer single-consumer ring buffer of input events.
+ *
+ * The GLFW callbacks push (producer) and Input::Update() pops (consumer);
+ * the two may run on different threads. When the ring is full new events
+ * are dropped and counted rather than blocking the callback.
+ */
+class InputQueue {
+public:
+    /// Events the ring holds; a power of two.
+    static constexpr size_t CAPACITY = 4096;
+
+    /// @return false if the ring was full and the event was dropped. Producer only.
+    bool Push(const InputEvent& Event);
+
+    /// @return false if the ring is empty. Consumer only.
+    bool Pop(InputEvent& Event);
+
+    /// @return Events dropped because the ring was full.
+    uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::array<InputEvent, CAPACITY> m_Events;
+    alignas(64) std::atomic<size_t> m_Head = 0;   ///< Next slot to pop; written by the consumer.
+    alignas(64) std::atomic<size_t> m_Tail = 0;   ///< Next slot to push; written by the producer.
+    std::atomic<uint64_t> m_Dropped = 0;
+};
+
+/**
+ * @class InputSnapshot
+ * @brief Immutable input state of one frame, built from that frame's events by Input::Update().
+ *
+ * Pressed and released are edges: a key tapped and let go between two frames
+ * reports both WasKeyPressed() and WasKeyReleased() for the frame, though it
+ * is no longer down. Mouse motion and scrolling are summed over the frame.
+ * Snapshots are plain values, so a copy can be handed to another thread.
+ */
+class InputSnapshot {
+public:
+    bool IsKeyDown(int Key) const { return Key >= 0 && Key < KEY_COUNT && m_KeysDown[Key]; }
+    bool WasKeyPressed(int Key) const { return Key >= 0 && Key < KEY_COUNT && m_KeysPressed[Key]; }
+    bool WasKeyReleased(int Key) const { return Key >= 0 && Key < KEY_COUNT && m_KeysReleased[Key]; }
+
+    bool IsButtonDown(int Button) const { return Button >= 0 && Button < MOUSE_BUTTON_COUNT && m_ButtonsDown[Button]; }
+    bool WasButtonPressed(int Button) const {
+        return Button >= 0 && Button < MOUSE_BUTTON_COUNT && m_ButtonsPressed[Button];
+    }
+    bool WasButtonReleased(int Button) const {
+        return Button >= 0 && Button < MOUSE_BUTTON_COUNT && m_ButtonsReleased[Button];
+    }
+
+    /// @return Whether the cursor moved with a button held, since that button went down.
+    bool IsDragging() const { return m_Dragging; }
+
+    /// @return Cursor position in window pixels at the end of the frame.
+    glm::vec2 GetMousePosition() const { return m_MousePosition; }
+
+    /// @return Cursor movement during the frame (current minus previous position).
+    glm::vec2 GetMouseDelta() const { return m_MouseDelta; }
+
+    /// @return Scroll offsets summed over the frame.
+    glm::vec2 GetScroll() const { return m_Scroll; }
+
+    /// @return The frame's events, oldest first.
+    const std::vector<InputEvent>& GetEvents() const { return m_Events; }
+
+    /// @return FramePacer::Now() when the snapshot was built.
+    double GetTime() const { return m_Time; }
+
+    /// @return Number of snapshots built before this one.
+    uint64_t GetFrame() const { return m_Frame; }
+
+private:
+    friend class Input;
+
+    std::bitset<KEY_COUNT> m_KeysDown, m_KeysPressed, m_KeysReleased;
+    std::bitset<MOUSE_BUTTON_COUNT> m_ButtonsDown, m_ButtonsPressed, m_ButtonsReleased;
+    glm::vec2 m_MousePosition = {0.0f, 0.0f};
+    glm::vec2 m_MouseDelta = {0.0f, 0.0f};
+    glm::vec2 m_Scroll = {0.0f, 0.0f};
+    bool m_HasMousePosition = false;             ///< false until the first cursor event.
+    bool m_Dragging = false;
+    std::vector<InputEvent> m_Events;
+    double m_Time = 0.0;
+    uint64_t m_Frame = 0;
+};
+
+/**
+ * @class Input
+ * @brief Lossless, timestamped input: GLFW events are queued and turned into one InputSnapshot per frame.
+ *
+ * The listeners push every callback into an InputQueue with a
+ * high-resolution timestamp. Application calls Update() once per frame,
+ * right after polling events, and game code reads GetSnapshot() (directly
+ * or through KeyListener and MouseListener). Programs polling a
+ * WindowHandler themselves must call Update() after every poll. Update()
+ * must only be called from one thread at a time.
+ */
+class Input : public Utils::Singleton<Input> {
+    friend class Utils::Singleton<Input>;
+
+public:
+    /// Queues an event; called by the GLFW callbacks.
+    static void Push(const InputEvent& Event);
+
+    /**
+     * @brief Applies the events queued since the last call to a new snapshot.
+     * @return The new snapshot, also returned by GetSnapshot() until the next call.
+     */
+    static const InputSnapshot& Update();
+
+    /**
+     * @brief Builds the next snapshot from given events instead of the queue, e.g. when replaying a recording.
+     *
+     * Queued live events are discarded.
+     *
+     * @param Time Snapshot time to report; replays pass the recorded one.
+     */
+    static const InputSnapshot& Update(const InputEvent* Events, size_t Count, double Time);
+
+    /// @return The snapshot built by the last Update().
+    static const InputSnapshot& GetSnapshot();
+
+    /// @return Events lost because more than InputQueue::CAPACITY arrived between two updates.
+    static uint64_t GetDroppedCount();
+
+private:
+    InputQueue m_Queue;
+    InputSnapshot m_Snapshot;
+    std::vector<InputEvent> m_Pending;   ///< Events drained from the queue for the next snapshot.
+    uint64_t m_ReportedDrops = 0;
+
+    const InputSnapshot& Build(const InputEvent* Events, size_t Count, double Time);
+
+    Input() = default;
+    ~Input() = default;
+};
+
 /**
  * @class KeyListener
  * @brief Handles keyboard input via GLFW callbacks.
  *
- * Singleton class that tracks the pressed state of keys using a key state array.
- * Intended for internal engine use to poll keyboard state.
+ * Singleton class that queues key events for Input and answers key state
+ * queries from the current InputSnapshot, so a replayed recording drives it
+ * like live input. Intended for internal engine use to poll keyboard state.
  */
 class KeyListener : public Utils::Singleton<KeyListener> {
     friend class Utils::Singleton<KeyListener>;
@@ -36,8 +214,6 @@ public:
     static bool IsKeyPressed(int Key);
 
 private:
-    bool m_Keys[350] = { false }; ///< State array for 350 possible GLFW keys.
-
     KeyListener() = default;
     ~KeyListener() = default;
 };
@@ -46,8 +222,8 @@ private:
  * @class MouseListener
  * @brief Handles mouse input events like position, scroll, drag, and buttons.
  *
- * Singleton class that maintains mouse state, including position deltas
- * and button presses.
+ * Singleton class that queues mouse events for Input; position, deltas,
+ * scrolling and buttons are read from the current InputSnapshot.
  */
 class MouseListener : public Utils::Singleton<MouseListener> {
     friend class Utils::Singleton<MouseListener>;
@@ -64,7 +240,7 @@ public:
 
     /**
      * @brief Checks whether a mouse button is held down.
-     * @param MouseButton 0 = left, 1 = right, 2 = middle.
+     * @param MouseButton 0 = left, 1 = right, 2 = middle (up to GLFW_MOUSE_BUTTON_LAST).
      * @return true if held; false otherwise.
      */
     static bool IsMouseButtonDown(int MouseButton);
@@ -81,26 +257,19 @@ public:
     /// Current Y position of the mouse.
     static float GetY();
 
-    /// Mouse delta in X direction since last frame.
+    /// Mouse delta in X direction over the last frame (previous minus current position).
     static float GetDx();
 
-    /// Mouse delta in Y direction since last frame.
+    /// Mouse delta in Y direction over the last frame (previous minus current position).
     static float GetDy();
 
-    /// Mouse scroll in X direction.
+    /// Mouse scroll in X direction over the last frame.
     static float GetScrollX();
 
-    /// Mouse scroll in Y direction.
+    /// Mouse scroll in Y direction over the last frame.
     static float GetScrollY();
 
 private:
-    bool m_MouseButtons[3] = { false }; ///< Button state array for left, right, middle.
-    bool m_IsDragging = false;          ///< Drag state flag.
-
-    double m_PosX = 0.0, m_PosY = 0.0;             ///< Current position.
-    double m_LastPosX = 0.0, m_LastPosY = 0.0;     ///< Previous position (for delta).
-    double m_ScrollX = 0.0, m_ScrollY = 0.0;       ///< Scroll delta.
-
     MouseListener() = default;
     ~MouseListener() = default;
 };
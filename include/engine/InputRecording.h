@@ -0,0 +1,92 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include "engine/InputHandler.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @class InputRecorder
+ * @brief Streams every frame's delta time and input events to a compact binary file.
+ *
+ * File layout (little endian): the 8-byte MAGIC and a uint32_t VERSION,
+ * then one record per frame: double delta time, double snapshot time,
+ * uint32_t event count and that many 21-byte events (double time, uint8_t
+ * type, int8_t action, uint8_t mods, int16_t code, float x, float y).
+ * Doubles and floats are stored bit for bit, so InputReplay hands back
+ * exactly what was recorded.
+ */
+class InputRecorder {
+public:
+   static constexpr char MAGIC[8] = {'E', '2', 'D', 'I', 'N', 'P', 'U', 'T'};
+   static constexpr uint32_t VERSION = 1;
+
+   ~InputRecorder();
+
+   /// Creates the file and writes its header; any open recording is closed first.
+   bool Open(const std::string& Path);
+
+   /**
+     * @brief Appends a frame.
+     * @param DeltaTime The frame's delta time as passed to Update().
+     * @param Snapshot The input the frame saw.
+     */
+   void Record(double DeltaTime, const InputSnapshot& Snapshot);
+
+   /// Flushes and closes the file. @return false if anything failed to write.
+   bool Close();
+
+   bool IsOpen() const { return m_File.is_open(); }
+   size_t GetFrameCount() const { return m_Frames; }
+
+private:
+   std::ofstream m_File;
+   std::string m_Path;
+   std::string m_Buffer;   ///< Written in large blocks, not per frame.
+   size_t m_Frames = 0;
+   bool m_Failed = false;
+
+   void Flush();
+};
+
+/**
+ * @class InputReplay
+ * @brief A recording loaded into memory, played back one frame at a time.
+ *
+ * The whole file is read and validated by Load(), so playback never touches
+ * the disk.
+ */
+class InputReplay {
+public:
+   /// @return false if the file is missing, of another version or truncated.
+   bool Load(const std::string& Path);
+
+   /**
+     * @brief Advances to the next recorded frame.
+     * @return false when every frame has been played.
+     */
+   bool Next(double& DeltaTime, double& Time, const InputEvent*& Events, size_t& Count);
+
+   /// Starts playback over from the first frame.
+   void Rewind() { m_Position = 0; }
+
+   size_t GetFrameCount() const { return m_DeltaTimes.size(); }
+   size_t GetPosition() const { return m_Position; }
+   bool IsFinished() const { return m_Position >= m_DeltaTimes.size(); }
+
+private:
+   std::vector<double> m_DeltaTimes;
+   std::vector<double> m_Times;
+   std::vector<size_t> m_FirstEvent;   ///< Frame f owns m_Events[m_FirstEvent[f], m_FirstEvent[f + 1]).
+   std::vector<InputEvent> m_Events;
+   size_t m_Position = 0;
+};
+
+} // namespace Echo2D
+
+#endif // INPUTRECORDING_H
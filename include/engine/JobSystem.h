@@ -0,0 +1,136 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include "core/core.h"
+#include "utils/Utils.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Echo2D {
+
+class JobSystem;
+
+/**
+ * @class JobCounter
+ * @brief Counts unfinished jobs, so a thread can wait for them or chain jobs after them.
+ *
+ * Pass the same counter to several JobSystem::Run() calls to wait for all of
+ * them at once. A counter must outlive its jobs: destroy it only after
+ * JobSystem::Wait() on it returned.
+ */
+class JobCounter {
+public:
+   JobCounter() = default;
+   JobCounter(const JobCounter&) = delete;
+   JobCounter& operator=(const JobCounter&) = delete;
+
+   /// @return Whether every job counted so far has finished.
+   bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+private:
+   friend class JobSystem;
+
+   struct Deferred {
+      std::function<void()> Fn;
+      JobCounter* Done;
+   };
+
+   std::atomic<uint32_t> m_Pending = 0;
+   std::mutex m_Mutex;                   ///< Guards m_Continuations and the transition to zero.
+   std::vector<Deferred> m_Continuations; ///< Jobs waiting for this counter to reach zero.
+};
+
+/**
+ * @class JobSystem
+ * @brief Engine-owned work-stealing thread pool.
+ *
+ * Every worker owns a job deque: it pushes and pops its own jobs at the back
+ * (newest first, while their data is still in cache) and, when it runs dry,
+ * steals the oldest job from the front of another deque. Threads that Wait()
+ * run jobs themselves instead of blocking, so jobs may spawn and wait for
+ * other jobs without deadlocking the pool.
+ *
+ * Jobs may run on any thread, so they must not touch the GL context or
+ * asset handles; resolve what they need on the main thread before queuing.
+ *
+ * Application starts the pool on construction; Update() can use ParallelFor()
+ * directly. The engine uses it to decode textures, run World::ParallelEach()
+ * and build sprite batches.
+ */
+class JobSystem : public Utils::Singleton<JobSystem> {
+   friend class Utils::Singleton<JobSystem>;
+
+public:
+   using Job = std::function<void()>;
+
+   /**
+     * @brief Starts the worker threads. The calling thread becomes the main thread.
+     * @param Workers Worker thread count; 0 uses one per hardware thread besides the caller.
+     */
+   static void Start(unsigned Workers = 0);
+
+   /// Runs every queued job, then stops the workers.
+   static void Shutdown();
+
+   /**
+     * @brief Queues a job on any thread.
+     * @param Fn Work to run.
+     * @param Done Counter incremented now and decremented when the job finishes (optional).
+     * @param After The job is only queued once this counter reaches zero (optional).
+     */
+   static void Run(Job Fn, JobCounter* Done = nullptr, JobCounter* After = nullptr);
+
+   /// Runs jobs until every job counted by Counter has finished.
+   static void Wait(JobCounter& Counter);
+
+   /**
+     * @brief Calls Body(First, Last) on subranges of [Begin, End) in parallel and waits for all of them.
+     * @param Grain Smallest subrange worth a job.
+     */
+   static void ParallelFor(size_t Begin, size_t End, size_t Grain, const std::function<void(size_t, size_t)>& Body);
+
+   /// @return Number of worker threads (0 before Start()).
+   static unsigned GetWorkerCount();
+
+   /// @return Whether the caller is the thread that called Start().
+   static bool IsMainThread();
+
+private:
+   struct Task {
+      Job Fn;
+      JobCounter* Done = nullptr;
+   };
+
+   struct Queue {
+      std::mutex Mutex;
+      std::deque<Task> Tasks;
+   };
+
+   std::vector<std::unique_ptr<Queue>> m_Queues; ///< [0] main thread and foreign threads, [1..] workers.
+   std::vector<std::thread> m_Threads;
+   std::thread::id m_MainThread;
+   std::atomic<bool> m_Running = false;
+   std::atomic<size_t> m_Stealable = 0;          ///< Jobs queued in m_Queues.
+   std::mutex m_SleepMutex;
+   std::condition_variable m_Wake;
+
+   void Push(Task Item);
+   bool TryRunOne();
+   void Execute(Task& Item);
+   void WorkerLoop(size_t Index);
+
+   JobSystem() = default;
+   ~JobSystem();
+};
+
+} // namespace Echo2D
+
+#endif // JOBSYSTEM_H
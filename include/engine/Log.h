@@ -0,0 +1,220 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "utils/Utils.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <thread>
+
+// Level values, also usable in ECHO2D_LOG_LEVEL
+#define ECHO2D_LOG_TRACE 0
+#define ECHO2D_LOG_DEBUG 1
+#define ECHO2D_LOG_INFO 2
+#define ECHO2D_LOG_WARNING 3
+#define ECHO2D_LOG_ERROR 4
+#define ECHO2D_LOG_FATAL 5
+
+// Lowest level compiled in; DEBUG, or INFO in NDEBUG builds
+#ifndef ECHO2D_LOG_LEVEL
+#ifdef NDEBUG
+#define ECHO2D_LOG_LEVEL ECHO2D_LOG_INFO
+#else
+#define ECHO2D_LOG_LEVEL ECHO2D_LOG_DEBUG
+#endif
+#endif
+
+/**
+ * @brief Logs a message through the engine's log, e.g. ECHO2D_LOG(INFO) << "[Class] Text " << Value;
+ *
+ * Levels are TRACE, DEBUG, INFO, WARNING, ERROR and FATAL. Below
+ * ECHO2D_LOG_LEVEL the statement is compiled out, arguments included; below
+ * Log::SetLevel() they are not evaluated.
+ */
+#define ECHO2D_LOG(LEVEL)                                                                            \
+   if constexpr (ECHO2D_LOG_##LEVEL < ECHO2D_LOG_LEVEL) {                                             \
+   } else if (!::Echo2D::Log::IsEnabled(static_cast<::Echo2D::LogLevel>(ECHO2D_LOG_##LEVEL))) {      \
+   } else                                                                                             \
+      ::Echo2D::LogMessage(static_cast<::Echo2D::LogLevel>(ECHO2D_LOG_##LEVEL)).Stream()
+
+/**
+ * @brief Like ECHO2D_LOG(), but this call site logs at most once every SECONDS.
+ *
+ * Meant for messages that may fire every frame. The next message that gets
+ * through reports how many were suppressed in between.
+ */
+#define ECHO2D_LOG_EVERY(LEVEL, SECONDS)                                                             \
+   if constexpr (ECHO2D_LOG_##LEVEL < ECHO2D_LOG_LEVEL) {                                             \
+   } else if (static ::Echo2D::LogLimiter Echo2DLimiter(SECONDS);                                     \
+              !::Echo2D::Log::IsEnabled(static_cast<::Echo2D::LogLevel>(ECHO2D_LOG_##LEVEL)) ||       \
+              !Echo2DLimiter.Allow()) {                                                               \
+   } else                                                                                             \
+      ::Echo2D::LogMessage(static_cast<::Echo2D::LogLevel>(ECHO2D_LOG_##LEVEL),                       \
+                           Echo2DLimiter.TakeSuppressed())                                            \
+         .Stream()
+
+namespace Echo2D {
+
+/**
+ * @enum LogLevel
+ * @brief Severity of a log message, matching the ECHO2D_LOG_* values.
+ */
+enum class LogLevel : uint8_t { Trace, Debug, Info, Warning, Error, Fatal };
+
+struct LogFormatter;
+
+/**
+ * @class LogQueue
+ * @brief Lock-free multi-producer single-consumer ring buffer of formatted log messages.
+ *
+ * Any thread pushes; only the log's writer pops. Each slot carries a
+ * sequence number, so producers claim slots with a single compare-exchange
+ * and the consumer only reads slots whose message is complete.
+ */
+class LogQueue {
+public:
+   /// Messages the ring holds; a power of two.
+   static constexpr size_t CAPACITY = 2048;
+   /// Longest message kept, terminator included; longer ones are cut short.
+   static constexpr size_t MESSAGE_SIZE = 256;
+
+   struct Record {
+      LogLevel Level = LogLevel::Info;
+      char Text[MESSAGE_SIZE];
+   };
+
+   LogQueue();
+
+   /// @return false if the ring was full. Any thread.
+   bool Push(LogLevel Level, const char* Text, size_t Length);
+
+   /// @return false if the ring is empty. Consumer only.
+   bool Pop(Record& Out);
+
+   /// @return Messages pushed so far; a Flush() target.
+   size_t GetPushed() const { return m_Tail.load(std::memory_order_acquire); }
+
+   /// @return Messages popped so far.
+   size_t GetPopped() const { return m_Head.load(std::memory_order_acquire); }
+
+private:
+   struct Slot {
+      std::atomic<size_t> Sequence;  ///< Position + 1 once written, position + CAPACITY once read.
+      Record Message;
+   };
+
+   std::array<Slot, CAPACITY> m_Slots;
+   alignas(64) std::atomic<size_t> m_Head = 0;   ///< Next slot to pop; written by the consumer.
+   alignas(64) std::atomic<size_t> m_Tail = 0;   ///< Next slot to claim; shared by producers.
+};
+
+/**
+ * @class LogLimiter
+ * @brief Per call site state of ECHO2D_LOG_EVERY().
+ */
+class LogLimiter {
+public:
+   explicit LogLimiter(double Seconds);
+
+   /// @return Whether a message may go out now; counts it as suppressed otherwise.
+   bool Allow();
+
+   /// @return Messages suppressed since the last call.
+   uint64_t TakeSuppressed() { return m_Suppressed.exchange(0, std::memory_order_relaxed); }
+
+private:
+   const int64_t m_Interval;              ///< Nanoseconds.
+   std::atomic<int64_t> m_Next = INT64_MIN;
+   std::atomic<uint64_t> m_Suppressed = 0;
+};
+
+/**
+ * @class LogMessage
+ * @brief One message being formatted; hands it to the Log when the statement ends.
+ *
+ * Messages are formatted into a per-thread buffer, so logging allocates
+ * nothing; destructors of static objects may still log during teardown.
+ * Do not log from inside another message's operator<<.
+ */
+class LogMessage {
+public:
+   explicit LogMessage(LogLevel Level, uint64_t Suppressed = 0);
+   ~LogMessage();
+
+   LogMessage(const LogMessage&) = delete;
+   LogMessage& operator=(const LogMessage&) = delete;
+
+   std::ostream& Stream();
+
+private:
+   LogLevel m_Level;
+   uint64_t m_Suppressed;
+   LogFormatter* m_Formatter;
+};
+
+/**
+ * @class Log
+ * @brief Engine logging front end: level filtering and an asynchronous sink in front of easylogging++.
+ *
+ * Once Start() has run, messages are pushed into a LogQueue and a writer
+ * thread passes them to easylogging++ every couple of milliseconds, so the
+ * thread that logged never waits on the console or the log file. Timestamps
+ * are taken when a message is written, at most that late. When the queue is
+ * full, messages below ERROR are dropped and counted; errors wait for room.
+ * FATAL messages flush the queue and are written on the calling thread.
+ *
+ * Before Start() and after Stop() messages are written synchronously.
+ * Application starts the log on construction and stops it on destruction.
+ */
+class Log : public Utils::Singleton<Log> {
+   friend class Utils::Singleton<Log>;
+
+public:
+   /// Starts the writer thread.
+   static void Start();
+
+   /// Writes every queued message and stops the writer thread.
+   static void Stop();
+
+   /// Blocks until every message queued so far is written.
+   static void Flush();
+
+   /**
+     * @brief Sets the lowest level logged at runtime.
+     *
+     * Levels under ECHO2D_LOG_LEVEL are compiled out and stay off.
+     * ERROR and FATAL are never filtered.
+     */
+   static void SetLevel(LogLevel Level);
+   static LogLevel GetLevel();
+
+   static bool IsEnabled(LogLevel Level) { return Level >= GetInstance().m_Level.load(std::memory_order_relaxed); }
+
+   /// Queues, or while stopped writes, a formatted message.
+   static void Write(LogLevel Level, const char* Text, size_t Length);
+
+   /// @return Messages dropped because the queue was full.
+   static uint64_t GetDroppedCount();
+
+private:
+   LogQueue m_Queue;
+   std::thread m_Thread;
+   std::atomic<bool> m_Active = false;
+   std::atomic<bool> m_Stopping = false;
+   std::atomic<LogLevel> m_Level = LogLevel::Trace;
+   std::atomic<uint64_t> m_Dropped = 0;
+   uint64_t m_ReportedDrops = 0;     ///< Writer only.
+
+   void WriterLoop();
+   bool Drain();
+   static void Emit(LogLevel Level, const char* Text);
+
+   Log() = default;
+   ~Log();
+};
+
+} // namespace Echo2D
+
+#endif // LOG_H
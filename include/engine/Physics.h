@@ -0,0 +1,265 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include "engine/Broadphase.h"
+#include "engine/Collision.h"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @enum BodyType
+ * @brief How a rigid body responds to forces and contacts.
+ */
+enum class BodyType : uint8_t {
+   Static,    ///< Never moves.
+   Kinematic, ///< Moves with the velocity it is given; pushes dynamic bodies but is never pushed.
+   Dynamic    ///< Moved by gravity, forces and contacts.
+};
+
+/**
+ * @struct BodyDef
+ * @brief Initial state of a rigid body, passed to PhysicsWorld::CreateBody().
+ *
+ * Units are pixels, seconds and radians, with the y axis pointing down and
+ * angles clockwise on screen, as in Transform.
+ */
+struct BodyDef {
+   BodyType Type = BodyType::Dynamic;
+   glm::vec2 Position = {0.0f, 0.0f};       ///< Center of mass in the world.
+   float Angle = 0.0f;
+   glm::vec2 LinearVelocity = {0.0f, 0.0f};
+   float AngularVelocity = 0.0f;
+   float Density = 1.0f;                    ///< Mass per square pixel.
+   float Friction = 0.5f;
+   float Restitution = 0.0f;                ///< Bounciness, 0 to 1.
+   float LinearDamping = 0.0f;
+   float AngularDamping = 0.0f;
+   float GravityScale = 1.0f;
+   bool FixedRotation = false;              ///< Never rotates; with a Box shape this makes an AABB body.
+   uint32_t Category = 1;                   ///< Collision layers the body is on (bits).
+   uint32_t Mask = UINT32_MAX;              ///< Layers it collides with; both bodies must accept each other.
+   uint32_t UserData = 0;                   ///< Handed back by GetUserData(), e.g. an entity ID.
+};
+
+/**
+ * @struct Contact
+ * @brief A touching (or about to touch) pair of bodies, kept across steps while their bounds overlap.
+ */
+struct Contact {
+   uint32_t BodyA = 0;    ///< Lower body ID of the pair.
+   uint32_t BodyB = 0;
+   float Friction = 0.0f;
+   float Restitution = 0.0f;
+   Manifold Geometry;     ///< Normal from A to B; PointCount is 0 while the shapes are apart.
+};
+
+/**
+ * @class PhysicsWorld
+ * @brief 2D rigid-body simulation: circles, boxes and convex polygons with friction, restitution and sleeping.
+ *
+ * Bodies live in contiguous structure-of-arrays storage and are addressed by
+ * stable IDs. Step() advances the simulation by a fixed time step:
+ *
+ *   1. Gravity, forces and damping update the velocities of awake bodies.
+ *   2. The Broadphase (spatial hash) finds bodies with overlapping bounds;
+ *      contact manifolds are computed for them in parallel and matched with
+ *      the previous step's by feature, keeping their impulses.
+ *   3. Dynamic bodies are grouped into islands of bodies touching each
+ *      other. An island that has rested for TIME_TO_SLEEP goes to sleep as a
+ *      whole and is skipped by every later step, except for its broadphase
+ *      entries, until something awake touches it.
+ *   4. Awake islands are solved on the JobSystem workers, one island per
+ *      job: a warm-started sequential impulse solver, then position
+ *      integration.
+ *
+ * Contacts and islands are processed in an order that depends only on the
+ * bodies, so the same steps from the same state give the same results
+ * whatever the worker count. Application steps its PhysicsWorld once per
+ * fixed tick.
+ */
+class PhysicsWorld {
+public:
+   /// Body ID that never refers to a body.
+   static constexpr uint32_t INVALID = UINT32_MAX;
+
+   /// Seconds a whole island must rest before it falls asleep.
+   static constexpr float TIME_TO_SLEEP = 0.5f;
+
+   PhysicsWorld();
+
+   /**
+     * @brief Adds a body.
+     * @return Its ID, reused after DestroyBody().
+     */
+   uint32_t CreateBody(const BodyDef& Def, const Shape& Geometry);
+
+   /// Removes a body, waking the bodies it touched.
+   void DestroyBody(uint32_t Body);
+
+   /// Removes every body.
+   void Clear();
+
+   /**
+     * @brief Advances the simulation.
+     * @param dt Step length in seconds; keep it fixed for stable, repeatable results.
+     */
+   void Step(float dt);
+
+   /**
+     * @brief Draws shapes, contact points and normals through the Renderer.
+     *
+     * Static bodies are grey, sleeping ones dark and awake ones green.
+     */
+   void DebugDraw() const;
+
+   /// Appends the bodies whose bounds overlap a region.
+   void QueryRegion(const AABB& Region, std::vector<uint32_t>& Out);
+
+   // === Bodies ===
+   // Getters return zero values for IDs that are not IsValid(); setters ignore them.
+
+   bool IsValid(uint32_t Body) const { return Body < m_Slots.size() && m_Slots[Body] != INVALID; }
+   BodyType GetType(uint32_t Body) const { return IsValid(Body) ? m_Type[m_Slots[Body]] : BodyType::Static; }
+   const Shape& GetShape(uint32_t Body) const;
+   uint32_t GetUserData(uint32_t Body) const { return IsValid(Body) ? m_UserData[m_Slots[Body]] : 0; }
+
+   glm::vec2 GetPosition(uint32_t Body) const { return IsValid(Body) ? m_Position[m_Slots[Body]] : glm::vec2(0.0f); }
+   float GetAngle(uint32_t Body) const { return IsValid(Body) ? m_Angle[m_Slots[Body]] : 0.0f; }
+   glm::vec2 GetLinearVelocity(uint32_t Body) const {
+      return IsValid(Body) ? m_LinearVelocity[m_Slots[Body]] : glm::vec2(0.0f);
+   }
+   float GetAngularVelocity(uint32_t Body) const { return IsValid(Body) ? m_AngularVelocity[m_Slots[Body]] : 0.0f; }
+   float GetMass(uint32_t Body) const;
+
+   /// Teleports a body, waking it.
+   void SetTransform(uint32_t Body, glm::vec2 Position, float Angle);
+   void SetLinearVelocity(uint32_t Body, glm::vec2 Velocity);
+   void SetAngularVelocity(uint32_t Body, float Velocity);
+
+   /// Adds a force (pixels * mass / s^2) at the center for the next step, waking the body.
+   void ApplyForce(uint32_t Body, glm::vec2 Force);
+
+   /// Adds a torque for the next step, waking the body.
+   void ApplyTorque(uint32_t Body, float Torque);
+
+   /// Changes a body's velocity at once by an impulse applied at a world point.
+   void ApplyImpulse(uint32_t Body, glm::vec2 Impulse, glm::vec2 Point);
+
+   bool IsAwake(uint32_t Body) const { return IsValid(Body) && m_Awake[m_Slots[Body]] != 0; }
+
+   /// Wakes a sleeping body (and so its island).
+   void Wake(uint32_t Body);
+
+   // === Settings ===
+
+   /// Sets the acceleration applied to every dynamic body (default 980 px/s^2 downwards).
+   void SetGravity(glm::vec2 Gravity) { m_Gravity = Gravity; }
+   glm::vec2 GetGravity() const { return m_Gravity; }
+
+   /// Sets the velocity iterations per step (default 8); more gives stiffer stacks.
+   void SetIterations(int Iterations) { m_Iterations = Iterations > 0 ? Iterations : 1; }
+
+   /// Enables or disables sleeping; disabling wakes every body.
+   void SetSleeping(bool Enabled);
+
+   // === Statistics ===
+
+   size_t GetBodyCount() const { return m_IDs.size(); }
+   size_t GetAwakeCount() const;
+   size_t GetIslandCount() const { return m_IslandStart.empty() ? 0 : m_IslandStart.size() - 1; }
+
+   /// @return Contacts of the last step, ordered by body pair.
+   const std::vector<Contact>& GetContacts() const { return m_Contacts; }
+
+private:
+   /// Velocity state of one island body while its island is solved.
+   struct SolverBody {
+      glm::vec2 LinearVelocity;
+      float AngularVelocity;
+      float InvMass;
+      float InvInertia;
+   };
+
+   struct SolverPoint {
+      glm::vec2 AnchorA, AnchorB;  ///< Contact point relative to each center of mass.
+      float NormalMass, TangentMass;
+      float Bias;                  ///< Target normal velocity: restitution, penetration recovery or speculative gap.
+      float NormalImpulse, TangentImpulse;
+   };
+
+   struct SolverContact {
+      uint32_t A, B;               ///< Indices into the island's SolverBody list.
+      glm::vec2 Normal;
+      float Friction;
+      int PointCount;
+      SolverPoint Points[2];
+      Contact* Source;             ///< Receives the accumulated impulses.
+   };
+
+   // Bodies: dense slots (structure of arrays), IDs map to slots
+   std::vector<uint32_t> m_IDs;       ///< Slot to ID.
+   std::vector<uint32_t> m_Slots;     ///< ID to slot, INVALID for free IDs.
+   std::vector<uint32_t> m_FreeIDs;
+
+   std::vector<BodyType> m_Type;
+   std::vector<Shape> m_Shape;
+   std::vector<glm::vec2> m_Position;
+   std::vector<float> m_Angle;
+   std::vector<glm::vec2> m_LinearVelocity;
+   std::vector<float> m_AngularVelocity;
+   std::vector<glm::vec2> m_Force;
+   std::vector<float> m_Torque;
+   std::vector<float> m_InvMass;
+   std::vector<float> m_InvInertia;
+   std::vector<float> m_Friction;
+   std::vector<float> m_Restitution;
+   std::vector<float> m_LinearDamping;
+   std::vector<float> m_AngularDamping;
+   std::vector<float> m_GravityScale;
+   std::vector<uint32_t> m_Category;
+   std::vector<uint32_t> m_Mask;
+   std::vector<uint32_t> m_UserData;
+   std::vector<uint32_t> m_Proxy;     ///< Broadphase proxy.
+   std::vector<float> m_SleepTime;    ///< Seconds the body has been nearly still.
+   std::vector<uint8_t> m_Awake;
+
+   // Contacts, sorted by (BodyA, BodyB), with an index to match them next step
+   Broadphase m_Broadphase;
+   std::vector<Contact> m_Contacts;
+   std::vector<Contact> m_NewContacts;   ///< One per broadphase pair while stepping.
+   std::vector<uint8_t> m_NewValid;
+   std::unordered_map<uint64_t, uint32_t> m_ContactIndex;
+
+   // Islands of awake dynamic bodies, as ranges into flat lists
+   std::vector<uint32_t> m_Parent;       ///< Union-find over slots.
+   std::vector<uint8_t> m_RootAwake;     ///< Per union-find root: some body of the island is awake.
+   std::vector<uint32_t> m_IslandOf;     ///< Slot to island, INVALID for none.
+   std::vector<uint32_t> m_LocalIndex;   ///< Slot to its index in its island's solver bodies.
+   std::vector<uint32_t> m_IslandStart;  ///< Island i owns m_IslandBodies[m_IslandStart[i], m_IslandStart[i + 1]).
+   std::vector<uint32_t> m_IslandBodies;
+   std::vector<uint32_t> m_ContactStart; ///< Same for m_IslandContacts.
+   std::vector<uint32_t> m_IslandContacts;
+
+   glm::vec2 m_Gravity = {0.0f, 980.0f};
+   int m_Iterations = 8;
+   bool m_Sleeping = true;
+   float m_StepTime = 0.0f;              ///< Last step length, for swept bounds and speculative margins.
+
+   void UpdateProxy(uint32_t Slot);
+   void FindContacts();
+   void BuildIslands();
+   void SolveIsland(uint32_t Island, float dt);
+   void WakeSlot(uint32_t Slot);
+   uint32_t FindRoot(uint32_t Slot);
+
+   static uint64_t PairKey(uint32_t A, uint32_t B) { return (uint64_t(A) << 32) | B; }
+};
+
+} // namespace Echo2D
+
+#endif // PHYSICS_H
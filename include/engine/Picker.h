@@ -0,0 +1,112 @@
+#ifndef PICKER_H
+#define PICKER_H
+
+#include "engine/Broadphase.h"
+#include "engine/World.h"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @struct PickHit
+ * @brief An entity found by a Picker query.
+ */
+struct PickHit {
+   Entity Target;
+   float Depth = 0.0f;    ///< Pickable::Depth of the entity.
+   float Distance = 0.0f; ///< Along the ray for QueryRay(), else 0.
+};
+
+/**
+ * @class Picker
+ * @brief Spatial index of the pickable sprites of a World, for mouse picking and area selection.
+ *
+ * Update() mirrors every entity with a Transform, a Sprite and a Pickable
+ * component into a Broadphase grid, as the rotated rect Renderer::DrawWorld()
+ * draws. Queries then only test the entities in the grid cells they touch,
+ * so a click costs the same in a scene of ten sprites or a hundred thousand.
+ * Hits are tested exactly against the rotated rects, filtered by layer and
+ * sorted front to back.
+ *
+ * World positions come from Camera2D::ScreenToWorld(), e.g. for a click:
+ *
+ *   Picks.Update(GetWorld(), GetInterpolationAlpha());
+ *   Entity Clicked = Picks.Pick(Camera.ScreenToWorld({MouseListener::GetX(), MouseListener::GetY()}));
+ *
+ * Like the Broadphase it uses, a Picker is not thread safe.
+ */
+class Picker {
+public:
+   /// Layer mask accepting every layer.
+   static constexpr uint32_t ALL_LAYERS = UINT32_MAX;
+
+   /// @param CellSize Grid cell edge in world units; about the size of a typical sprite.
+   explicit Picker(float CellSize = 64.0f);
+
+   /**
+     * @brief Brings the index up to date with the world's pickable entities.
+     *
+     * Call it after entities moved and before querying, e.g. once per frame.
+     * Entities that stayed within their grid cells cost a bounds update.
+     *
+     * @param Alpha Blend between an entity's Interpolation and its Transform,
+     *        as passed to Renderer::DrawWorld(); use Application::GetInterpolationAlpha()
+     *        so picks match what is on screen.
+     */
+   void Update(World& Entities, float Alpha = 1.0f);
+
+   /// Forgets every entity.
+   void Clear();
+
+   /**
+     * @brief Appends the entities whose rect contains a world point, front first.
+     * @param LayerMask Only entities on one of these layers are reported.
+     */
+   void QueryPoint(glm::vec2 Point, std::vector<PickHit>& Out, uint32_t LayerMask = ALL_LAYERS);
+
+   /// Appends the entities whose rect overlaps a world region, front first.
+   void QueryRect(const AABB& Region, std::vector<PickHit>& Out, uint32_t LayerMask = ALL_LAYERS);
+
+   /**
+     * @brief Appends the entities a ray segment crosses, nearest first (equal distances front first).
+     * @param Direction Need not be normalized; Distance is measured in world units along it.
+     */
+   void QueryRay(glm::vec2 Origin, glm::vec2 Direction, float MaxDistance, std::vector<PickHit>& Out,
+                 uint32_t LayerMask = ALL_LAYERS);
+
+   /// @return The front-most entity at a world point, or an invalid Entity if there is none.
+   Entity Pick(glm::vec2 Point, uint32_t LayerMask = ALL_LAYERS);
+
+   /// @return Number of indexed entities.
+   size_t GetCount() const { return m_Index.GetProxyCount(); }
+
+private:
+   Broadphase m_Index;
+
+   // Per proxy: the entity's rect as drawn, and what queries sort and filter by
+   std::vector<Entity> m_Entities;
+   std::vector<glm::vec2> m_Centers;
+   std::vector<glm::vec2> m_HalfSizes;
+   std::vector<glm::vec2> m_Axes;       ///< (cos, sin) of the rect's rotation.
+   std::vector<float> m_Depths;
+   std::vector<uint32_t> m_Layers;
+   std::vector<uint32_t> m_DrawOrder;   ///< Position in the last Update(); later entities are drawn on top.
+   std::vector<uint32_t> m_Seen;        ///< Last Update() that found the entity.
+
+   std::vector<uint32_t> m_ProxyOf;     ///< Entity index to proxy, Broadphase::INVALID for none.
+   uint32_t m_Update = 0;
+
+   std::vector<uint32_t> m_Candidates;
+   std::vector<RayHit> m_RayHits;
+   std::vector<PickHit> m_Scratch;
+
+   void Sort(std::vector<PickHit>::iterator First, std::vector<PickHit>::iterator Last, bool ByDistance) const;
+   uint32_t ProxyOf(Entity Target) const;
+};
+
+} // namespace Echo2D
+
+#endif // PICKER_H
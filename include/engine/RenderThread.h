@@ -0,0 +1,144 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include "core/core.h"
+#include "engine/FramePacer.h"
+#include "utils/ShaderUtils.h"
+#include "utils/Utils.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ImDrawList;
+
+namespace Echo2D {
+
+/**
+ * @struct DrawBatch
+ * @brief One recorded Renderer::Flush(): ranges into the packet's arrays plus the shader state to draw them with.
+ */
+struct DrawBatch {
+   uint32_t FirstVertex = 0;
+   uint32_t VertexCount = 0;
+   uint32_t FirstIndex = 0;
+   uint32_t IndexCount = 0;   ///< Indices are relative to FirstVertex, as in the live batch.
+   uint32_t FirstTexture = 0;
+   uint32_t TextureCount = 0; ///< Textures bound to units 0..TextureCount-1.
+   GLuint Program = 0;
+   glm::mat4 Projection = glm::mat4(1.0f);
+   glm::mat4 View = glm::mat4(1.0f);
+   glm::mat4 Model = glm::mat4(1.0f);
+};
+
+/**
+ * @struct FramePacket
+ * @brief Everything the render thread needs to submit one frame.
+ *
+ * Packets are reused frame after frame and only ever cleared, so once their
+ * arrays have grown to a typical frame recording allocates nothing.
+ */
+struct FramePacket {
+   std::vector<Utils::Vertex> Vertices;
+   std::vector<GLuint> Indices;
+   std::vector<GLuint> Textures;        ///< Texture IDs referenced by Batches.
+   std::vector<DrawBatch> Batches;
+   std::vector<GLuint> DeletedTextures; ///< Deleted once the frame is submitted, as they may still be drawn.
+   glm::vec4 ClearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+   double InputTime = 0.0;              ///< FramePacer::Now() when the frame's input was polled.
+
+   // ImGui draw data copied out of the ImGui context
+   std::vector<ImDrawList*> UiLists;    ///< Pool; the first UiListCount are this frame's.
+   int UiListCount = 0;
+   glm::vec2 UiDisplayPos = {0.0f, 0.0f};
+   glm::vec2 UiDisplaySize = {0.0f, 0.0f};
+   glm::vec2 UiFramebufferScale = {1.0f, 1.0f};
+
+   void Clear();
+};
+
+/**
+ * @class RenderThread
+ * @brief Optional pipelined mode: GL submission moves to its own thread, one frame behind the main thread.
+ *
+ * While it runs, the Renderer records batches into a FramePacket instead of
+ * drawing; Submit() hands the packet over at the end of the frame and the
+ * render thread, which owns the window's GL context, draws it, renders ImGui
+ * and swaps while the main thread builds the next frame. Two packets
+ * alternate, so the main thread only waits when it gets a whole frame ahead.
+ *
+ * The main thread keeps a hidden context sharing objects with the window's,
+ * so texture uploads, font atlas updates and shader reloads work unchanged;
+ * Submit() fences them before the render thread draws. Textures must be
+ * deleted through ReleaseTexture() since the render thread may still draw
+ * them.
+ */
+class RenderThread : public Utils::Singleton<RenderThread> {
+   friend class Utils::Singleton<RenderThread>;
+
+public:
+   /**
+     * @brief Moves the window's context to a new render thread. Must be called on the main thread.
+     * @param Window Window whose context is current on the calling thread.
+     */
+   static void Start(GLFWwindow* Window);
+
+   /// Draws the last submitted packet, stops the thread and makes the window's context current again.
+   static void Stop();
+
+   /// @return Whether the render thread is running.
+   static bool IsActive();
+
+   /// @return The packet the main thread is recording into.
+   static FramePacket& GetPacket();
+
+   /// Copies the ImGui draw data of this frame (after ImGui::Render()) into the packet.
+   static void CaptureImGui();
+
+   /// Hands the recorded packet to the render thread, waiting if it is still drawing the previous one.
+   static void Submit();
+
+   /// Deletes a texture, after in-flight frames are drawn when the render thread is running.
+   static void ReleaseTexture(GLuint ID);
+
+   /// @return Seconds the render thread took for its last frame, swap included.
+   static double GetSubmitTime();
+
+   /// @return Seconds from the last drawn frame's input poll until its swap returned.
+   static double GetLatency();
+
+   /// Sets the swap interval from the render thread, which owns the context, before its next swap.
+   static void SetSwapInterval(int Interval);
+
+private:
+   GLFWwindow* m_Window = nullptr;
+   GLFWwindow* m_Loader = nullptr;  ///< Hidden window holding the main thread's shared context.
+   std::thread m_Thread;
+   bool m_Active = false;
+
+   FramePacket m_Packets[2];
+   int m_Recording = 0;             ///< Packet the main thread records into.
+
+   std::mutex m_Mutex;
+   std::condition_variable m_Wake;
+   bool m_HasWork = false;          ///< The other packet is waiting for or being drawn (guarded by m_Mutex).
+   bool m_Stopping = false;
+   GLsync m_Fence = nullptr;        ///< Uploads the submitted packet depends on.
+   double m_SubmitTime = 0.0;
+   double m_Latency = 0.0;
+   static constexpr int NO_INTERVAL = INT32_MIN;
+   std::atomic<int> m_SwapInterval = NO_INTERVAL; ///< Pending swap interval for the render thread.
+
+   void RenderLoop();
+   void Draw(FramePacket& Packet, GLuint VAO, GLuint VBO, GLuint EBO);
+
+   RenderThread() = default;
+   ~RenderThread();
+};
+
+} // namespace Echo2D
+
+#endif // RENDERTHREAD_H
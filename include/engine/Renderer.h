@@ -7,12 +7,15 @@
 #include "engine/Texture.h"
 #include "engine/Colors.h"
 #include "engine/Font.h"
+#include "engine/TextLayout.h"
 #include "utils/ShaderUtils.h"
 #include "utils/Utils.h"
 #include <vector>
 
 namespace Echo2D {
 
+class World;
+
 /**
  * @struct BatchRendererData
  * @brief Tracks high-level renderer stats like draw call count.
@@ -32,6 +35,7 @@ extern BatchRendererData g_BatchData;
  */
 class Renderer : public Utils::Singleton<Renderer> {
    friend class Utils::Singleton<Renderer>;
+   friend class RenderThread;
 
 public:
    // === Initialization & Finalization ===
@@ -51,6 +55,9 @@ public:
    /// Sends all buffered draw calls to the GPU.
    static void Flush();
 
+   /// Submits buffered geometry now, before a texture it may sample is modified.
+   static void FlushPending();
+
    // === Primitive Drawing ===
 
    /// Draws a filled circle.
@@ -62,6 +69,9 @@ public:
    /// Draws a filled triangle.
    static void DrawTriangle(glm::vec2 V0, glm::vec2 V1, glm::vec2 V2, glm::vec4 Color);
 
+   /// Draws a line segment as a quad Thickness pixels wide.
+   static void DrawLine(glm::vec2 Start, glm::vec2 End, float Thickness, glm::vec4 Color);
+
    // === Textured Primitives ===
 
    /// Draws a textured rectangle.
@@ -78,11 +88,32 @@ public:
    /// Draw a rect from a spritesheet
    static void DrawRectSprite(glm::vec2 Dimensions, glm::vec2 Center, Spritesheet &Sprites, int i, int j, glm::vec4 Tint = WHITE);
 
+   /// Draws a rect sampling the (u, v, width, height) region of a texture.
+   static void DrawRectRegion(glm::vec2 Dimensions, glm::vec2 Center, Texture& Tex, glm::vec4 Region, glm::vec4 Tint = WHITE);
+
+   /// Draws frame Frame of a spritesheet; trimmed frames only cover their opaque part of the rect.
+   static void DrawSpriteFrame(glm::vec2 Dimensions, glm::vec2 Center, Spritesheet &Sprites, int Frame, glm::vec4 Tint = WHITE);
+
+   /// Draws a precomputed spritesheet frame of a texture.
+   static void DrawSpriteFrame(glm::vec2 Dimensions, glm::vec2 Center, Texture& Tex, const SpriteFrame& Frame, glm::vec4 Tint = WHITE);
+
+   /// Draws a rect showing the current frame of an Animator instance; nothing if it has no texture.
+   static void DrawAnimation(glm::vec2 Dimensions, glm::vec2 Center, uint32_t Instance, glm::vec4 Tint = WHITE);
+
+   /**
+     * @brief Draws every entity with a Transform and a Sprite (animated ones at their current frame), chunk by chunk.
+     * @param Alpha Progress between the last two fixed ticks, for entities with an Interpolation component.
+     */
+   static void DrawWorld(World& Entities, float Alpha = 1.0f);
+
    // === Text Rendering ===
 
-   /// Renders a string of text at the specified position.
+   /// Renders a UTF-8 string of text at the specified position (shaped through TextLayoutCache).
    static void DrawText(const std::string& text, glm::vec2 position, Font& font, glm::vec4 color, float scale = 1.0f);
 
+   /// Renders a pre-shaped text layout with its origin (first baseline) at Position.
+   static void DrawTextLayout(TextLayout& Layout, glm::vec2 Position, glm::vec4 Color = WHITE);
+
 private:
    // === OpenGL Buffer Objects ===
    GLuint m_VAO = 0;
@@ -99,6 +130,7 @@ private:
    std::vector<Texture*> m_Textures;        ///< Currently bound textures.
 
    Utils::Shader* m_Shader = nullptr;       ///< Active rendering shader.
+   uint32_t m_ShaderGeneration = 0;         ///< Shader generation the sampler uniforms were set on.
 
 
    // === Matrices ===
@@ -117,6 +149,19 @@ private:
      */
    static void CheckAndFlush(const GLuint& VertexCount);
 
+   /**
+     * @brief Creates a vertex array with the batch vertex layout on the current context.
+     * @param VBOSize Initial vertex buffer size in bytes.
+     * @param EBOSize Initial index buffer size in bytes.
+     */
+   static void CreateVertexArray(GLuint& VAO, GLuint& VBO, GLuint& EBO, GLuint VBOSize, GLuint EBOSize);
+
+   /// Copies the current batch into the RenderThread packet instead of drawing it.
+   void RecordBatch();
+
+   /// Appends one textured quad (corners clockwise from top-left) to the batch.
+   static void PushQuad(const glm::vec2 Positions[4], const glm::vec2 UVs[4], Texture& Tex, glm::vec4 Tint);
+
    /**
      * @brief Finds the texture slot index of a texture, or -1 if not bound.
      */
@@ -127,6 +172,11 @@ private:
      */
    static void AddTexture(Texture& Texture);
 
+   /**
+     * @brief Points the shader's sampler array at texture units 0..N-1.
+     */
+   void SetSamplerUniforms();
+
    Renderer();
    ~Renderer();
 };
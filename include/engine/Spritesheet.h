@@ -1,18 +1,70 @@
 #ifndef SPRITESHEET_H
 #define SPRITESHEET_H
 
+#include <engine/AssetHandle.h>
 #include <engine/Texture.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Echo2D {
 
+/**
+ * @struct SpriteFrame
+ * @brief Precomputed placement of one frame of a spritesheet.
+ *
+ * Frames from packed atlases may be trimmed (transparent borders cut away) and
+ * rotated by 90 degrees; Offset and Size place the trimmed image inside the
+ * untrimmed frame so sprites keep their pivot, and UV maps the quad corners
+ * back to the unrotated image.
+ */
+struct SpriteFrame {
+   glm::vec2 UV[4];           ///< Texture coordinates of the top-left, top-right, bottom-right and bottom-left corners.
+   glm::vec4 Bounds;          ///< (u, v, width, height) of the frame's region in the texture.
+   glm::vec2 Offset = {0, 0}; ///< Top-left of the trimmed image, as a fraction of the untrimmed frame size.
+   glm::vec2 Size = {1, 1};   ///< Size of the trimmed image, as a fraction of the untrimmed frame size.
+   float Duration = 0.1f;     ///< Seconds the frame is shown when animated with the sheet's timing.
+
+   /// @return An untrimmed, unrotated frame showing the (u, v, width, height) region.
+   static SpriteFrame FromRegion(glm::vec4 Region) {
+      SpriteFrame Frame;
+      Frame.Bounds = Region;
+      Frame.UV[0] = {Region.x, Region.y};
+      Frame.UV[1] = {Region.x + Region.z, Region.y};
+      Frame.UV[2] = {Region.x + Region.z, Region.y + Region.w};
+      Frame.UV[3] = {Region.x, Region.y + Region.w};
+      return Frame;
+   }
+};
+
+/**
+ * @enum TagDirection
+ * @brief Playback direction of a tagged frame range.
+ */
+enum class TagDirection { Forward, Reverse, PingPong };
+
+/**
+ * @struct SpriteTag
+ * @brief A named range of frames (an Aseprite frame tag).
+ */
+struct SpriteTag {
+   std::string Name;
+   int From = 0; ///< First frame index, inclusive.
+   int To = 0;   ///< Last frame index, inclusive.
+   TagDirection Direction = TagDirection::Forward;
+};
+
 /**
  * @class Spritesheet
  * @brief Manages a texture containing a grid of sprites, and provides access to their texture coordinates.
  *
  * This class simplifies the process of retrieving UV coordinates for individual sprite tiles
- * within a larger spritesheet texture, based on a fixed tile size.
+ * within a larger spritesheet texture, either based on a fixed tile size or
+ * read from the JSON metadata TexturePacker and Aseprite export next to packed
+ * atlases. Both build the same frame table once, so looking a frame up is an
+ * index. The texture comes from AssetCache, so sheets cut from the same image
+ * share one upload. Sheets hold no playback state; animate them with Animator clips.
  */
 class Spritesheet {
 public:
@@ -22,42 +74,70 @@ public:
      * @param SpriteWidth Width of a single sprite in pixels.
      * @param SpriteHeight Height of a single sprite in pixels.
      */
-   Spritesheet(std::string Filepath, int SpriteWidth, int SpriteHeight, float FrameInterval, int SpriteAmount);
+   Spritesheet(std::string Filepath, int SpriteWidth, int SpriteHeight);
+
+   /**
+     * @brief Constructs a Spritesheet from TexturePacker or Aseprite JSON metadata.
+     *
+     * Both the hash and array layouts of "frames" are read, including trimmed
+     * and rotated frames, Aseprite frame durations and frame tags. The image is
+     * meta.image, relative to the metadata file. If the metadata cannot be read,
+     * the image next to it with a .png extension is used as a single frame.
+     *
+     * @param MetadataPath Path to the .json file.
+     */
+   explicit Spritesheet(const std::string& MetadataPath);
 
    /**
-     * @brief Destructor that releases texture resources.
+     * @brief Destructor that releases this sheet's reference to the texture.
      */
    ~Spritesheet();
 
    /**
      * @brief Retrieves the normalized texture coordinates for a sprite at grid position (i, j).
+     *
+     * Sheets loaded from metadata have no grid: i is the frame index and j is ignored.
      * @param i Column index of the sprite (0-based).
      * @param j Row index of the sprite (0-based).
      * @return A glm::vec4 representing (u, v, width, height) in normalized texture space.
      */
    glm::vec4 GetTexCoords(int i, int j);
 
+   /// @return Number of frames (grid cells, row by row, or atlas frames in file order).
+   int GetFrameCount() const;
+
+   /// @return Frame Index, which must be below GetFrameCount().
+   const SpriteFrame& GetFrame(int Index) const;
+
+   /// @return Index of the frame with the given file name in the metadata, or -1.
+   int FindFrame(const std::string& Name) const;
+
+   /// @return The frame tag called Name, or nullptr.
+   const SpriteTag* FindTag(const std::string& Name) const;
+
+   /// @return Every frame tag, in file order.
+   const std::vector<SpriteTag>& GetTags() const;
+
    /**
      * @brief Gets the texture used by this spritesheet.
      * @return A reference to the underlying Texture object.
      */
    Texture& GetTex();
 
-   void SpriteUpdate(float dt);
-
-   int GetCount();
 private:
-   Texture *m_TextureMap;        /**< Pointer to the texture representing the full spritesheet. */
+   TextureHandle m_TextureMap;   /**< Shared texture representing the full spritesheet. */
    float m_SpriteWidthRatio;     /**< Width of a single sprite in normalized texture coordinates. */
    float m_SpriteHeightRatio;    /**< Height of a single sprite in normalized texture coordinates. */
    float m_TexCoordsOriginX;     /**< X origin of the current sprite in normalized coordinates (unused in final version). */
    float m_TexCoordsOriginY;     /**< Y origin of the current sprite in normalized coordinates (unused in final version). */
    float m_TexCoordsWidth;       /**< Width in normalized coordinates (unused in final version). */
    float m_TexCoordsHeight;      /**< Height in normalized coordinates (unused in final version). */
-   float m_FrameInterval = 0.1f;
-   float m_Timer = 0.0f;
-   int m_Count = 0;
-   int m_SpriteAmount = 0;
+   int m_Columns = 0;            /**< Grid columns (0 for atlases). */
+   std::vector<SpriteFrame> m_Frames;                  /**< Frame table, contiguous for lookups while drawing. */
+   std::unordered_map<std::string, int> m_FrameNames;  /**< Metadata file name -> frame index. */
+   std::vector<SpriteTag> m_Tags;
+
+   bool LoadMetadata(const std::string& MetadataPath);
 };
 
 } // namespace Echo2D
@@ -0,0 +1,180 @@
+#ifndef TEXTLAYOUT_H
+#define TEXTLAYOUT_H
+
+#include "core/core.h"
+#include "engine/Font.h"
+#include "utils/ShaderUtils.h"
+#include "utils/Utils.h"
+#include <glm/glm.hpp>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @enum TextAlign
+ * @brief Horizontal alignment of each line inside a TextLayout.
+ */
+enum class TextAlign {
+   Left,   ///< Lines start at the layout origin.
+   Center, ///< Lines are centered in the layout width.
+   Right   ///< Lines end at the layout width.
+};
+
+/**
+ * @class TextLayout
+ * @brief A string shaped once into positioned glyph quads.
+ *
+ * Building a layout resolves every glyph, applies kerning, breaks lines on
+ * '\n' and (optionally) at spaces to fit a maximum width, and aligns each
+ * line. The result is a vertex array relative to the layout origin, where
+ * the origin is the baseline of the first line, like Renderer::DrawText.
+ *
+ * Drawing re-bakes the vertices only when the position, color or batch
+ * texture slot changes; otherwise the renderer copies them straight into the
+ * batch. A layout rebuilds itself if its font evicted an atlas page since it
+ * was shaped. The font must outlive the layout.
+ */
+class TextLayout {
+public:
+   /**
+     * @brief Shapes a UTF-8 string.
+     * @param Font Font to shape with.
+     * @param Text UTF-8 encoded text.
+     * @param Scale Scale applied to the font's pixel size (default: 1).
+     * @param MaxWidth Wrap width in scaled pixels; 0 disables wrapping.
+     * @param Align Horizontal alignment of each line.
+     */
+   TextLayout(Font& Font, const std::string& Text, float Scale = 1.0f, float MaxWidth = 0.0f,
+              TextAlign Align = TextAlign::Left);
+
+   /// @return Width and height of the laid out text in pixels.
+   glm::vec2 GetSize() const;
+
+   /// @return Number of glyph quads in the layout.
+   size_t GetQuadCount() const;
+
+   /// @return The font this layout was shaped with.
+   const Font& GetFont() const;
+
+private:
+   friend class Renderer;
+
+   /**
+     * @struct Run
+     * @brief Consecutive quads that sample the same atlas page.
+     */
+   struct Run {
+      Texture* Atlas;         ///< Atlas page sampled by the run.
+      int Page;               ///< Index of that page in the font, touched whenever the run is drawn.
+      size_t FirstQuad;       ///< Index of the first quad of the run.
+      size_t QuadCount;       ///< Number of quads in the run.
+      float BakedIndex = -2.0f; ///< Texture slot baked into m_Baked (-2: not baked).
+   };
+
+   Font* m_Font;
+   std::string m_Text;
+   float m_Scale;
+   float m_MaxWidth;
+   TextAlign m_Align;
+   float m_DistanceField = 0.0f;  ///< 1.0 for SDF fonts.
+   uint64_t m_Generation = 0;     ///< Font generation the glyph UVs were taken from.
+   glm::vec2 m_Size = {0.0f, 0.0f};
+
+   std::vector<Utils::Vertex> m_Local; ///< Quads relative to the origin (4 vertices each).
+   std::vector<Utils::Vertex> m_Baked; ///< m_Local translated, tinted and slot-indexed for the batch.
+   std::vector<Run> m_Runs;
+
+   glm::vec2 m_BakedPosition = {0.0f, 0.0f};
+   glm::vec4 m_BakedColor = {-1.0f, -1.0f, -1.0f, -1.0f};
+
+   /// Resolves glyphs and fills m_Local and m_Runs.
+   void Build();
+
+   /**
+     * @brief Makes sure m_Baked matches the given draw parameters for one run.
+     * @return Pointer to the first baked vertex of the run.
+     */
+   const Utils::Vertex* Bake(size_t RunIndex, glm::vec2 Position, glm::vec4 Color, float TextureIndex);
+
+   /// Rebuilds the layout if the font evicted atlas pages since it was shaped.
+   void Refresh();
+};
+
+/**
+ * @class TextLayoutCache
+ * @brief LRU cache of TextLayouts keyed by (font, string, scale, wrap width, alignment).
+ *
+ * Renderer::DrawText goes through this cache, so static labels are shaped
+ * once and slowly changing strings are only reshaped when they change.
+ */
+class TextLayoutCache : public Utils::Singleton<TextLayoutCache> {
+   friend class Utils::Singleton<TextLayoutCache>;
+
+public:
+   /**
+     * @brief Returns the cached layout for the arguments, shaping it on a miss.
+     *
+     * The reference is valid until the entry is evicted, i.e. at least until
+     * the next MAX_ENTRIES distinct strings have been requested.
+     */
+   static TextLayout& Get(Font& Font, const std::string& Text, float Scale = 1.0f,
+                          float MaxWidth = 0.0f, TextAlign Align = TextAlign::Left);
+
+   /// Drops every cached layout.
+   static void Clear();
+
+   /// Maximum number of layouts kept before the least recently used one is dropped.
+   static constexpr size_t MAX_ENTRIES = 512;
+
+private:
+   /// Non-owning form of Key, so lookups do not copy the string.
+   struct KeyView {
+      uint64_t FontID;
+      float Scale;
+      float MaxWidth;
+      TextAlign Align;
+      std::string_view Text;
+
+      bool operator==(const KeyView& Other) const = default;
+   };
+
+   struct Key {
+      uint64_t FontID;
+      float Scale;
+      float MaxWidth;
+      TextAlign Align;
+      std::string Text;
+
+      operator KeyView() const { return {FontID, Scale, MaxWidth, Align, Text}; }
+   };
+
+   // Transparent, so m_Index can be searched with a KeyView
+   struct KeyHash {
+      using is_transparent = void;
+      size_t operator()(const KeyView& K) const;
+   };
+
+   struct KeyEqual {
+      using is_transparent = void;
+      bool operator()(const KeyView& A, const KeyView& B) const { return A == B; }
+   };
+
+   struct Entry {
+      Key EntryKey;
+      TextLayout Layout;
+   };
+
+   std::list<Entry> m_Entries; ///< Most recently used first.
+   std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEqual> m_Index;
+
+   TextLayoutCache() = default;
+   ~TextLayoutCache() = default;
+};
+
+} // namespace Echo2D
+
+#endif // TEXTLAYOUT_H
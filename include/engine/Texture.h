@@ -3,6 +3,8 @@
 
 #include <core/core.h>
 #include <external/stb_image.h>
+#include <cstdint>
+#include <string>
 
 namespace Echo2D {
 
@@ -11,6 +13,8 @@ namespace Echo2D {
  * @brief Manages 2D textures loaded from image files.
  *
  * Loads image data using stb_image and uploads it to the GPU as an OpenGL texture.
+ * Textures loaded from a file are tracked by TextureResidency, which may free
+ * their GPU storage when they go unused and reload them on the next draw.
  */
 class Texture {
 public:
@@ -20,7 +24,15 @@ public:
      */
    Texture(const char* FilePath);
 
-   Texture(int width, int height, unsigned char* data); // For glyph textures
+   /**
+     * @brief Constructs a single-channel texture from raw 8-bit pixels (used for glyphs).
+     * @param width Width in pixels.
+     * @param height Height in pixels.
+     * @param data Tightly packed 8-bit pixel rows.
+     * @param filter Min/mag filter (GL_LINEAR for distance fields, default: GL_NEAREST).
+     */
+   Texture(int width, int height, unsigned char* data, GLint filter = GL_NEAREST);
+
    /// Destructor: cleans up GPU resources.
    ~Texture();
 
@@ -36,7 +48,18 @@ public:
      */
    void Unbind(GLuint slot = 0) const;
 
-   /// @return OpenGL texture ID.
+   /**
+     * @brief Replaces a rectangle of texels with new pixel data.
+     * @param x Left edge of the rectangle in pixels.
+     * @param y Top edge of the rectangle in pixels.
+     * @param width Width of the rectangle in pixels.
+     * @param height Height of the rectangle in pixels.
+     * @param data First pixel of the rectangle, in the texture's own channel layout.
+     * @param rowLength Pixels per row of the source buffer (0: rows are tightly packed).
+     */
+   void Update(int x, int y, int width, int height, const unsigned char* data, int rowLength = 0);
+
+   /// @return OpenGL texture ID (0 while evicted by TextureResidency).
    GLuint GetID() const;
 
    /// @return Width in pixels.
@@ -45,11 +68,36 @@ public:
    /// @return Height in pixels.
    int GetHeight() const;
 
+   /**
+     * @brief Whether the image data is on the GPU.
+     *
+     * Always true for synchronously constructed textures. Textures created by
+     * TextureLoader::Load() show a 1x1 placeholder (and report 1x1) until the
+     * loader uploads the decoded image.
+     */
+   bool IsReady() const;
+
 private:
+   friend class TextureLoader;
+   friend class TextureResidency;
+
+   /// Empty texture, filled in by TextureLoader.
+   Texture() = default;
+
+   /// Reloads the texture through TextureLoader whenever its source file changes.
+   void WatchSource();
+
    GLuint m_ID = 0;      ///< OpenGL texture object ID.
    int m_Width = 0;      ///< Texture width.
    int m_Height = 0;     ///< Texture height.
    int m_Bits = 0;       ///< Number of channels (RGB = 3, RGBA = 4).
+   GLenum m_Format = GL_RGBA; ///< Pixel layout of uploads (GL_RGBA, or GL_RED for glyph textures).
+   bool m_Ready = true;  ///< False while an asynchronous load is pending.
+   uint64_t m_LoadID = 0; ///< TextureLoader request ID while pending.
+   std::string m_SourcePath;    ///< Image file the texture can be reloaded from (empty: not evictable).
+   size_t m_Bytes = 0;          ///< GPU bytes accounted to TextureResidency.
+   uint64_t m_LastUsedFrame = 0; ///< Frame the renderer last batched the texture in.
+   uint64_t m_WatchID = 0;       ///< AssetWatcher registration of the source file, 0 if not watched.
 };
 
 } // namespace Echo2D
@@ -0,0 +1,145 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include "core/core.h"
+#include "engine/JobSystem.h"
+#include "engine/Texture.h"
+#include "utils/Utils.h"
+#include <cstdint>
+#include <deque>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @class TextureLoader
+ * @brief Loads textures in the background so level transitions never stall the frame loop.
+ *
+ * Load() returns a texture immediately that shows a 1x1 placeholder color.
+ * Image files are decoded by stb_image in JobSystem jobs (or, when a
+ * mounted AssetArchive holds them, taken from its mapping); the decoded
+ * pixels are then uploaded on the GL thread through a pixel buffer object by
+ * Update(), which Application calls at the start of every frame and which
+ * stops once the per-frame upload budget is spent.
+ *
+ * Textures from Load() are owned by the caller like any other texture and may
+ * be deleted before they finish loading.
+ */
+class TextureLoader : public Utils::Singleton<TextureLoader> {
+   friend class Utils::Singleton<TextureLoader>;
+
+public:
+   /**
+     * @brief Starts loading an image file in the background. Must be called on the GL thread.
+     * @param FilePath Path to the image file (PNG, JPEG, etc.).
+     * @return A new texture showing the placeholder until the image is uploaded.
+     */
+   static Texture* Load(const char* FilePath);
+
+   /**
+     * @brief Uploads decoded images until the time budget is spent.
+     *
+     * At least one image is uploaded per call so loading always progresses.
+     * Called by Application::Run each frame; call it yourself with a large
+     * budget to drain the queue behind a loading screen.
+     *
+     * @param BudgetSeconds Upload time allowed for this call.
+     */
+   static void Update(double BudgetSeconds);
+
+   /// Uploads with the budget set by SetUploadBudget().
+   static void Update();
+
+   /**
+     * @brief Sets the per-frame upload budget used by Application.
+     * @param Seconds Upload time per frame (default: DEFAULT_UPLOAD_BUDGET).
+     */
+   static void SetUploadBudget(double Seconds);
+
+   /**
+     * @brief Sets the color pending textures show, in 0-255 like renderer colors.
+     *
+     * Affects textures loaded afterwards (default: fully transparent).
+     */
+   static void SetPlaceholderColor(glm::vec4 Color);
+
+   /**
+     * @brief Frees a loaded texture's GPU storage and streams it back in from its source file.
+     *
+     * The texture shows the placeholder again until the new upload completes.
+     * Used by TextureResidency to restore evicted textures; does nothing for
+     * textures without a source file or with a load already pending.
+     */
+   static void Reload(Texture& Tex);
+
+   /**
+     * @brief Decodes a loaded texture's source file again and uploads it over the current image.
+     *
+     * Unlike Reload() the texture keeps showing its current image until the
+     * new one is uploaded, and keeps it if decoding fails. Used by AssetWatcher
+     * when the file changes on disk; does nothing while a load is pending.
+     */
+   static void Refresh(Texture& Tex);
+
+   /// @return Number of textures still waiting to be decoded or uploaded.
+   static size_t GetPendingCount();
+
+   /// Forgets a pending request; called by the texture's destructor.
+   static void Cancel(Texture& Tex);
+
+   /// Waits for running decode jobs and releases GL objects. Must run before the GL context is destroyed.
+   static void Shutdown();
+
+   /// Default per-frame upload budget (2 ms).
+   static constexpr double DEFAULT_UPLOAD_BUDGET = 0.002;
+
+   /// Upper bound on decode jobs running at once, so loading never occupies the whole job pool.
+   static constexpr unsigned MAX_DECODE_JOBS = 4;
+
+private:
+   struct Request {
+      uint64_t ID;
+      std::string FilePath;
+   };
+
+   struct Decoded {
+      uint64_t ID;
+      std::string FilePath;
+      const unsigned char* Pixels;        ///< RGBA8 pixels, nullptr if decoding failed.
+      unsigned char* Owned;               ///< stb_image allocation backing Pixels, if any.
+      std::vector<unsigned char> Scratch; ///< Decompressed archive entry backing Pixels, if any.
+      int Width;
+      int Height;
+   };
+
+   std::mutex m_Mutex;
+   std::deque<Request> m_Requests;  ///< Waiting for a decode job (guarded by m_Mutex).
+   std::deque<Decoded> m_Decoded;   ///< Waiting for upload (guarded by m_Mutex).
+   unsigned m_ActiveJobs = 0;       ///< Decode jobs draining m_Requests (guarded by m_Mutex).
+   JobCounter m_DecodeJobs;
+
+   // GL thread only
+   std::unordered_map<uint64_t, Texture*> m_Pending; ///< Requests whose texture still exists.
+   uint64_t m_NextID = 1;
+   GLuint m_PBO = 0;
+   size_t m_PBOSize = 0;
+   double m_UploadBudget = DEFAULT_UPLOAD_BUDGET;
+   unsigned char m_Placeholder[4] = {0, 0, 0, 0};
+
+   void Enqueue(Texture& Tex);
+   void Queue(Texture& Tex);
+   void StopDecoding();
+   void DecodeJob();
+   void Upload(Texture& Tex, const Decoded& Image);
+
+   TextureLoader() = default;
+   ~TextureLoader();
+};
+
+} // namespace Echo2D
+
+#endif // TEXTURELOADER_H
@@ -0,0 +1,84 @@
+#ifndef TEXTURERESIDENCY_H
+#define TEXTURERESIDENCY_H
+
+#include "core/core.h"
+#include "engine/Texture.h"
+#include "utils/Utils.h"
+#include <cstdint>
+#include <unordered_set>
+
+namespace Echo2D {
+
+/**
+ * @class TextureResidency
+ * @brief Keeps the GPU memory used by textures under a budget.
+ *
+ * Every texture reports its GPU bytes here when its storage is uploaded.
+ * Renderer::AddTexture stamps the current frame on each texture it batches;
+ * at the end of a frame, if the resident total exceeds the budget, the least
+ * recently drawn file-backed textures have their storage freed. An evicted
+ * texture keeps its object and is streamed back in through TextureLoader the
+ * next time it is drawn, showing the loader placeholder until then.
+ *
+ * Glyph atlas pages and other textures without a source file count towards
+ * the total but are never evicted, and neither is anything drawn in the
+ * current frame.
+ */
+class TextureResidency : public Utils::Singleton<TextureResidency> {
+   friend class Utils::Singleton<TextureResidency>;
+
+public:
+   /**
+     * @brief Sets the GPU memory budget for textures.
+     * @param Bytes Budget in bytes (0: unlimited).
+     */
+   static void SetBudget(size_t Bytes);
+
+   /// @return The GPU memory budget in bytes (0: unlimited).
+   static size_t GetBudget();
+
+   /// @return Bytes of texture storage currently on the GPU.
+   static size_t GetResidentBytes();
+
+   /// @return Index of the current frame, as stamped on drawn textures.
+   static uint64_t GetFrame();
+
+   /**
+     * @brief Marks a texture as used this frame, restoring it if it was evicted.
+     *
+     * Called by the renderer for every textured draw.
+     */
+   static void Touch(Texture& Tex);
+
+   /**
+     * @brief Ends the frame: evicts textures until the budget is met, then advances the frame counter.
+     *
+     * Must run after the frame's batches have been flushed. Called by Application.
+     */
+   static void EndFrame();
+
+   /// Accounts a texture whose storage was just uploaded.
+   static void Track(Texture& Tex);
+
+   /// Removes a texture's storage from the accounting.
+   static void Untrack(Texture& Tex);
+
+   /// Default budget (512 MiB), leaving room for framebuffers on 1 GB integrated GPUs.
+   static constexpr size_t DEFAULT_BUDGET = 512u << 20;
+
+private:
+   std::unordered_set<Texture*> m_Evictable; ///< Resident textures that can be reloaded from a file.
+   size_t m_ResidentBytes = 0;
+   size_t m_Budget = DEFAULT_BUDGET;
+   uint64_t m_Frame = 1;
+   bool m_OverBudget = false; ///< Still over budget after the last EndFrame (warned once).
+
+   void Evict(Texture& Tex);
+
+   TextureResidency() = default;
+   ~TextureResidency() = default;
+};
+
+} // namespace Echo2D
+
+#endif // TEXTURERESIDENCY_H
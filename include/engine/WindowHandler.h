@@ -2,6 +2,7 @@
 #define WINDOW_H
 
 #include "core/core.h"
+#include "engine/FramePacer.h"
 
 namespace Echo2D {
 
@@ -53,6 +54,15 @@ public:
     /// @return Width of the window.
     int GetWidth();
 
+    /// @return The GLFW window handle.
+    GLFWwindow* GetHandle();
+
+    /**
+     * @brief Sets how buffer swaps wait for the display (off after Init).
+     * @param Mode Off, On or Adaptive V-Sync.
+     */
+    void SetVSync(VSyncMode Mode);
+
 private:
     GLFWwindow* m_Window = nullptr; ///< GLFW window handle.
     int m_Height;                   ///< Window height in pixels.
@@ -0,0 +1,275 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "core/core.h"
+#include "engine/JobSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Echo2D {
+
+/**
+ * @struct Entity
+ * @brief Generational identifier of an entity in a World.
+ */
+struct Entity {
+   uint32_t Index = UINT32_MAX;
+   uint32_t Generation = 0;
+
+   bool operator==(const Entity& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+   bool operator!=(const Entity& Other) const { return !(*this == Other); }
+};
+
+using ComponentID = uint32_t;
+using ComponentMask = uint64_t;
+
+/// Component types a program can register; one bit of ComponentMask each.
+static constexpr ComponentID MAX_COMPONENTS = 64;
+
+/**
+ * @struct ComponentInfo
+ * @brief Type-erased operations of a component type, used to move entities between archetypes.
+ */
+struct ComponentInfo {
+   size_t Size;
+   size_t Alignment;
+   void (*MoveConstruct)(void* Destination, void* Source); ///< Move-constructs Source into raw Destination.
+   void (*Destroy)(void* Object);
+};
+
+/**
+ * @class ComponentRegistry
+ * @brief Assigns each component type a small identifier on first use.
+ */
+class ComponentRegistry {
+public:
+   static ComponentID Register(const ComponentInfo& Info);
+   static const ComponentInfo& Get(ComponentID ID);
+
+   template <typename T> static ComponentID ID() {
+      static_assert(std::is_move_constructible_v<T>, "Components must be move constructible");
+      static const ComponentID id = Register({sizeof(T), alignof(T),
+                                              [](void* Destination, void* Source) {
+                                                 new (Destination) T(std::move(*static_cast<T*>(Source)));
+                                              },
+                                              [](void* Object) { static_cast<T*>(Object)->~T(); }});
+      return id;
+   }
+
+private:
+   static std::vector<ComponentInfo>& Infos();
+};
+
+/**
+ * @class World
+ * @brief Archetype-based entity component system.
+ *
+ * Entities with the same set of component types share an archetype, whose
+ * entities are stored in fixed-size chunks with one contiguous array per
+ * component type. A query visits only the archetypes that have the requested
+ * components and walks their arrays linearly, so iterating 100k entities
+ * touches memory in order instead of chasing pointers. Chunks stay densely
+ * packed: removing an entity moves the archetype's last entity into its row.
+ *
+ * Adding or removing components moves the entity to another archetype and
+ * destroying it frees its row; none of these may happen while a query is
+ * iterating. Component references are invalidated by such changes too.
+ *
+ * Built-in components (see Components.h) are consumed by Application: the
+ * movement system runs after Update() and Renderer::DrawWorld() draws every
+ * entity with a Transform and a Sprite.
+ */
+class World {
+public:
+   /// Bytes of component data per chunk.
+   static constexpr size_t CHUNK_SIZE = 16 * 1024;
+
+   /**
+     * @class ChunkView
+     * @brief The rows of one chunk, for processing component arrays in bulk.
+     */
+   class ChunkView {
+   public:
+      /// @return Number of entities in the chunk.
+      uint32_t Size() const { return m_Count; }
+
+      /// @return The chunk's entities.
+      const Entity* Entities() const { return reinterpret_cast<const Entity*>(m_Data); }
+
+      /// @return The chunk's array of T, or nullptr if its archetype has no T.
+      template <typename T> T* Column() const {
+         return static_cast<T*>(m_World->Column(m_Archetype, m_Data, ComponentRegistry::ID<T>()));
+      }
+
+   private:
+      friend class World;
+      ChunkView(const World* Owner, const void* Type, unsigned char* Data, uint32_t Count)
+         : m_World(Owner), m_Archetype(Type), m_Data(Data), m_Count(Count) {}
+
+      const World* m_World;
+      const void* m_Archetype;
+      unsigned char* m_Data;
+      uint32_t m_Count;
+   };
+
+   World();
+   ~World();
+
+   World(const World&) = delete;
+   World& operator=(const World&) = delete;
+
+   /// Creates an entity without components.
+   Entity Create();
+
+   /// Creates an entity with the given components.
+   template <typename... C> Entity Create(C... Components) {
+      Entity Created = Create();
+      (Add(Created, std::move(Components)), ...);
+      return Created;
+   }
+
+   /// Destroys an entity and its components. Stale identifiers are ignored.
+   void Destroy(Entity Target);
+
+   /// @return Whether the entity exists.
+   bool IsAlive(Entity Target) const;
+
+   /// Destroys every entity.
+   void Clear();
+
+   /**
+     * @brief Adds a component to a live entity, or replaces the one it has.
+     * @return Reference to the stored component, valid until the next structural change.
+     */
+   template <typename T> T& Add(Entity Target, T Value = T()) {
+      const ComponentID ID = ComponentRegistry::ID<T>();
+      if (void* Existing = Find(Target, ID)) {
+         *static_cast<T*>(Existing) = std::move(Value);
+         return *static_cast<T*>(Existing);
+      }
+      T* Stored = static_cast<T*>(MoveEntity(Target, ID, true));
+      new (Stored) T(std::move(Value));
+      return *Stored;
+   }
+
+   /// Removes a component from an entity, destroying it.
+   template <typename T> void Remove(Entity Target) {
+      const ComponentID ID = ComponentRegistry::ID<T>();
+      if (Find(Target, ID)) MoveEntity(Target, ID, false);
+   }
+
+   /// @return The entity's component, or nullptr.
+   template <typename T> T* Get(Entity Target) { return static_cast<T*>(Find(Target, ComponentRegistry::ID<T>())); }
+
+   /// @return Whether the entity has the component.
+   template <typename T> bool Has(Entity Target) const { return Find(Target, ComponentRegistry::ID<T>()) != nullptr; }
+
+   /**
+     * @brief Calls Fn(C&...) or Fn(Entity, C&...) for every entity having all of C.
+     */
+   template <typename... C, typename F> void Each(F&& Fn) {
+      EachChunk<C...>([&](const ChunkView& View) { Visit<C...>(View, Fn); });
+   }
+
+   /**
+     * @brief Calls Fn(const ChunkView&) for every chunk of entities having all of C.
+     */
+   template <typename... C, typename F> void EachChunk(F&& Fn) {
+      const ComponentMask Required = MaskOf<C...>();
+      for (const auto& Type : m_Archetypes) {
+         if ((Type->Mask & Required) != Required) continue;
+         for (size_t i = 0; i < Type->Chunks.size(); i++) {
+            Fn(ChunkView(this, Type.get(), Type->Chunks[i], Type->ChunkCount(i)));
+         }
+      }
+   }
+
+   /**
+     * @brief Like Each(), but spreads chunks over the JobSystem workers.
+     *
+     * Fn runs concurrently for different entities, so it must only touch the
+     * components it is given (and thread-safe state).
+     */
+   template <typename... C, typename F> void ParallelEach(F&& Fn) {
+      std::vector<ChunkView> Views;
+      EachChunk<C...>([&](const ChunkView& View) { Views.push_back(View); });
+      JobSystem::ParallelFor(0, Views.size(), 1, [&](size_t First, size_t Last) {
+         for (size_t i = First; i < Last; i++) Visit<C...>(Views[i], Fn);
+      });
+   }
+
+   /// @return Number of live entities.
+   size_t GetEntityCount() const;
+
+   /// @return Number of archetypes (distinct component sets) created so far.
+   size_t GetArchetypeCount() const;
+
+private:
+   struct Archetype {
+      ComponentMask Mask = 0;
+      std::vector<ComponentID> Types;      ///< Component types, ascending.
+      uint32_t Column[MAX_COMPONENTS];     ///< Component ID -> index into Types and Offsets, or UINT32_MAX.
+      std::vector<size_t> Offsets;         ///< Byte offset of each component array within a chunk.
+      uint32_t Capacity = 0;               ///< Entities per chunk.
+      size_t ChunkBytes = 0;
+      std::vector<unsigned char*> Chunks;  ///< Full chunks, then a partially filled last one.
+      uint32_t Count = 0;                  ///< Entities across all chunks.
+      Archetype* Edges[2][MAX_COMPONENTS] = {}; ///< Archetype with a component removed [0] / added [1].
+
+      uint32_t ChunkCount(size_t Chunk) const {
+         return Chunk + 1 < Chunks.size() ? Capacity : Count - static_cast<uint32_t>(Chunk) * Capacity;
+      }
+   };
+
+   struct Record {
+      Archetype* Type = nullptr;
+      uint32_t Row = 0;           ///< Row within the archetype (chunk = Row / Capacity).
+      uint32_t Generation = 1;
+   };
+
+   std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+   std::unordered_map<ComponentMask, Archetype*> m_ArchetypeIndex;
+   std::vector<Record> m_Records;
+   std::vector<uint32_t> m_FreeIndices;
+   size_t m_Alive = 0;
+
+   template <typename... C> static ComponentMask MaskOf() {
+      return (ComponentMask(0) | ... | (ComponentMask(1) << ComponentRegistry::ID<C>()));
+   }
+
+   template <typename... C, typename F> static void Visit(const ChunkView& View, F& Fn) {
+      const Entity* Entities = View.Entities();
+      auto Columns = std::make_tuple(View.Column<C>()...);
+      for (uint32_t i = 0; i < View.Size(); i++) {
+         if constexpr (std::is_invocable_v<F&, Entity, C&...>) {
+            Fn(Entities[i], std::get<C*>(Columns)[i]...);
+         } else {
+            Fn(std::get<C*>(Columns)[i]...);
+         }
+      }
+   }
+
+   Archetype* GetArchetype(ComponentMask Mask);
+   void* Column(const void* Type, unsigned char* Chunk, ComponentID ID) const;
+   void* Find(Entity Target, ComponentID ID) const;
+   void* Slot(Archetype& Type, uint32_t Row, size_t ColumnIndex) const;
+   uint32_t AllocateRow(Archetype& Type, Entity Owner);
+   void FreeRow(Archetype& Type, uint32_t Row);
+
+   /**
+     * @brief Moves an entity to the archetype with component ID added or removed.
+     * @return Raw storage for the added component (Add), else nullptr.
+     */
+   void* MoveEntity(Entity Target, ComponentID ID, bool Add);
+};
+
+} // namespace Echo2D
+
+#endif // WORLD_H
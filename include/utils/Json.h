@@ -0,0 +1,77 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+/**
+ * @class JsonValue
+ * @brief A parsed JSON document node.
+ *
+ * Just enough JSON to read tool-exported metadata (spritesheet atlases and
+ * the like): objects keep their members in file order, numbers are doubles,
+ * and lookups of missing members return a shared null value so chained
+ * accesses never need checks in between.
+ */
+class JsonValue {
+public:
+   enum class Type { Null, Bool, Number, String, Array, Object };
+
+   /**
+     * @brief Parses a JSON document.
+     * @param Text Document text.
+     * @param Out Receives the root value.
+     * @param Error Receives a description with the byte offset on failure (optional).
+     * @return false if Text is not valid JSON.
+     */
+   static bool Parse(const std::string& Text, JsonValue& Out, std::string* Error = nullptr);
+
+   Type GetType() const { return m_Type; }
+   bool IsNull() const { return m_Type == Type::Null; }
+   bool IsNumber() const { return m_Type == Type::Number; }
+   bool IsString() const { return m_Type == Type::String; }
+   bool IsArray() const { return m_Type == Type::Array; }
+   bool IsObject() const { return m_Type == Type::Object; }
+
+   /// @return The number, or Fallback if this is not a number.
+   double AsNumber(double Fallback = 0.0) const { return m_Type == Type::Number ? m_Number : Fallback; }
+
+   /// @return The boolean, or Fallback if this is not a boolean.
+   bool AsBool(bool Fallback = false) const { return m_Type == Type::Bool ? m_Bool : Fallback; }
+
+   /// @return The string, or an empty string if this is not a string.
+   const std::string& AsString() const;
+
+   /// @return Number of array elements or object members.
+   size_t Size() const;
+
+   /// @return Array element Index, or null.
+   const JsonValue& operator[](size_t Index) const;
+
+   /// @return Object member Key, or null.
+   const JsonValue& operator[](const std::string& Key) const;
+
+   /// @return Object members in file order (empty for other types).
+   const std::vector<std::pair<std::string, JsonValue>>& Members() const { return m_Members; }
+
+   /// @return Array elements (empty for other types).
+   const std::vector<JsonValue>& Elements() const { return m_Elements; }
+
+private:
+   friend class JsonParser;
+
+   Type m_Type = Type::Null;
+   bool m_Bool = false;
+   double m_Number = 0.0;
+   std::string m_String;
+   std::vector<JsonValue> m_Elements;
+   std::vector<std::pair<std::string, JsonValue>> m_Members;
+};
+
+}
+
+#endif
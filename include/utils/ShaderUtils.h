@@ -3,6 +3,7 @@
 #define SHADERUTILS_H
 
 #include "core/core.h"
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <string>
 
@@ -13,10 +14,12 @@ struct Vertex {
    glm::vec4 Color;
    glm::vec2 TexCoords;
    float TextureIndex;
+   float DistanceField; // 1.0 when the texture holds a signed distance field (SDF text)
 };
 
 class Shader {
 public:
+   /// Sources are taken from mounted archives, then the file system, then the shaders embedded at build time.
    Shader (const char* VertexPath = "shaders/Vert.glsl", const char* FragmentPath = "shaders/Frag.glsl");
    ~Shader ();
 
@@ -29,10 +32,36 @@ public:
    void SetFloat(const std::string Name, float Value) const;
    GLuint GetID();
 
+   /**
+    * @brief Replaces the program with one built from new sources.
+    * @return false if it failed to compile or link; the current program is kept.
+    */
+   bool Reload(const std::string &VertexCode, const std::string &FragmentCode);
+
+   /// Counter bumped on every successful Reload(); uniforms set on the old program must be set again.
+   uint32_t GetGeneration() const;
+
+   /**
+    * @brief Sets the directory linked program binaries are cached in.
+    *
+    * Defaults to ".echo2d_cache" relative to the working directory, shared
+    * with the font cache; an empty string disables the cache.
+    */
+   static void SetCacheDirectory(const std::string &Directory);
+
 private:
    GLuint ID;
+   std::string m_VertexPath;
+   std::string m_FragmentPath;
+   uint64_t m_WatchIDs[2] = {0, 0}; ///< AssetWatcher registrations of both source files.
+   uint32_t m_Generation = 0;
 
-   void CheckCompileErrors(GLuint Shader, std::string Type);
+   bool Build(const std::string &VertexCode, const std::string &FragmentCode, GLuint &Program);
+   static std::string BinaryCachePath(const std::string &VertexCode, const std::string &FragmentCode);
+   static bool LoadBinary(const std::string &Path, GLuint &Program);
+   static void SaveBinary(const std::string &Path, GLuint Program);
+   void WatchSources();
+   bool CheckCompileErrors(GLuint Shader, std::string Type);
 };
 
 }
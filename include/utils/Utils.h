@@ -2,6 +2,9 @@
 #define UTILS_H
 
 #include <core/core.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
 namespace Utils {
    
@@ -20,6 +23,50 @@ protected:
    virtual ~Singleton() = default;
 };
 
+/**
+ * @brief 64-bit FNV-1a hash of a byte range, used to key on-disk caches.
+ *
+ * Pass the previous result as Hash to hash several ranges as one.
+ */
+inline uint64_t HashBytes(const void* Data, size_t Size, uint64_t Hash = 0xcbf29ce484222325ull) {
+   const unsigned char* Bytes = static_cast<const unsigned char*>(Data);
+   for (size_t i = 0; i < Size; i++) {
+      Hash = (Hash ^ Bytes[i]) * 0x100000001b3ull;
+   }
+   return Hash;
+}
+
+/**
+ * @brief Decodes the UTF-8 sequence starting at Text[Index] and advances Index past it.
+ *
+ * Malformed, overlong or truncated sequences decode to U+FFFD and consume one byte,
+ * so decoding always makes progress.
+ */
+inline char32_t NextCodepoint(const std::string& Text, size_t& Index) {
+   const unsigned char Lead = static_cast<unsigned char>(Text[Index++]);
+   if (Lead < 0x80) return Lead;
+
+   int Extra;
+   char32_t Codepoint;
+   char32_t Min;
+   if ((Lead & 0xE0) == 0xC0) { Extra = 1; Codepoint = Lead & 0x1F; Min = 0x80; }
+   else if ((Lead & 0xF0) == 0xE0) { Extra = 2; Codepoint = Lead & 0x0F; Min = 0x800; }
+   else if ((Lead & 0xF8) == 0xF0) { Extra = 3; Codepoint = Lead & 0x07; Min = 0x10000; }
+   else return 0xFFFD;
+
+   if (Index + Extra > Text.size()) return 0xFFFD;
+   for (int i = 0; i < Extra; i++) {
+      const unsigned char Next = static_cast<unsigned char>(Text[Index + i]);
+      if ((Next & 0xC0) != 0x80) return 0xFFFD;
+      Codepoint = (Codepoint << 6) | (Next & 0x3F);
+   }
+   if (Codepoint < Min || Codepoint > 0x10FFFF || (Codepoint >= 0xD800 && Codepoint <= 0xDFFF)) {
+      return 0xFFFD;
+   }
+   Index += Extra;
+   return Codepoint;
+}
+
 }
 
 #endif
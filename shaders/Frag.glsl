@@ -4,6 +4,7 @@ out vec4 FragColor;
 in vec2 TexCoord;
 in vec4 VertexColor;
 in float TexId;
+in float DistanceField;
 
 uniform sampler2D Textures[16];
 uniform vec4 Tint;
@@ -19,5 +20,12 @@ void main() {
       TexColor = texture(Textures[index], TexCoord);
    } 
 
+   if (DistanceField > 0.5) {
+      // SDF glyph: 0.5 is the outline, fwidth keeps the edge ~1 pixel wide at any scale
+      float Distance = TexColor.a;
+      float Width = max(fwidth(Distance), 1e-4);
+      TexColor = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - Width, 0.5 + Width, Distance));
+   }
+
    FragColor = VertexColor * TexColor * Tint;
 }
@@ -3,10 +3,12 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec4 aColor;
 layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in float aTexId;
+layout (location = 4) in float aDistanceField;
 
 out vec2 TexCoord;
 out vec4 VertexColor;
 out float TexId;
+out float DistanceField;
 
 uniform mat4 model;
 uniform mat4 view;
@@ -17,6 +19,6 @@ void main()
    TexCoord = aTexCoord;
    VertexColor = aColor;
    TexId = aTexId;
+   DistanceField = aDistanceField;
    gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
-
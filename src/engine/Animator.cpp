@@ -0,0 +1,323 @@
+#include <core/core.h>
+#include <engine/Animator.h>
+#include <engine/Log.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Echo2D {
+
+/// Region of sheetless clips and out of range frames.
+static const glm::vec4 WHOLE = {0.0f, 0.0f, 1.0f, 1.0f};
+
+AnimationClip AnimationClip::FromTag(const SpritesheetHandle& Sheet, const std::string& Tag) {
+   AnimationClip Clip;
+   Clip.Sheet = Sheet;
+   Clip.SheetDurations = true;
+   if (!Sheet) return Clip;
+
+   const SpriteTag* Found = Sheet->FindTag(Tag);
+   if (!Found) {
+      ECHO2D_LOG(WARNING) << "[Animator] Unknown frame tag: " << Tag;
+      for (int i = 0; i < Sheet->GetFrameCount(); i++) Clip.Frames.push_back(i);
+      return Clip;
+   }
+
+   for (int i = Found->From; i <= Found->To; i++) Clip.Frames.push_back(i);
+   if (Found->Direction == TagDirection::Reverse) std::reverse(Clip.Frames.begin(), Clip.Frames.end());
+   if (Found->Direction == TagDirection::PingPong) Clip.Loop = LoopMode::PingPong;
+   return Clip;
+}
+
+uint32_t Animator::AddClip(const AnimationClip& Source) {
+   auto& Anim = GetInstance();
+   Clip New;
+   New.Source = Source;
+   New.Source.FrameDuration = std::max(Source.FrameDuration, 1e-4f);
+   const Spritesheet* Sheet = Source.Sheet ? &*Source.Sheet : nullptr;
+
+   // Copy the frames out of the sheet once; drawing then never touches it
+   if (!Source.Frames.empty()) {
+      for (int Index : Source.Frames) {
+         New.Frames.push_back(Sheet && Index >= 0 && Index < Sheet->GetFrameCount() ? Sheet->GetFrame(Index)
+                                                                                   : SpriteFrame::FromRegion(WHOLE));
+      }
+   } else {
+      for (int i = 0; i < std::max(1, Source.FrameCount); i++) {
+         New.Frames.push_back(Sheet ? SpriteFrame::FromRegion(Source.Sheet->GetTexCoords(Source.FirstColumn + i, Source.Row))
+                                    : SpriteFrame::FromRegion(WHOLE));
+      }
+   }
+   New.Source.FrameCount = static_cast<int>(New.Frames.size());
+
+   for (const SpriteFrame& Frame : New.Frames) {
+      New.Durations.push_back(Source.SheetDurations ? std::max(Frame.Duration, 1e-4f) : New.Source.FrameDuration);
+      New.Length += New.Durations.back();
+   }
+   New.PingPongLength = New.Length;
+   for (size_t i = 1; i + 1 < New.Durations.size(); i++) New.PingPongLength += New.Durations[i];
+
+   Anim.m_Clips.push_back(std::move(New));
+   return static_cast<uint32_t>(Anim.m_Clips.size() - 1);
+}
+
+uint32_t Animator::Create(uint32_t ClipID, float Speed) {
+   auto& Anim = GetInstance();
+   if (ClipID >= Anim.m_Clips.size()) {
+      ECHO2D_LOG(ERROR) << "[Animator] Unknown clip: " << ClipID;
+      return INVALID;
+   }
+
+   uint32_t Instance;
+   if (!Anim.m_FreeIDs.empty()) {
+      Instance = Anim.m_FreeIDs.back();
+      Anim.m_FreeIDs.pop_back();
+   } else {
+      Instance = static_cast<uint32_t>(Anim.m_Sparse.size());
+      Anim.m_Sparse.push_back(INVALID);
+   }
+
+   const uint32_t Index = static_cast<uint32_t>(Anim.m_Time.size());
+   Anim.m_Sparse[Instance] = Index;
+   Anim.m_Owner.push_back(Instance);
+   Anim.m_BaseSpeed.push_back(std::max(0.0f, Speed));
+   Anim.m_Playing.push_back(1);
+   Anim.m_Time.push_back(0.0f);
+   Anim.m_Speed.push_back(0.0f);
+   Anim.m_NextTime.push_back(0.0f);
+   Anim.m_FrameCount.push_back(1);
+   Anim.m_Step.push_back(0);
+   Anim.m_Frame.push_back(0);
+   Anim.m_ClipIndex.push_back(ClipID);
+   Anim.m_Loop.push_back(LoopMode::Loop);
+   Anim.Restart(Index, ClipID);
+   return Instance;
+}
+
+void Animator::Destroy(uint32_t Instance) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return;
+
+   // Swap the last instance into the hole so the arrays stay dense
+   auto SwapRemove = [Index](auto& Array) {
+      Array[Index] = Array.back();
+      Array.pop_back();
+   };
+   SwapRemove(Anim.m_Time);
+   SwapRemove(Anim.m_Speed);
+   SwapRemove(Anim.m_BaseSpeed);
+   SwapRemove(Anim.m_Playing);
+   SwapRemove(Anim.m_NextTime);
+   SwapRemove(Anim.m_FrameCount);
+   SwapRemove(Anim.m_Step);
+   SwapRemove(Anim.m_Frame);
+   SwapRemove(Anim.m_ClipIndex);
+   SwapRemove(Anim.m_Loop);
+   SwapRemove(Anim.m_Owner);
+
+   if (Index < Anim.m_Owner.size()) {
+      Anim.m_Sparse[Anim.m_Owner[Index]] = Index;
+   }
+   Anim.m_Sparse[Instance] = INVALID;
+   Anim.m_FreeIDs.push_back(Instance);
+}
+
+void Animator::Play(uint32_t Instance, uint32_t ClipID, bool Restart) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID || ClipID >= Anim.m_Clips.size()) return;
+   if (!Restart && Anim.m_ClipIndex[Index] == ClipID) return;
+   Anim.Restart(Index, ClipID);
+}
+
+void Animator::SetSpeed(uint32_t Instance, float Speed) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return;
+   Anim.m_BaseSpeed[Index] = std::max(0.0f, Speed);
+   Anim.m_Speed[Index] = Anim.m_Playing[Index] ? Anim.m_BaseSpeed[Index] : 0.0f;
+}
+
+void Animator::SetLoopMode(uint32_t Instance, LoopMode Mode) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return;
+   Anim.m_Loop[Index] = Mode;
+   Anim.m_Frame[Index] = Anim.FrameAt(Index, Anim.m_Step[Index]);
+}
+
+void Animator::SetPlaying(uint32_t Instance, bool Playing) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return;
+   Anim.m_Playing[Index] = Playing;
+   Anim.m_Speed[Index] = Playing ? Anim.m_BaseSpeed[Index] : 0.0f;
+}
+
+void Animator::Update(float dt) {
+   auto& Anim = GetInstance();
+   Anim.m_Events.clear();
+
+   const size_t Count = Anim.m_Time.size();
+   float* Time = Anim.m_Time.data();
+   const float* Speed = Anim.m_Speed.data();
+   const float* NextTime = Anim.m_NextTime.data();
+
+   // Branch-free pass over contiguous arrays; this vectorizes
+   for (size_t i = 0; i < Count; i++) {
+      Time[i] += dt * Speed[i];
+   }
+
+   // Only instances that reached the end of their frame need more work
+   for (uint32_t i = 0; i < Count; i++) {
+      if (Time[i] >= NextTime[i]) Anim.Advance(i);
+   }
+}
+
+/**
+ * @brief Steps an instance through every frame boundary its time has passed.
+ *
+ * A long frame hitch can skip several frames; their events are still raised,
+ * but never more than about two cycles' worth.
+ */
+void Animator::Advance(uint32_t Index) {
+   const Clip& Played = m_Clips[m_ClipIndex[Index]];
+   const int32_t Frames = m_FrameCount[Index];
+   const LoopMode Mode = m_Loop[Index];
+   const int32_t Turn = Mode == LoopMode::PingPong ? std::max(1, Frames - 1) : Frames;
+   const int32_t CycleSteps = Mode == LoopMode::PingPong ? 2 * Turn : Frames;
+   const float CycleLength = Mode == LoopMode::PingPong && Frames > 1 ? Played.PingPongLength : Played.Length;
+
+   if (Mode != LoopMode::Once && m_Time[Index] - m_NextTime[Index] > 2.0f * CycleLength) {
+      const float Skipped = std::floor((m_Time[Index] - m_NextTime[Index]) / CycleLength) - 1.0f;
+      m_Time[Index] -= Skipped * CycleLength;
+   }
+
+   while (m_Time[Index] >= m_NextTime[Index]) {
+      int32_t Step = ++m_Step[Index];
+
+      if (Mode == LoopMode::Once && Step >= Frames - 1) {
+         // Hold the last frame
+         m_Step[Index] = Frames - 1;
+         m_Frame[Index] = FrameAt(Index, Frames - 1);
+         m_Time[Index] = m_NextTime[Index];
+         m_Playing[Index] = 0;
+         m_Speed[Index] = 0.0f;
+         RaiseFrameEvents(Index, m_Frame[Index]);
+         m_Events.push_back({m_Owner[Index], m_ClipIndex[Index], m_Frame[Index], AnimationEventType::Finished});
+         return;
+      }
+
+      bool Looped = false;
+      if (Mode != LoopMode::Once && Step >= CycleSteps) {
+         // Keep time within one cycle so float precision never degrades
+         m_Time[Index] -= m_NextTime[Index];
+         m_NextTime[Index] = 0.0f;
+         Step = m_Step[Index] = 0;
+         Looped = true;
+      } else if (Mode == LoopMode::PingPong && Step == Turn) {
+         Looped = true;
+      }
+
+      m_Frame[Index] = FrameAt(Index, Step);
+      m_NextTime[Index] += Played.Durations[m_Frame[Index]];
+      RaiseFrameEvents(Index, m_Frame[Index]);
+      if (Looped) {
+         m_Events.push_back({m_Owner[Index], m_ClipIndex[Index], m_Frame[Index], AnimationEventType::Looped});
+      }
+   }
+}
+
+void Animator::RaiseFrameEvents(uint32_t Index, int Frame) {
+   for (const FrameEvent& Event : m_Clips[m_ClipIndex[Index]].Source.Events) {
+      if (Event.Frame == Frame) {
+         m_Events.push_back({m_Owner[Index], m_ClipIndex[Index], Frame, AnimationEventType::Frame, Event.Tag});
+      }
+   }
+}
+
+int Animator::FrameAt(uint32_t Index, int32_t Step) const {
+   const int32_t Frames = m_FrameCount[Index];
+   switch (m_Loop[Index]) {
+   case LoopMode::Once:
+      return std::min(Step, Frames - 1);
+   case LoopMode::PingPong: {
+      if (Frames == 1) return 0;
+      const int32_t Cycle = 2 * (Frames - 1);
+      const int32_t Position = Step % Cycle;
+      return Position < Frames ? Position : Cycle - Position;
+   }
+   case LoopMode::Loop:
+   default:
+      return Step % Frames;
+   }
+}
+
+void Animator::Restart(uint32_t Index, uint32_t ClipID) {
+   const AnimationClip& Source = m_Clips[ClipID].Source;
+   m_ClipIndex[Index] = ClipID;
+   m_Loop[Index] = Source.Loop;
+   m_FrameCount[Index] = Source.FrameCount;
+   m_NextTime[Index] = m_Clips[ClipID].Durations[0];
+   m_Time[Index] = 0.0f;
+   m_Step[Index] = 0;
+   m_Frame[Index] = 0;
+   m_Playing[Index] = 1;
+   m_Speed[Index] = m_BaseSpeed[Index];
+}
+
+uint32_t Animator::Dense(uint32_t Instance) const {
+   return Instance < m_Sparse.size() ? m_Sparse[Instance] : INVALID;
+}
+
+int Animator::GetFrame(uint32_t Instance) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   return Index == INVALID ? 0 : Anim.m_Frame[Index];
+}
+
+uint32_t Animator::GetClip(uint32_t Instance) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   return Index == INVALID ? INVALID : Anim.m_ClipIndex[Index];
+}
+
+bool Animator::IsPlaying(uint32_t Instance) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   return Index != INVALID && Anim.m_Playing[Index];
+}
+
+glm::vec4 Animator::GetTexCoords(uint32_t Instance) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return {0.0f, 0.0f, 1.0f, 1.0f};
+   return Anim.m_Clips[Anim.m_ClipIndex[Index]].Frames[Anim.m_Frame[Index]].Bounds;
+}
+
+const SpriteFrame& Animator::GetSpriteFrame(uint32_t Instance) {
+   static const SpriteFrame whole = SpriteFrame::FromRegion(WHOLE);
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return whole;
+   return Anim.m_Clips[Anim.m_ClipIndex[Index]].Frames[Anim.m_Frame[Index]];
+}
+
+Texture* Animator::GetTexture(uint32_t Instance) {
+   auto& Anim = GetInstance();
+   const uint32_t Index = Anim.Dense(Instance);
+   if (Index == INVALID) return nullptr;
+   const SpritesheetHandle& Sheet = Anim.m_Clips[Anim.m_ClipIndex[Index]].Source.Sheet;
+   return Sheet ? &Sheet->GetTex() : nullptr;
+}
+
+const std::vector<AnimationEvent>& Animator::GetEvents() {
+   return GetInstance().m_Events;
+}
+
+size_t Animator::GetInstanceCount() {
+   return GetInstance().m_Time.size();
+}
+
+} // namespace Echo2D
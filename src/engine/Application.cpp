@@ -1,7 +1,17 @@
 #include "core/core.h"
+#include <engine/Animator.h>
 #include <engine/Application.h>
 #include <engine/ApplicationInfo.h>
+#include <engine/AssetCache.h>
+#include <engine/AssetWatcher.h>
+#include <engine/Components.h>
+#include <engine/InputHandler.h>
+#include <engine/JobSystem.h>
+#include <engine/Log.h>
 #include <engine/Renderer.h>
+#include <engine/RenderThread.h>
+#include <engine/TextureLoader.h>
+#include <engine/TextureResidency.h>
 #include <engine/WindowHandler.h>
 
 #include "external/imgui.h"
@@ -10,8 +20,8 @@
 #include "external/easylogging++.h"
 INITIALIZE_EASYLOGGINGPP
 
-#include <numeric>
-#include <thread>
+#include <algorithm>
+#include <cmath>
 
 namespace Echo2D {
 
@@ -32,23 +42,94 @@ void ImGuiDraw() {
 
 
 Application::Application(const int Width, const int Height, const char *Title) {
+   Log::Start();
    m_Window = new WindowHandler(Height, Width, Title);
+   JobSystem::Start();
+   m_Pacer.SetTargetFrameTime(1.0 / 60.0);
    g_AppInfo.ScreenWidth = Width;
    g_AppInfo.ScreenHeight = Height;
    g_AppInfo.Title = Title;
 
-   LOG(INFO) << "[Application] Created with dimensions (" << Width << "x" << Height << ") and title: " << Title;
+   ECHO2D_LOG(INFO) << "[Application] Created with dimensions (" << Width << "x" << Height << ") and title: " << Title;
 }
 
 Application::~Application() {
-   LOG(INFO) << "[Application] Destroying application and window.";
+   ECHO2D_LOG(INFO) << "[Application] Destroying application and window.";
+   RenderThread::Stop();
+   AssetWatcher::Stop();
+   m_World.Clear();
+   m_Physics.Clear();
+   AssetCache::Clear();
+   TextureLoader::Shutdown();
+   JobSystem::Shutdown();
    delete m_Window;
+   Log::Stop();
 }
 
 void Application::SetFPS(int FPS) {
    if (FPS < 0 ) return;
-   m_TargetFrameTime = 1.0 / FPS;
-   LOG(INFO) << "[Application] FPS set to " << FPS;
+   m_Pacer.SetTargetFrameTime(FPS == 0 ? 0.0 : 1.0 / FPS);
+   ECHO2D_LOG(INFO) << "[Application] FPS set to " << FPS;
+}
+
+void Application::SetVSync(VSyncMode Mode) {
+   m_Window->SetVSync(Mode);
+}
+
+const FramePacer& Application::GetFramePacer() const {
+   return m_Pacer;
+}
+
+const FrameStats& Application::GetFrameStats() const {
+   return m_FrameStats;
+}
+
+void Application::SetFrameStatsExport(const std::string& Path) {
+   m_FrameStatsPath = Path;
+}
+
+void Application::SetTickRate(int TicksPerSecond) {
+   if (TicksPerSecond <= 0) return;
+   m_TickTime = 1.0 / TicksPerSecond;
+   ECHO2D_LOG(INFO) << "[Application] Tick rate set to " << TicksPerSecond;
+}
+
+void Application::SetMaxTicksPerFrame(int Ticks) {
+   m_MaxTicksPerFrame = std::max(1, Ticks);
+}
+
+float Application::GetInterpolationAlpha() const {
+   return m_Alpha;
+}
+
+void Application::SetRenderThread(bool Enabled) {
+   m_UseRenderThread = Enabled;
+}
+
+void Application::SetInputRecording(const std::string& Path) {
+   m_RecordPath = Path;
+}
+
+void Application::SetInputReplay(const std::string& Path, double FixedDelta, bool Headless) {
+   m_ReplayPath = Path;
+   m_ReplayDelta = std::max(FixedDelta, 0.0);
+   m_ReplayHeadless = Headless;
+}
+
+World& Application::GetWorld() {
+   return m_World;
+}
+
+PhysicsWorld& Application::GetPhysics() {
+   return m_Physics;
+}
+
+void Application::SetPhysicsDebugDraw(bool Enabled) {
+   m_PhysicsDebugDraw = Enabled;
+}
+
+JobSystem& Application::GetJobSystem() {
+   return JobSystem::GetInstance();
 }
 
 void Application::Debug() {
@@ -59,25 +140,26 @@ void Application::Init() {}
 
 void Application::Update(float dt) {}
 
+void Application::FixedUpdate(float dt) {}
+
 void Application::Render() const {}
 
 void Application::RenderImGui() {}
 
 void Application::UpdateFpsCounter() {
    m_FrameCount++;
-   m_FpsTimer += m_DeltaTime;
+   m_FpsTimer += m_FrameTime;
 
-   m_FrameTimeHistory.push_back(m_DeltaTime);
-   if (m_FrameTimeHistory.size() > MAX_SAMPLES) {
-      m_FrameTimeHistory.erase(m_FrameTimeHistory.begin());
+   // The first frame has no previous frame to measure against
+   if (m_FrameTime > 0.0) {
+      m_FrameStats.Record(m_FrameTime);
    }
 
    if (m_FpsTimer >= 1.0) {
       m_CurrentFPS = m_FrameCount;
-      double avgFrameTime = std::accumulate(m_FrameTimeHistory.begin(), m_FrameTimeHistory.end(), 0.0)
-         / m_FrameTimeHistory.size();
+      double avgFrameTime = m_FrameStats.GetRecentMean(MAX_SAMPLES);
 
-      m_RollingFPS = static_cast<int>(1.0 / avgFrameTime);
+      m_RollingFPS = avgFrameTime > 0.0 ? static_cast<int>(1.0 / avgFrameTime) : 0;
 
       m_FrameCount = 0;
       m_FpsTimer = 0;
@@ -86,60 +168,158 @@ void Application::UpdateFpsCounter() {
 
 void Application::Run() {
    Init();
+   m_Replaying = !m_ReplayPath.empty() && m_Replay.Load(m_ReplayPath);
+   m_Headless = m_Replaying && m_ReplayHeadless;
+   if (!m_Replaying && !m_RecordPath.empty()) {
+      m_Recorder.Open(m_RecordPath);
+   }
+   if (m_UseRenderThread && !m_Headless) {
+      RenderThread::Start(m_Window->GetHandle());
+   }
    m_LastFrameTime = glfwGetTime();
+   m_InputTime = FramePacer::Now();
 
    while (!m_Window->ShouldWindowClose()) {
-      double FrameStartTime = glfwGetTime();
-
       BeginFrame();
 
       Update(static_cast<float>(m_DeltaTime));
-      Render();
-      RenderImGui();
+      RunTicks();
+      if (!m_Headless) {
+         Renderer::DrawWorld(m_World, m_Alpha);
+         if (m_PhysicsDebugDraw) {
+            m_Physics.DebugDraw();
+         }
+         Render();
+         RenderImGui();
+      }
 
       EndFrame();
-      CapFrameRate(FrameStartTime);
+      PaceFrame();
+   }
+
+   RenderThread::Stop();
+   m_Recorder.Close();
+   m_Replaying = false;
+   m_Headless = false;
+   if (!m_FrameStatsPath.empty()) {
+      m_FrameStats.Export(m_FrameStatsPath);
    }
 }
 
+/**
+ * @brief Runs the fixed ticks covered by the elapsed time and updates the interpolation alpha.
+ */
+void Application::RunTicks() {
+   m_Accumulator += m_DeltaTime;
+
+   int Ticks = 0;
+   const float dt = static_cast<float>(m_TickTime);
+   while (m_Accumulator >= m_TickTime && Ticks < m_MaxTicksPerFrame) {
+      SaveInterpolation(m_World);
+      FixedUpdate(dt);
+      if (m_Physics.GetBodyCount() > 0) {
+         m_Physics.Step(dt);
+         SyncRigidBodies(m_World, m_Physics);
+      }
+      UpdateMovement(m_World, dt);
+      m_Accumulator -= m_TickTime;
+      Ticks++;
+   }
+
+   // Too far behind: drop the backlog rather than spiral into ever longer frames
+   if (m_Accumulator >= m_TickTime) {
+      m_Accumulator = std::fmod(m_Accumulator, m_TickTime);
+   }
+   m_Alpha = static_cast<float>(m_Accumulator / m_TickTime);
+}
+
 void Application::BeginFrame() {
    g_BatchData.DrawCalls = 0;
 
    UpdateFpsCounter();
+   AssetWatcher::Update();
+   TextureLoader::Update();
+   Animator::Update(static_cast<float>(m_DeltaTime));
+   if (m_Headless) return;
    ImGuiNewFrame();
 
    Renderer::InitDraw();
-   m_Window->ClearColor();
+   if (!RenderThread::IsActive()) {
+      m_Window->ClearColor();
+   }
 }
 
 void Application::EndFrame() {
+   if (m_Headless) {
+      AssetCache::Collect();
+      TextureResidency::EndFrame();
+      return;
+   }
    Renderer::EndDraw();
    Renderer::Flush();
+   AssetCache::Collect();
+   TextureResidency::EndFrame();
 
    if (m_ShowFPS) {
       ImGui::BeginMainMenuBar();
-      ImGui::Text("FPS: %.2lf, Rolling FPS: %d, Draw Calls: %d, Delta Time: %lf",
-                  m_CurrentFPS, m_RollingFPS, g_BatchData.DrawCalls, m_DeltaTime);
+      ImGui::Text("FPS: %.2lf, Rolling FPS: %d, Draw Calls: %d, Delta Time: %lf, Jitter: %.2lf ms, Latency: %.2lf ms, "
+                  "p99: %.2lf ms, Max: %.2lf ms",
+                  m_CurrentFPS, m_RollingFPS, g_BatchData.DrawCalls, m_DeltaTime,
+                  m_Pacer.GetJitter() * 1000.0, m_Pacer.GetAverageLatency() * 1000.0,
+                  m_FrameStats.GetPercentile(0.99) * 1000.0, m_FrameStats.GetMax() * 1000.0);
       ImGui::EndMainMenuBar();
    }
 
-   ImGuiDraw();
+   if (RenderThread::IsActive()) {
+      // The render thread clears, draws the packet, renders ImGui and swaps
+      ImGui::Render();
+      RenderThread::CaptureImGui();
+      RenderThread::GetPacket().InputTime = m_InputTime;
+      RenderThread::Submit();
+      // Submit() waited for the previous frame, so its latency is final
+      m_Pacer.RecordLatency(RenderThread::GetLatency());
+   } else {
+      ImGuiDraw();
+      m_Window->SwapBuffers();
+      m_Pacer.RecordLatency(FramePacer::Now() - m_InputTime);
+   }
+}
+
+void Application::PaceFrame() {
+   m_Pacer.Wait();
 
-   m_Window->SwapBuffers();
+   // Polling after the wait keeps input as fresh as possible for the next frame
    m_Window->PollEvents();
+   m_InputTime = FramePacer::Now();
 
    double FrameEndTime = glfwGetTime();
-   m_DeltaTime = FrameEndTime - m_LastFrameTime;
+   m_FrameTime = FrameEndTime - m_LastFrameTime;
    m_LastFrameTime = FrameEndTime;
+
+   NextInput();
 }
 
-void Application::CapFrameRate(double FrameStartTime) {
-   double Elapsed = glfwGetTime() - FrameStartTime;
-   double SleepTime = m_TargetFrameTime - Elapsed;
+void Application::NextInput() {
+   if (!m_Replaying) {
+      const InputSnapshot& Snapshot = Input::Update();
+      m_DeltaTime = m_FrameTime;
+      if (m_Recorder.IsOpen()) {
+         m_Recorder.Record(m_DeltaTime, Snapshot);
+      }
+      return;
+   }
 
-   if (SleepTime > 0.001) {
-      std::this_thread::sleep_for(std::chrono::duration<double>(SleepTime - 0.001));
+   double DeltaTime, Time;
+   const InputEvent* Events;
+   size_t Count;
+   if (!m_Replay.Next(DeltaTime, Time, Events, Count)) {
+      ECHO2D_LOG(INFO) << "[Application] Replay finished after " << m_Replay.GetFrameCount() << " frames.";
+      m_Replaying = false;
+      glfwSetWindowShouldClose(m_Window->GetHandle(), GLFW_TRUE);
+      return;
    }
+   Input::Update(Events, Count, Time);
+   m_DeltaTime = m_ReplayDelta > 0.0 ? m_ReplayDelta : DeltaTime;
 }
 
 } // namespace Echo2D
@@ -0,0 +1,184 @@
+#include <core/core.h>
+#include <engine/AssetArchive.h>
+#include <engine/Log.h>
+
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef ECHO2D_WITH_LZ4
+#include <lz4.h>
+#endif
+
+namespace Echo2D {
+
+AssetArchive::AssetArchive(const std::string& Path) : m_Path(Path) {
+   if (!Map()) {
+      ECHO2D_LOG(ERROR) << "[AssetArchive] Could not map archive: " << Path;
+      return;
+   }
+   if (!Index()) {
+      ECHO2D_LOG(ERROR) << "[AssetArchive] Invalid archive: " << Path;
+      m_Entries.clear();
+      m_Index.clear();
+      Unmap();
+      return;
+   }
+   ECHO2D_LOG(INFO) << "[AssetArchive] Mapped " << Path << " (" << m_Entries.size() << " entries, "
+             << (m_Size >> 10) << " KiB)";
+}
+
+AssetArchive::~AssetArchive() {
+   Unmap();
+}
+
+bool AssetArchive::Map() {
+#ifdef _WIN32
+   HANDLE File = CreateFileA(m_Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+   if (File == INVALID_HANDLE_VALUE) return false;
+   m_File = File;
+
+   LARGE_INTEGER Size;
+   if (!GetFileSizeEx(File, &Size) || Size.QuadPart == 0) return false;
+   m_Size = static_cast<size_t>(Size.QuadPart);
+
+   m_Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   if (!m_Mapping) return false;
+   m_Base = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+   return m_Base != nullptr;
+#else
+   m_File = open(m_Path.c_str(), O_RDONLY);
+   if (m_File < 0) return false;
+
+   struct stat Info;
+   if (fstat(m_File, &Info) != 0 || Info.st_size == 0) return false;
+   m_Size = static_cast<size_t>(Info.st_size);
+
+   void* Mapping = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+   if (Mapping == MAP_FAILED) return false;
+   m_Base = static_cast<const unsigned char*>(Mapping);
+   // Startup touches most of the archive; let the kernel read ahead
+   madvise(Mapping, m_Size, MADV_WILLNEED);
+   return true;
+#endif
+}
+
+void AssetArchive::Unmap() {
+#ifdef _WIN32
+   if (m_Base) UnmapViewOfFile(m_Base);
+   if (m_Mapping) CloseHandle(m_Mapping);
+   if (m_File) CloseHandle(m_File);
+   m_Mapping = nullptr;
+   m_File = nullptr;
+#else
+   if (m_Base) munmap(const_cast<unsigned char*>(m_Base), m_Size);
+   if (m_File >= 0) close(m_File);
+   m_File = -1;
+#endif
+   m_Base = nullptr;
+   m_Size = 0;
+}
+
+/**
+ * @brief Validates the header and table of contents and builds the name index.
+ */
+bool AssetArchive::Index() {
+   if (m_Size < sizeof(Header)) return false;
+
+   Header Head;
+   std::memcpy(&Head, m_Base, sizeof(Head));
+   if (std::memcmp(Head.Magic, MAGIC, sizeof(MAGIC)) != 0 || Head.Version != VERSION) return false;
+   if (Head.TocOffset > m_Size || Head.EntryCount > (m_Size - Head.TocOffset) / sizeof(TocEntry)) return false;
+   if (Head.NamesOffset > m_Size || Head.NamesSize > m_Size - Head.NamesOffset) return false;
+
+   const char* Names = reinterpret_cast<const char*>(m_Base + Head.NamesOffset);
+   m_Entries.reserve(Head.EntryCount);
+   for (uint32_t i = 0; i < Head.EntryCount; i++) {
+      TocEntry Toc;
+      std::memcpy(&Toc, m_Base + Head.TocOffset + i * sizeof(TocEntry), sizeof(Toc));
+      if (Toc.NameOffset > Head.NamesSize || Toc.NameLength > Head.NamesSize - Toc.NameOffset) return false;
+      if (Toc.DataOffset > m_Size || Toc.StoredSize > m_Size - Toc.DataOffset) return false;
+      if (!(Toc.Flags & FLAG_LZ4) && Toc.StoredSize != Toc.Size) return false;
+      if (static_cast<ArchiveEntryType>(Toc.Type) == ArchiveEntryType::Texture &&
+          static_cast<uint64_t>(Toc.Width) * Toc.Height * 4 != Toc.Size) {
+         return false;
+      }
+
+      m_Entries.push_back({static_cast<ArchiveEntryType>(Toc.Type), Toc.Flags, m_Base + Toc.DataOffset,
+                           static_cast<size_t>(Toc.StoredSize), static_cast<size_t>(Toc.Size),
+                           static_cast<int>(Toc.Width), static_cast<int>(Toc.Height)});
+      m_Index.emplace(std::string_view(Names + Toc.NameOffset, Toc.NameLength), i);
+   }
+   return true;
+}
+
+bool AssetArchive::IsOpen() const {
+   return m_Base != nullptr;
+}
+
+size_t AssetArchive::GetEntryCount() const {
+   return m_Entries.size();
+}
+
+const AssetArchive::Entry* AssetArchive::Find(const std::string& Name) const {
+   auto It = m_Index.find(Name);
+   return It == m_Index.end() ? nullptr : &m_Entries[It->second];
+}
+
+const unsigned char* AssetArchive::View(const Entry& Item, [[maybe_unused]] std::vector<unsigned char>& Scratch) {
+   if (!Item.IsCompressed()) return Item.Data;
+
+#ifdef ECHO2D_WITH_LZ4
+   Scratch.resize(Item.Size);
+   int Written = LZ4_decompress_safe(reinterpret_cast<const char*>(Item.Data), reinterpret_cast<char*>(Scratch.data()),
+                                     static_cast<int>(Item.StoredSize), static_cast<int>(Item.Size));
+   if (Written == static_cast<int>(Item.Size)) return Scratch.data();
+   ECHO2D_LOG(ERROR) << "[AssetArchive] Corrupt LZ4 entry.";
+#else
+   ECHO2D_LOG(ERROR) << "[AssetArchive] Entry is LZ4-compressed but Echo2D was built without LZ4.";
+#endif
+   return nullptr;
+}
+
+std::vector<std::unique_ptr<AssetArchive>>& AssetArchive::Mounted() {
+   static std::vector<std::unique_ptr<AssetArchive>> archives;
+   return archives;
+}
+
+bool AssetArchive::Mount(const std::string& Path) {
+   auto Archive = std::make_unique<AssetArchive>(Path);
+   if (!Archive->IsOpen()) return false;
+   Mounted().push_back(std::move(Archive));
+   return true;
+}
+
+void AssetArchive::UnmountAll() {
+   Mounted().clear();
+}
+
+const AssetArchive::Entry* AssetArchive::FindMounted(const std::string& Name) {
+   auto& Archives = Mounted();
+   if (Archives.empty()) return nullptr;
+
+   std::string Normalized = NormalizeName(Name);
+   for (auto It = Archives.rbegin(); It != Archives.rend(); ++It) {
+      if (const Entry* Found = (*It)->Find(Normalized)) return Found;
+   }
+   return nullptr;
+}
+
+std::string AssetArchive::NormalizeName(const std::string& Name) {
+   return std::filesystem::path(Name).lexically_normal().generic_string();
+}
+
+} // namespace Echo2D
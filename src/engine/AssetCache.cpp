@@ -0,0 +1,125 @@
+#include <core/core.h>
+#include <engine/AssetCache.h>
+#include <engine/Log.h>
+#include <engine/TextureLoader.h>
+
+namespace Echo2D {
+
+TextureHandle AssetCache::LoadTexture(const std::string& FilePath) {
+   return GetInstance().m_Textures.Acquire(FilePath, [&FilePath]() {
+      return std::make_unique<Texture>(FilePath.c_str());
+   });
+}
+
+TextureHandle AssetCache::LoadTextureAsync(const std::string& FilePath) {
+   // Keyed apart from LoadTexture(), whose callers read the size right away and must never see the placeholder
+   return GetInstance().m_Textures.Acquire(FilePath + "|async", [&FilePath]() {
+      return std::unique_ptr<Texture>(TextureLoader::Load(FilePath.c_str()));
+   });
+}
+
+SpritesheetHandle AssetCache::LoadSpritesheet(const std::string& FilePath, int SpriteWidth, int SpriteHeight) {
+   std::string Key = FilePath + "|" + std::to_string(SpriteWidth) + "x" + std::to_string(SpriteHeight);
+   return GetInstance().m_Spritesheets.Acquire(Key, [&]() {
+      return std::make_unique<Spritesheet>(FilePath, SpriteWidth, SpriteHeight);
+   });
+}
+
+SpritesheetHandle AssetCache::LoadSpritesheet(const std::string& MetadataPath) {
+   return GetInstance().m_Spritesheets.Acquire(MetadataPath, [&]() {
+      return std::make_unique<Spritesheet>(MetadataPath);
+   });
+}
+
+FontHandle AssetCache::LoadFont(const std::string& FilePath, GLuint FontSize, FontMode Mode) {
+   std::string Key = FilePath + "|" + std::to_string(FontSize) + (Mode == FontMode::SDF ? "|sdf" : "|bitmap");
+   return GetInstance().m_Fonts.Acquire(Key, [&]() {
+      return std::make_unique<Font>(FilePath.c_str(), FontSize, Mode);
+   });
+}
+
+ShaderHandle AssetCache::LoadShader(const std::string& VertexPath, const std::string& FragmentPath) {
+   return GetInstance().m_Shaders.Acquire(VertexPath + "|" + FragmentPath, [&]() {
+      return std::make_unique<Utils::Shader>(VertexPath.c_str(), FragmentPath.c_str());
+   });
+}
+
+size_t AssetCache::Collect() {
+   auto& Cache = GetInstance();
+
+   // Spritesheets first, so the textures they release are collected in the same pass
+   size_t Destroyed = Cache.m_Spritesheets.Collect();
+   Destroyed += Cache.m_Fonts.Collect();
+   Destroyed += Cache.m_Shaders.Collect();
+   Destroyed += Cache.m_Textures.Collect();
+
+   if (Destroyed > 0) {
+      ECHO2D_LOG(INFO) << "[AssetCache] Released " << Destroyed << " unreferenced assets.";
+   }
+   return Destroyed;
+}
+
+void AssetCache::Clear() {
+   auto& Cache = GetInstance();
+   size_t Destroyed = Cache.m_Spritesheets.Collect(true);
+   Destroyed += Cache.m_Fonts.Collect(true);
+   Destroyed += Cache.m_Shaders.Collect(true);
+   Destroyed += Cache.m_Textures.Collect(true);
+   ECHO2D_LOG(INFO) << "[AssetCache] Cleared " << Destroyed << " assets.";
+}
+
+size_t AssetCache::GetAssetCount() {
+   auto& Cache = GetInstance();
+   return Cache.m_Textures.Size() + Cache.m_Spritesheets.Size() + Cache.m_Fonts.Size() + Cache.m_Shaders.Size();
+}
+
+template <typename T> AssetHandle<T>::AssetHandle(const AssetHandle& Other)
+   : m_Index(Other.m_Index), m_Generation(Other.m_Generation) {
+   if (m_Index != INVALID) AssetCache::Pool<T>().Retain(m_Index, m_Generation);
+}
+
+template <typename T> AssetHandle<T>::AssetHandle(AssetHandle&& Other) noexcept
+   : m_Index(Other.m_Index), m_Generation(Other.m_Generation) {
+   Other.m_Index = INVALID;
+}
+
+template <typename T> AssetHandle<T>& AssetHandle<T>::operator=(const AssetHandle& Other) {
+   if (this != &Other) {
+      AssetHandle Copy(Other);
+      *this = std::move(Copy);
+   }
+   return *this;
+}
+
+template <typename T> AssetHandle<T>& AssetHandle<T>::operator=(AssetHandle&& Other) noexcept {
+   if (this != &Other) {
+      Reset();
+      m_Index = Other.m_Index;
+      m_Generation = Other.m_Generation;
+      Other.m_Index = INVALID;
+   }
+   return *this;
+}
+
+template <typename T> AssetHandle<T>::~AssetHandle() {
+   Reset();
+}
+
+template <typename T> T* AssetHandle<T>::Get() const {
+   if (m_Index == INVALID) return nullptr;
+   return AssetCache::Pool<T>().Get(m_Index, m_Generation);
+}
+
+template <typename T> void AssetHandle<T>::Reset() {
+   if (m_Index != INVALID) {
+      AssetCache::Pool<T>().Release(m_Index, m_Generation);
+      m_Index = INVALID;
+   }
+}
+
+template class AssetHandle<Texture>;
+template class AssetHandle<Spritesheet>;
+template class AssetHandle<Font>;
+template class AssetHandle<Utils::Shader>;
+
+} // namespace Echo2D
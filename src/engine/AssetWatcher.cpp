@@ -0,0 +1,295 @@
+#include <core/core.h>
+#include <engine/AssetWatcher.h>
+#include <engine/Log.h>
+
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Echo2D {
+
+namespace fs = std::filesystem;
+
+static std::string AbsolutePath(const std::string& Path) {
+   std::error_code Error;
+   fs::path Absolute = fs::absolute(Path, Error);
+   return (Error ? fs::path(Path) : Absolute).lexically_normal().string();
+}
+
+uint64_t AssetWatcher::Watch(const std::string& Path, Prepare OnChange) {
+   if (Path.empty()) return 0;
+
+   auto& Watcher = GetInstance();
+   std::lock_guard<std::mutex> Lock(Watcher.m_Mutex);
+   uint64_t ID = Watcher.m_NextID++;
+   Watched& Entry = Watcher.m_Watches[ID];
+   Entry.Path = AbsolutePath(Path);
+   Entry.OnChange = std::move(OnChange);
+   Watcher.m_ByPath[Entry.Path].push_back(ID);
+
+   if (Watcher.m_Running) {
+      std::error_code Error;
+      Entry.LastWrite = fs::last_write_time(Entry.Path, Error);
+#ifdef __linux__
+      Watcher.WatchDirectory(fs::path(Entry.Path).parent_path().string());
+#endif
+   }
+   return ID;
+}
+
+void AssetWatcher::Unwatch(uint64_t ID) {
+   if (ID == 0) return;
+
+   auto& Watcher = GetInstance();
+   std::lock_guard<std::mutex> PrepareLock(Watcher.m_PrepareMutex);
+   std::lock_guard<std::mutex> Lock(Watcher.m_Mutex);
+   auto It = Watcher.m_Watches.find(ID);
+   if (It == Watcher.m_Watches.end()) return;
+
+   auto PathIt = Watcher.m_ByPath.find(It->second.Path);
+   std::erase(PathIt->second, ID);
+   if (PathIt->second.empty()) Watcher.m_ByPath.erase(PathIt);
+   Watcher.m_Watches.erase(It);
+   std::erase_if(Watcher.m_Ready, [ID](const auto& Ready) { return Ready.first == ID; });
+}
+
+void AssetWatcher::Start() {
+   auto& Watcher = GetInstance();
+   if (Watcher.m_Running) return;
+
+   {
+      std::lock_guard<std::mutex> Lock(Watcher.m_Mutex);
+      for (auto& [ID, Entry] : Watcher.m_Watches) {
+         std::error_code Error;
+         Entry.LastWrite = fs::last_write_time(Entry.Path, Error);
+      }
+
+#ifdef __linux__
+      Watcher.m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      Watcher.m_WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (Watcher.m_Inotify < 0 || Watcher.m_WakeFd < 0) {
+         ECHO2D_LOG(WARNING) << "[AssetWatcher] inotify unavailable, polling modification times instead.";
+         if (Watcher.m_Inotify >= 0) close(Watcher.m_Inotify);
+         Watcher.m_Inotify = -1;
+      } else {
+         for (const auto& [Path, IDs] : Watcher.m_ByPath) {
+            Watcher.WatchDirectory(fs::path(Path).parent_path().string());
+         }
+      }
+#endif
+   }
+
+   Watcher.m_Running = true;
+   Watcher.m_Thread = std::thread(&AssetWatcher::ThreadLoop, &Watcher);
+   ECHO2D_LOG(INFO) << "[AssetWatcher] Watching " << Watcher.m_ByPath.size() << " files for changes.";
+}
+
+void AssetWatcher::Stop() {
+   auto& Watcher = GetInstance();
+   if (!Watcher.m_Running) return;
+
+   Watcher.m_Running = false;
+#ifdef __linux__
+   if (Watcher.m_WakeFd >= 0) {
+      uint64_t One = 1;
+      (void)!write(Watcher.m_WakeFd, &One, sizeof(One));
+   }
+#endif
+   Watcher.m_Thread.join();
+
+   std::lock_guard<std::mutex> Lock(Watcher.m_Mutex);
+#ifdef __linux__
+   if (Watcher.m_Inotify >= 0) close(Watcher.m_Inotify);
+   if (Watcher.m_WakeFd >= 0) close(Watcher.m_WakeFd);
+   Watcher.m_Inotify = -1;
+   Watcher.m_WakeFd = -1;
+   Watcher.m_Directories.clear();
+#endif
+   for (auto& [ID, Entry] : Watcher.m_Watches) {
+      Entry.Dirty = false;
+   }
+   Watcher.m_HasDirty = false;
+   Watcher.m_Ready.clear();
+}
+
+bool AssetWatcher::IsRunning() {
+   return GetInstance().m_Running;
+}
+
+size_t AssetWatcher::Update() {
+   auto& Watcher = GetInstance();
+   size_t Applied = 0;
+
+   // One at a time, so an apply step that destroys another asset also drops its reload
+   while (true) {
+      Apply Step;
+      {
+         std::lock_guard<std::mutex> Lock(Watcher.m_Mutex);
+         if (Watcher.m_Ready.empty()) break;
+         Step = std::move(Watcher.m_Ready.front().second);
+         Watcher.m_Ready.erase(Watcher.m_Ready.begin());
+      }
+      Step();
+      Applied++;
+   }
+   return Applied;
+}
+
+/**
+ * @brief Flags every watch of a changed file. Caller holds m_Mutex.
+ */
+void AssetWatcher::MarkChanged(const std::string& Path) {
+   auto It = m_ByPath.find(Path);
+   if (It == m_ByPath.end()) return;
+
+   for (uint64_t ID : It->second) {
+      m_Watches[ID].Dirty = true;
+   }
+   m_HasDirty = true;
+   m_LastChange = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Fallback change detection: compares every watched file's modification time. Caller holds m_Mutex.
+ */
+void AssetWatcher::PollModificationTimes() {
+   for (auto& [Path, IDs] : m_ByPath) {
+      std::error_code Error;
+      fs::file_time_type LastWrite = fs::last_write_time(Path, Error);
+      if (Error) continue;
+
+      Watched& First = m_Watches[IDs.front()];
+      if (LastWrite != First.LastWrite) {
+         for (uint64_t ID : IDs) {
+            m_Watches[ID].LastWrite = LastWrite;
+         }
+         MarkChanged(Path);
+      }
+   }
+}
+
+/**
+ * @brief Runs the prepare step of every flagged watch and queues the results for Update().
+ */
+void AssetWatcher::PrepareDirty() {
+   std::lock_guard<std::mutex> PrepareLock(m_PrepareMutex);
+
+   std::vector<std::pair<uint64_t, Prepare>> Jobs;
+   {
+      std::lock_guard<std::mutex> Lock(m_Mutex);
+      for (auto& [ID, Entry] : m_Watches) {
+         if (!Entry.Dirty) continue;
+         Entry.Dirty = false;
+         Jobs.emplace_back(ID, Entry.OnChange);
+         ECHO2D_LOG(INFO) << "[AssetWatcher] Reloading " << Entry.Path;
+      }
+      m_HasDirty = false;
+   }
+
+   for (auto& [ID, OnChange] : Jobs) {
+      Apply Step;
+      try {
+         Step = OnChange();
+      } catch (const std::exception& Error) {
+         ECHO2D_LOG(ERROR) << "[AssetWatcher] Reload failed: " << Error.what();
+      }
+      if (!Step) continue;
+
+      std::lock_guard<std::mutex> Lock(m_Mutex);
+      // A newer reload of the same asset supersedes one not applied yet
+      std::erase_if(m_Ready, [ID](const auto& Ready) { return Ready.first == ID; });
+      m_Ready.emplace_back(ID, std::move(Step));
+   }
+}
+
+void AssetWatcher::ThreadLoop() {
+   using Clock = std::chrono::steady_clock;
+
+#ifdef __linux__
+   if (m_Inotify >= 0) {
+      alignas(inotify_event) char Buffer[16 * 1024];
+      while (m_Running) {
+         int Timeout = -1;
+         {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (m_HasDirty) {
+               auto Remaining = std::chrono::duration_cast<std::chrono::milliseconds>(m_LastChange + DEBOUNCE - Clock::now());
+               Timeout = static_cast<int>(std::max<int64_t>(0, Remaining.count()));
+            }
+         }
+
+         pollfd Fds[2] = {{m_Inotify, POLLIN, 0}, {m_WakeFd, POLLIN, 0}};
+         if (poll(Fds, 2, Timeout) < 0) continue;
+
+         if (Fds[1].revents & POLLIN) {
+            uint64_t Count;
+            (void)!read(m_WakeFd, &Count, sizeof(Count));
+         }
+         if (Fds[0].revents & POLLIN) {
+            ssize_t Length;
+            while ((Length = read(m_Inotify, Buffer, sizeof(Buffer))) > 0) {
+               std::lock_guard<std::mutex> Lock(m_Mutex);
+               for (char* Cursor = Buffer; Cursor < Buffer + Length;) {
+                  const inotify_event* Event = reinterpret_cast<const inotify_event*>(Cursor);
+                  auto Directory = m_Directories.find(Event->wd);
+                  if (Event->len > 0 && Directory != m_Directories.end()) {
+                     MarkChanged((fs::path(Directory->second) / Event->name).string());
+                  }
+                  Cursor += sizeof(inotify_event) + Event->len;
+               }
+            }
+         }
+
+         bool Settled;
+         {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            Settled = m_HasDirty && Clock::now() - m_LastChange >= DEBOUNCE;
+         }
+         if (Settled) PrepareDirty();
+      }
+      return;
+   }
+#endif
+
+   while (m_Running) {
+      std::this_thread::sleep_for(POLL_INTERVAL);
+      bool Settled;
+      {
+         std::lock_guard<std::mutex> Lock(m_Mutex);
+         PollModificationTimes();
+         Settled = m_HasDirty && Clock::now() - m_LastChange >= DEBOUNCE;
+      }
+      if (Settled) PrepareDirty();
+   }
+}
+
+#ifdef __linux__
+/**
+ * @brief Adds an inotify watch on a directory. Caller holds m_Mutex.
+ *
+ * Directories are watched rather than files because editors save by writing
+ * a temporary file and renaming it over the original, which would silently
+ * end a watch on the file itself.
+ */
+void AssetWatcher::WatchDirectory(const std::string& Directory) {
+   if (m_Inotify < 0) return;
+   int Descriptor = inotify_add_watch(m_Inotify, Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+   if (Descriptor < 0) {
+      ECHO2D_LOG(WARNING) << "[AssetWatcher] Cannot watch directory: " << Directory;
+      return;
+   }
+   m_Directories[Descriptor] = Directory;
+}
+#endif
+
+AssetWatcher::~AssetWatcher() {
+   Stop();
+}
+
+} // namespace Echo2D
@@ -0,0 +1,495 @@
+#include <core/core.h>
+#include <engine/Broadphase.h>
+#include <engine/JobSystem.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Echo2D {
+
+/// Busy buckets per pair generation job; smaller grids are not worth splitting.
+static constexpr size_t PAIR_GRAIN = 1024;
+
+/// Grid coordinates are clamped to this so far-away or huge bounds cannot overflow.
+static constexpr float MAX_CELL = 1 << 24;
+
+static float AxisMin(const AABB& Bounds, int Axis) { return Axis == 0 ? Bounds.Min.x : Bounds.Min.y; }
+static float AxisMax(const AABB& Bounds, int Axis) { return Axis == 0 ? Bounds.Max.x : Bounds.Max.y; }
+
+/// Whether a circle touches a box (closest point of the box within the radius).
+static bool CircleTouchesBox(glm::vec2 Center, float Radius, const AABB& Box) {
+   const glm::vec2 Closest = glm::clamp(Center, Box.Min, Box.Max);
+   const glm::vec2 Delta = Center - Closest;
+   return Delta.x * Delta.x + Delta.y * Delta.y <= Radius * Radius;
+}
+
+static AABB CircleBounds(glm::vec2 Center, float Radius) {
+   return {Center - glm::vec2(Radius), Center + glm::vec2(Radius)};
+}
+
+Broadphase::Broadphase(float CellSize, Method PairMethod) : m_Method(PairMethod) {
+   m_CellSize = std::max(CellSize, 1e-3f);
+   m_InvCellSize = 1.0f / m_CellSize;
+}
+
+uint32_t Broadphase::AddBox(const AABB& Bounds, uint32_t UserData) {
+   return Allocate(Bounds, (Bounds.Min + Bounds.Max) * 0.5f, -1.0f, UserData);
+}
+
+uint32_t Broadphase::AddCircle(glm::vec2 Center, float Radius, uint32_t UserData) {
+   return Allocate(CircleBounds(Center, Radius), Center, std::max(Radius, 0.0f), UserData);
+}
+
+uint32_t Broadphase::Allocate(const AABB& Bounds, glm::vec2 Center, float Radius, uint32_t UserData) {
+   uint32_t Proxy;
+   if (!m_FreeIDs.empty()) {
+      Proxy = m_FreeIDs.back();
+      m_FreeIDs.pop_back();
+   } else {
+      Proxy = static_cast<uint32_t>(m_Alive.size());
+      m_Bounds.emplace_back();
+      m_Centers.emplace_back();
+      m_Radii.emplace_back();
+      m_UserData.emplace_back();
+      m_Cells.emplace_back();
+      m_Alive.emplace_back();
+      m_QueryMarks.emplace_back(0);
+   }
+
+   m_Bounds[Proxy] = Bounds;
+   m_Centers[Proxy] = Center;
+   m_Radii[Proxy] = Radius;
+   m_UserData[Proxy] = UserData;
+   m_Cells[Proxy] = CellsOf(Bounds);
+   m_Alive[Proxy] = 1;
+   m_Count++;
+   m_GridDirty = true;
+   m_OrderDirty = true;
+   return Proxy;
+}
+
+void Broadphase::MoveBox(uint32_t Proxy, const AABB& Bounds) {
+   if (!IsValid(Proxy)) return;
+   m_Centers[Proxy] = (Bounds.Min + Bounds.Max) * 0.5f;
+   Place(Proxy, Bounds);
+}
+
+void Broadphase::MoveCircle(uint32_t Proxy, glm::vec2 Center, float Radius) {
+   if (!IsValid(Proxy)) return;
+   m_Centers[Proxy] = Center;
+   m_Radii[Proxy] = std::max(Radius, 0.0f);
+   Place(Proxy, CircleBounds(Center, Radius));
+}
+
+void Broadphase::Place(uint32_t Proxy, const AABB& Bounds) {
+   m_Bounds[Proxy] = Bounds;
+   // Moves within the same cells leave the grid's layout valid
+   const CellRange Cells = CellsOf(Bounds);
+   if (Cells != m_Cells[Proxy]) {
+      m_Cells[Proxy] = Cells;
+      m_GridDirty = true;
+   }
+   m_BoundsDirty = true;
+}
+
+void Broadphase::Remove(uint32_t Proxy) {
+   if (!IsValid(Proxy)) return;
+   m_Alive[Proxy] = 0;
+   m_FreeIDs.push_back(Proxy);
+   m_Count--;
+   m_GridDirty = true;
+   m_OrderDirty = true;
+}
+
+void Broadphase::Clear() {
+   m_Bounds.clear();
+   m_Centers.clear();
+   m_Radii.clear();
+   m_UserData.clear();
+   m_Cells.clear();
+   m_Alive.clear();
+   m_FreeIDs.clear();
+   m_QueryMarks.clear();
+   m_Pairs.clear();
+   m_Count = 0;
+   m_GridDirty = true;
+   m_OrderDirty = true;
+}
+
+void Broadphase::SetMethod(Method PairMethod) {
+   m_Method = PairMethod;
+   m_OrderDirty = true;
+}
+
+void Broadphase::SetCellSize(float CellSize) {
+   m_CellSize = std::max(CellSize, 1e-3f);
+   m_InvCellSize = 1.0f / m_CellSize;
+   for (size_t i = 0; i < m_Cells.size(); i++) {
+      if (m_Alive[i]) m_Cells[i] = CellsOf(m_Bounds[i]);
+   }
+   m_GridDirty = true;
+}
+
+int32_t Broadphase::CellOf(float Coordinate) const {
+   return static_cast<int32_t>(std::floor(std::clamp(Coordinate * m_InvCellSize, -MAX_CELL, MAX_CELL)));
+}
+
+Broadphase::CellRange Broadphase::CellsOf(const AABB& Bounds) const {
+   return {CellOf(Bounds.Min.x), CellOf(Bounds.Min.y), CellOf(Bounds.Max.x), CellOf(Bounds.Max.y)};
+}
+
+uint32_t Broadphase::BucketOf(int32_t X, int32_t Y) const {
+   const uint32_t Hash = static_cast<uint32_t>(X) * 73856093u ^ static_cast<uint32_t>(Y) * 19349663u;
+   return (Hash ^ (Hash >> 16)) & m_BucketMask;
+}
+
+bool Broadphase::ShapesOverlap(uint32_t A, uint32_t B) const {
+   // Bounds already overlap, which is exact for two boxes
+   const float RadiusA = m_Radii[A];
+   const float RadiusB = m_Radii[B];
+   if (RadiusA < 0.0f && RadiusB < 0.0f) return true;
+   if (RadiusA < 0.0f) return CircleTouchesBox(m_Centers[B], RadiusB, m_Bounds[A]);
+   if (RadiusB < 0.0f) return CircleTouchesBox(m_Centers[A], RadiusA, m_Bounds[B]);
+   const glm::vec2 Delta = m_Centers[A] - m_Centers[B];
+   const float Reach = RadiusA + RadiusB;
+   return Delta.x * Delta.x + Delta.y * Delta.y <= Reach * Reach;
+}
+
+bool Broadphase::Touches(uint32_t Proxy, const AABB& Region, glm::vec2 Center, float Radius) const {
+   if (!m_Bounds[Proxy].Overlaps(Region)) return false;
+   const float ProxyRadius = m_Radii[Proxy];
+   if (Radius < 0.0f) {
+      return ProxyRadius < 0.0f || CircleTouchesBox(m_Centers[Proxy], ProxyRadius, Region);
+   }
+   if (ProxyRadius < 0.0f) return CircleTouchesBox(Center, Radius, m_Bounds[Proxy]);
+   const glm::vec2 Delta = m_Centers[Proxy] - Center;
+   const float Reach = ProxyRadius + Radius;
+   return Delta.x * Delta.x + Delta.y * Delta.y <= Reach * Reach;
+}
+
+bool Broadphase::RayEnters(uint32_t Proxy, glm::vec2 Origin, glm::vec2 Direction, float MaxDistance,
+                           float& Distance) const {
+   const float Radius = m_Radii[Proxy];
+   if (Radius >= 0.0f) {
+      // Smallest t >= 0 with |Origin + t * Direction - Center| <= Radius (Direction is unit length)
+      const glm::vec2 Offset = Origin - m_Centers[Proxy];
+      const float B = Offset.x * Direction.x + Offset.y * Direction.y;
+      const float C = Offset.x * Offset.x + Offset.y * Offset.y - Radius * Radius;
+      if (C <= 0.0f) {
+         Distance = 0.0f;
+         return true;
+      }
+      // r^2 - (distance of the center from the line)^2, without the cancellation of B * B - C
+      const glm::vec2 Closest = Offset - B * Direction;
+      const float Discriminant = Radius * Radius - (Closest.x * Closest.x + Closest.y * Closest.y);
+      if (B > 0.0f || Discriminant < 0.0f) return false;
+      Distance = -B - std::sqrt(Discriminant);
+      return Distance <= MaxDistance;
+   }
+
+   // Slabs: the ray is inside the box between the latest entry and the earliest exit
+   const AABB& Bounds = m_Bounds[Proxy];
+   float Enter = 0.0f;
+   float Exit = MaxDistance;
+   for (int Axis = 0; Axis < 2; Axis++) {
+      const float Start = Axis == 0 ? Origin.x : Origin.y;
+      const float Step = Axis == 0 ? Direction.x : Direction.y;
+      const float Low = AxisMin(Bounds, Axis);
+      const float High = AxisMax(Bounds, Axis);
+      if (Step == 0.0f) {
+         if (Start < Low || Start > High) return false;
+         continue;
+      }
+      float Near = (Low - Start) / Step;
+      float Far = (High - Start) / Step;
+      if (Near > Far) std::swap(Near, Far);
+      Enter = std::max(Enter, Near);
+      Exit = std::min(Exit, Far);
+      if (Enter > Exit) return false;
+   }
+   Distance = Enter;
+   return true;
+}
+
+void Broadphase::RebuildGrid() {
+   size_t Total = 0;
+   for (size_t i = 0; i < m_Cells.size(); i++) {
+      if (!m_Alive[i]) continue;
+      const CellRange& Cells = m_Cells[i];
+      Total += size_t(Cells.MaxX - Cells.MinX + 1) * size_t(Cells.MaxY - Cells.MinY + 1);
+   }
+
+   // About one cell per bucket keeps collisions rare without a sparse table to walk
+   const size_t Buckets = std::bit_ceil(std::max<size_t>(Total, 16));
+   m_BucketMask = static_cast<uint32_t>(Buckets - 1);
+   m_BucketStart.assign(Buckets + 1, 0);
+   m_Entries.resize(Total);
+   m_EntryBuckets.resize(Total);
+
+   // Counting sort of (proxy, cell) entries by bucket, hashing each cell once
+   size_t Entry = 0;
+   for (size_t i = 0; i < m_Cells.size(); i++) {
+      if (!m_Alive[i]) continue;
+      const CellRange& Cells = m_Cells[i];
+      for (int32_t Y = Cells.MinY; Y <= Cells.MaxY; Y++) {
+         for (int32_t X = Cells.MinX; X <= Cells.MaxX; X++) {
+            const uint32_t Bucket = BucketOf(X, Y);
+            m_EntryBuckets[Entry++] = Bucket;
+            m_BucketStart[Bucket + 1]++;
+         }
+      }
+   }
+   m_BusyBuckets.clear();
+   for (size_t b = 0; b < Buckets; b++) {
+      if (m_BucketStart[b + 1] > 1) m_BusyBuckets.push_back(static_cast<uint32_t>(b));
+      m_BucketStart[b + 1] += m_BucketStart[b];
+   }
+
+   m_BucketFill.assign(m_BucketStart.begin(), m_BucketStart.end() - 1);
+   Entry = 0;
+   for (size_t i = 0; i < m_Cells.size(); i++) {
+      if (!m_Alive[i]) continue;
+      const CellRange& Cells = m_Cells[i];
+      for (int32_t Y = Cells.MinY; Y <= Cells.MaxY; Y++) {
+         for (int32_t X = Cells.MinX; X <= Cells.MaxX; X++) {
+            m_Entries[m_BucketFill[m_EntryBuckets[Entry++]]++] =
+               {static_cast<uint32_t>(i), X, Y, Cells.MinX, Cells.MinY, m_Bounds[i]};
+         }
+      }
+   }
+   m_GridDirty = false;
+   m_BoundsDirty = false;
+}
+
+void Broadphase::RefreshEntryBounds() {
+   for (CellEntry& Entry : m_Entries) Entry.Bounds = m_Bounds[Entry.Proxy];
+   m_BoundsDirty = false;
+}
+
+void Broadphase::PairsFromGrid() {
+   const size_t Busy = m_BusyBuckets.size();
+   const size_t Blocks = std::min((Busy + PAIR_GRAIN - 1) / PAIR_GRAIN, size_t(JobSystem::GetWorkerCount() + 1) * 4);
+   if (Blocks <= 1) {
+      PairsInBuckets(0, Busy, m_Pairs);
+      return;
+   }
+
+   // Each job writes its own list; joining them in block order keeps the result deterministic
+   m_BlockPairs.resize(Blocks);
+   JobSystem::ParallelFor(0, Blocks, 1, [&](size_t First, size_t Last) {
+      for (size_t Block = First; Block < Last; Block++) {
+         m_BlockPairs[Block].clear();
+         PairsInBuckets(Block * Busy / Blocks, (Block + 1) * Busy / Blocks, m_BlockPairs[Block]);
+      }
+   });
+   for (size_t Block = 0; Block < Blocks; Block++) {
+      m_Pairs.insert(m_Pairs.end(), m_BlockPairs[Block].begin(), m_BlockPairs[Block].end());
+   }
+}
+
+void Broadphase::PairsInBuckets(size_t First, size_t Last, std::vector<ProxyPair>& Out) const {
+   for (size_t Busy = First; Busy < Last; Busy++) {
+      const uint32_t Bucket = m_BusyBuckets[Busy];
+      const uint32_t End = m_BucketStart[Bucket + 1];
+      for (uint32_t i = m_BucketStart[Bucket]; i + 1 < End; i++) {
+         const CellEntry& A = m_Entries[i];
+         for (uint32_t j = i + 1; j < End; j++) {
+            const CellEntry& B = m_Entries[j];
+            // Same cell (not just a hash collision) and overlapping bounds, evaluated without branches
+            const bool Candidate = (A.X == B.X) & (A.Y == B.Y) &
+                                   (A.Bounds.Min.x <= B.Bounds.Max.x) & (B.Bounds.Min.x <= A.Bounds.Max.x) &
+                                   (A.Bounds.Min.y <= B.Bounds.Max.y) & (B.Bounds.Min.y <= A.Bounds.Max.y);
+            if (!Candidate) continue;
+
+            // Proxies sharing several cells are reported only from the lowest one they share
+            if (A.X != std::max(A.FirstX, B.FirstX) || A.Y != std::max(A.FirstY, B.FirstY)) continue;
+            if (!ShapesOverlap(A.Proxy, B.Proxy)) continue;
+            Out.push_back({std::min(A.Proxy, B.Proxy), std::max(A.Proxy, B.Proxy)});
+         }
+      }
+   }
+}
+
+void Broadphase::PairsFromSweep() {
+   // Sweep along the axis the proxies are most spread on, with some hysteresis
+   if (m_OrderDirty && m_Count > 1) {
+      glm::vec2 Sum(0.0f), SumSquares(0.0f);
+      for (size_t i = 0; i < m_Alive.size(); i++) {
+         if (!m_Alive[i]) continue;
+         Sum += m_Centers[i];
+         SumSquares += m_Centers[i] * m_Centers[i];
+      }
+      const glm::vec2 Variance = SumSquares / float(m_Count) - (Sum / float(m_Count)) * (Sum / float(m_Count));
+      const float Current = m_Axis == 0 ? Variance.x : Variance.y;
+      const float Other = m_Axis == 0 ? Variance.y : Variance.x;
+      if (Other > Current * 1.5f) m_Axis = 1 - m_Axis;
+   }
+
+   const int Axis = m_Axis;
+   if (m_OrderDirty) {
+      m_Order.clear();
+      for (uint32_t i = 0; i < m_Alive.size(); i++) {
+         if (m_Alive[i]) m_Order.push_back(i);
+      }
+      std::sort(m_Order.begin(), m_Order.end(), [&](uint32_t A, uint32_t B) {
+         return AxisMin(m_Bounds[A], Axis) < AxisMin(m_Bounds[B], Axis);
+      });
+      m_OrderDirty = false;
+   } else {
+      // Last frame's order is nearly sorted: insertion sort repairs it in close to linear time
+      for (size_t i = 1; i < m_Order.size(); i++) {
+         const uint32_t Proxy = m_Order[i];
+         const float Key = AxisMin(m_Bounds[Proxy], Axis);
+         size_t j = i;
+         while (j > 0 && AxisMin(m_Bounds[m_Order[j - 1]], Axis) > Key) {
+            m_Order[j] = m_Order[j - 1];
+            j--;
+         }
+         m_Order[j] = Proxy;
+      }
+   }
+
+   // Copy the bounds into sweep order so the inner loop reads memory linearly
+   const size_t Count = m_Order.size();
+   m_SortMin.resize(Count);
+   m_SortMax.resize(Count);
+   m_SortLow.resize(Count);
+   m_SortHigh.resize(Count);
+   for (size_t i = 0; i < Count; i++) {
+      const AABB& Bounds = m_Bounds[m_Order[i]];
+      m_SortMin[i] = AxisMin(Bounds, Axis);
+      m_SortMax[i] = AxisMax(Bounds, Axis);
+      m_SortLow[i] = AxisMin(Bounds, 1 - Axis);
+      m_SortHigh[i] = AxisMax(Bounds, 1 - Axis);
+   }
+
+   for (size_t i = 0; i < Count; i++) {
+      const float Max = m_SortMax[i];
+      const float Low = m_SortLow[i];
+      const float High = m_SortHigh[i];
+      for (size_t j = i + 1; j < Count && m_SortMin[j] <= Max; j++) {
+         if (m_SortLow[j] > High || Low > m_SortHigh[j]) continue;
+         const uint32_t A = m_Order[i];
+         const uint32_t B = m_Order[j];
+         if (!ShapesOverlap(A, B)) continue;
+         m_Pairs.push_back({std::min(A, B), std::max(A, B)});
+      }
+   }
+}
+
+const std::vector<ProxyPair>& Broadphase::FindPairs() {
+   m_Pairs.clear();
+   if (m_Method == Method::SpatialHash) {
+      if (m_GridDirty) RebuildGrid();
+      else if (m_BoundsDirty) RefreshEntryBounds();
+      PairsFromGrid();
+   } else {
+      PairsFromSweep();
+   }
+   return m_Pairs;
+}
+
+void Broadphase::BeginQuery() {
+   if (m_GridDirty) RebuildGrid();
+
+   // Each proxy is visited once per query, however many cells it shares with the query
+   if (++m_QueryMark == 0) {
+      std::fill(m_QueryMarks.begin(), m_QueryMarks.end(), 0);
+      m_QueryMark = 1;
+   }
+}
+
+template <typename Visit>
+void Broadphase::VisitCells(const AABB& Region, Visit&& Fn) {
+   BeginQuery();
+
+   const CellRange Cells = CellsOf(Region);
+   const size_t CellCount = size_t(Cells.MaxX - Cells.MinX + 1) * size_t(Cells.MaxY - Cells.MinY + 1);
+   if (CellCount > m_Entries.size()) {
+      // Region larger than everything in the grid: walking the proxies is cheaper
+      for (uint32_t i = 0; i < m_Alive.size(); i++) {
+         if (m_Alive[i]) Fn(i);
+      }
+      return;
+   }
+
+   for (int32_t Y = Cells.MinY; Y <= Cells.MaxY; Y++) {
+      for (int32_t X = Cells.MinX; X <= Cells.MaxX; X++) {
+         const uint32_t Bucket = BucketOf(X, Y);
+         for (uint32_t i = m_BucketStart[Bucket]; i < m_BucketStart[Bucket + 1]; i++) {
+            const CellEntry& Entry = m_Entries[i];
+            if (Entry.X != X || Entry.Y != Y || m_QueryMarks[Entry.Proxy] == m_QueryMark) continue;
+            m_QueryMarks[Entry.Proxy] = m_QueryMark;
+            Fn(Entry.Proxy);
+         }
+      }
+   }
+}
+
+void Broadphase::QueryRegion(const AABB& Region, std::vector<uint32_t>& Out) {
+   VisitCells(Region, [&](uint32_t Proxy) {
+      if (Touches(Proxy, Region, {}, -1.0f)) Out.push_back(Proxy);
+   });
+}
+
+void Broadphase::QueryRadius(glm::vec2 Center, float Radius, std::vector<uint32_t>& Out) {
+   const AABB Region = CircleBounds(Center, std::max(Radius, 0.0f));
+   VisitCells(Region, [&](uint32_t Proxy) {
+      if (Touches(Proxy, Region, Center, std::max(Radius, 0.0f))) Out.push_back(Proxy);
+   });
+}
+
+void Broadphase::QueryRay(glm::vec2 Origin, glm::vec2 Direction, float MaxDistance, std::vector<RayHit>& Out) {
+   const float Length = std::sqrt(Direction.x * Direction.x + Direction.y * Direction.y);
+   if (Length == 0.0f || !(MaxDistance >= 0.0f)) return;
+   Direction /= Length;
+   BeginQuery();
+
+   auto Test = [&](uint32_t Proxy) {
+      float Distance;
+      if (RayEnters(Proxy, Origin, Direction, MaxDistance, Distance)) Out.push_back({Proxy, Distance});
+   };
+
+   // A ray crossing more cells than there are entries is cheaper to test against every proxy
+   const float CellsCrossed = MaxDistance * m_InvCellSize * (std::abs(Direction.x) + std::abs(Direction.y)) + 2.0f;
+   if (!(CellsCrossed <= static_cast<float>(m_Entries.size()))) {
+      for (uint32_t i = 0; i < m_Alive.size(); i++) {
+         if (m_Alive[i]) Test(i);
+      }
+      return;
+   }
+
+   // Walk the cells along the ray in order (Amanatides-Woo): step into whichever
+   // neighbouring cell's boundary the ray reaches first
+   int32_t X = CellOf(Origin.x);
+   int32_t Y = CellOf(Origin.y);
+   const int32_t StepX = Direction.x > 0.0f ? 1 : -1;
+   const int32_t StepY = Direction.y > 0.0f ? 1 : -1;
+   const float DeltaX = Direction.x != 0.0f ? m_CellSize / std::abs(Direction.x) : INFINITY;
+   const float DeltaY = Direction.y != 0.0f ? m_CellSize / std::abs(Direction.y) : INFINITY;
+   const float EdgeX = (X + (StepX > 0 ? 1 : 0)) * m_CellSize;
+   const float EdgeY = (Y + (StepY > 0 ? 1 : 0)) * m_CellSize;
+   float NextX = Direction.x != 0.0f ? (EdgeX - Origin.x) / Direction.x : INFINITY;
+   float NextY = Direction.y != 0.0f ? (EdgeY - Origin.y) / Direction.y : INFINITY;
+
+   for (;;) {
+      const uint32_t Bucket = BucketOf(X, Y);
+      for (uint32_t i = m_BucketStart[Bucket]; i < m_BucketStart[Bucket + 1]; i++) {
+         const CellEntry& Entry = m_Entries[i];
+         if (Entry.X != X || Entry.Y != Y || m_QueryMarks[Entry.Proxy] == m_QueryMark) continue;
+         m_QueryMarks[Entry.Proxy] = m_QueryMark;
+         Test(Entry.Proxy);
+      }
+      if (std::min(NextX, NextY) > MaxDistance) break;
+      if (NextX < NextY) {
+         X += StepX;
+         NextX += DeltaX;
+      } else {
+         Y += StepY;
+         NextY += DeltaY;
+      }
+   }
+}
+
+} // namespace Echo2D
@@ -1,6 +1,6 @@
 #include "engine/Camera.h"
+#include "engine/Log.h"
 #include <glm/gtc/matrix_transform.hpp>
-#include <external/easylogging++.h>
 
 namespace Echo2D {
 
@@ -25,7 +25,7 @@ Camera2D::Camera2D(float ViewportWidth, float ViewportHeight) {
    m_Position = glm::vec2(0.0f);
    m_Rotation = 0.0f;
 
-   LOG(INFO) << "Camera2D created with viewport: "
+   ECHO2D_LOG(INFO) << "Camera2D created with viewport: "
       << ViewportWidth << "x" << ViewportHeight;
 
    UpdateCameraState();
@@ -37,20 +37,20 @@ Camera2D::Camera2D(float ViewportWidth, float ViewportHeight) {
  * Logs the destruction of the camera.
  */
 Camera2D::~Camera2D() {
-   LOG(INFO) << "Camera2D destroyed.";
+   ECHO2D_LOG(INFO) << "Camera2D destroyed.";
 }
 
 /**
  * @brief Set the position of the camera.
  * 
  * Updates the camera's position and recalculates the view matrix.
- * Logs the new position.
+ * Logs the new position, at most once a second.
  * 
  * @param Position The new position of the camera.
  */
 void Camera2D::SetPosition(const glm::vec2& Position) {
    m_Position = Position;
-   LOG(INFO) << "Camera2D position set to: " << m_Position.x << ", " << m_Position.y;
+   ECHO2D_LOG_EVERY(DEBUG, 1.0) << "Camera2D position set to: " << m_Position.x << ", " << m_Position.y;
    UpdateCameraState();
 }
 
@@ -58,13 +58,13 @@ void Camera2D::SetPosition(const glm::vec2& Position) {
  * @brief Set the rotation of the camera.
  * 
  * Updates the camera's rotation and recalculates the view matrix.
- * Logs the new rotation.
+ * Logs the new rotation, at most once a second.
  * 
  * @param Degrees The new rotation in degrees.
  */
 void Camera2D::SetRotation(float Degrees) {
    m_Rotation = Degrees;
-   LOG(INFO) << "Camera2D rotation set to: " << m_Rotation << " degrees";
+   ECHO2D_LOG_EVERY(DEBUG, 1.0) << "Camera2D rotation set to: " << m_Rotation << " degrees";
    UpdateCameraState();
 }
 
@@ -72,13 +72,13 @@ void Camera2D::SetRotation(float Degrees) {
  * @brief Set the zoom of the camera.
  * 
  * Updates the camera's zoom and recalculates the view matrix.
- * Logs the new zoom level.
+ * Logs the new zoom level, at most once a second.
  * 
  * @param Zoom The new zoom level.
  */
 void Camera2D::SetZoom(float Zoom) {
    m_Zoom = Zoom;
-   LOG(INFO) << "Camera2D zoom set to: " << m_Zoom;
+   ECHO2D_LOG_EVERY(DEBUG, 1.0) << "Camera2D zoom set to: " << m_Zoom;
    UpdateCameraState();
 }
 
@@ -127,17 +127,54 @@ const glm::mat4& Camera2D::GetViewMatrix() const {
    return m_ViewMatrix;
 }
 
+/**
+ * @brief Get the combined projection and view matrix.
+ * 
+ * @return The view-projection matrix.
+ */
+const glm::mat4& Camera2D::GetViewProjectionMatrix() const {
+   return m_ViewProjection;
+}
+
+/**
+ * @brief Convert a window-space point to world space.
+ * 
+ * The pixel is mapped to normalized device coordinates (y flipped, since
+ * window rows grow downwards) and unprojected with the cached inverse
+ * view-projection matrix.
+ * 
+ * @param Screen The point in pixels.
+ * @return The world position.
+ */
+glm::vec2 Camera2D::ScreenToWorld(glm::vec2 Screen) const {
+   const glm::vec4 Device(2.0f * Screen.x / m_ViewportSize.x - 1.0f,
+                          1.0f - 2.0f * Screen.y / m_ViewportSize.y, 0.0f, 1.0f);
+   const glm::vec4 WorldPosition = m_InverseViewProjection * Device;
+   return {WorldPosition.x, WorldPosition.y};
+}
+
+/**
+ * @brief Convert a world position to window space.
+ * 
+ * @param WorldPosition The point in world space.
+ * @return The point in pixels.
+ */
+glm::vec2 Camera2D::WorldToScreen(glm::vec2 WorldPosition) const {
+   const glm::vec4 Device = m_ViewProjection * glm::vec4(WorldPosition, 0.0f, 1.0f);
+   return {(Device.x + 1.0f) * 0.5f * m_ViewportSize.x, (1.0f - Device.y) * 0.5f * m_ViewportSize.y};
+}
+
 /**
  * @brief Move the camera by a given delta.
  * 
  * Moves the camera by the specified delta in the x and y directions.
- * Recalculates the view matrix and logs the change.
+ * Recalculates the view matrix and logs the change, at most once a second.
  * 
  * @param Delta The change in position.
  */
 void Camera2D::Move(glm::vec2 Delta) {
    m_Position += Delta;
-   LOG(INFO) << "Camera2D moved by delta: " << Delta.x << ", " << Delta.y;
+   ECHO2D_LOG_EVERY(DEBUG, 1.0) << "Camera2D moved by delta: " << Delta.x << ", " << Delta.y;
    UpdateCameraState();
 }
 
@@ -145,13 +182,13 @@ void Camera2D::Move(glm::vec2 Delta) {
  * @brief Zoom the camera by a factor.
  * 
  * Multiplies the camera's zoom by the specified factor.
- * Recalculates the view matrix and logs the change.
+ * Recalculates the view matrix and logs the change, at most once a second.
  * 
  * @param Factor The zoom factor.
  */
 void Camera2D::Zoom(float Factor) {
    m_Zoom *= Factor;
-   LOG(INFO) << "Camera2D zoomed by factor: " << Factor << ", new zoom: " << m_Zoom;
+   ECHO2D_LOG_EVERY(DEBUG, 1.0) << "Camera2D zoomed by factor: " << Factor << ", new zoom: " << m_Zoom;
    UpdateCameraState();
 }
 
@@ -159,20 +196,21 @@ void Camera2D::Zoom(float Factor) {
  * @brief Rotate the camera by a specified number of degrees.
  * 
  * Increases or decreases the camera's rotation by the specified angle.
- * Recalculates the view matrix and logs the change.
+ * Recalculates the view matrix and logs the change, at most once a second.
  * 
  * @param Degrees The angle to rotate the camera.
  */
 void Camera2D::Rotate(float Degrees) {
    m_Rotation += Degrees;
-   LOG(INFO) << "Camera2D rotated by: " << Degrees << " degrees, new rotation: " << m_Rotation;
+   ECHO2D_LOG_EVERY(DEBUG, 1.0) << "Camera2D rotated by: " << Degrees << " degrees, new rotation: " << m_Rotation;
    UpdateCameraState();
 }
 
 /**
  * @brief Update the camera's view matrix.
  * 
- * Recalculates the view matrix based on the camera's position, zoom, and rotation.
+ * Recalculates the view matrix based on the camera's position, zoom, and rotation,
+ * and caches the view-projection matrix and its inverse for coordinate conversion.
  */
 void Camera2D::UpdateCameraState() {
    m_ViewMatrix = glm::mat4(1.0f);
@@ -182,7 +220,10 @@ void Camera2D::UpdateCameraState() {
    m_ViewMatrix = glm::rotate(m_ViewMatrix, glm::radians(-m_Rotation), glm::vec3(0.0f, 0.0f, 1.0f));
    m_ViewMatrix = glm::translate(m_ViewMatrix, glm::vec3(-m_Position, 0.0f));
 
-   LOG(DEBUG) << "Camera2D view matrix updated.";
+   m_ViewProjection = m_ProjectionMatrix * m_ViewMatrix;
+   m_InverseViewProjection = glm::inverse(m_ViewProjection);
+
+   ECHO2D_LOG(TRACE) << "Camera2D view matrix updated.";
 }
 
 } // namespace Echo2D
@@ -0,0 +1,294 @@
+#include <core/core.h>
+#include <engine/Collision.h>
+#include <engine/Log.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Echo2D {
+
+static float Cross(glm::vec2 A, glm::vec2 B) { return A.x * B.y - A.y * B.x; }
+static float Dot(glm::vec2 A, glm::vec2 B) { return A.x * B.x + A.y * B.y; }
+
+static glm::vec2 Normalize(glm::vec2 V) {
+   const float Length = std::sqrt(Dot(V, V));
+   return Length > FLT_EPSILON ? V / Length : glm::vec2(0.0f, 1.0f);
+}
+
+/// Rotates a world direction into a pose's frame.
+static glm::vec2 Unrotate(const Pose& At, glm::vec2 World) {
+   return {At.Cos * World.x + At.Sin * World.y, -At.Sin * World.x + At.Cos * World.y};
+}
+
+Pose::Pose(glm::vec2 Position, float Angle) : Position(Position), Cos(std::cos(Angle)), Sin(std::sin(Angle)) {}
+
+// === Shapes ===
+
+Shape Shape::Circle(float Radius) {
+   Shape Result;
+   Result.Kind = Type::Circle;
+   Result.Radius = std::max(Radius, 0.0f);
+   return Result;
+}
+
+Shape Shape::Box(glm::vec2 HalfExtents) {
+   const glm::vec2 Points[4] = {{-HalfExtents.x, -HalfExtents.y},
+                                {HalfExtents.x, -HalfExtents.y},
+                                {HalfExtents.x, HalfExtents.y},
+                                {-HalfExtents.x, HalfExtents.y}};
+   return Polygon(Points, 4);
+}
+
+Shape Shape::Polygon(const glm::vec2* Points, int Count) {
+   Count = std::min(Count, MAX_POLYGON_VERTICES);
+   if (Count < 3) {
+      ECHO2D_LOG(WARNING) << "[Collision] A polygon needs at least 3 points, got " << Count;
+      return Circle(0.0f);
+   }
+
+   // Signed area and centroid (shoelace)
+   float Area = 0.0f;
+   glm::vec2 Centroid(0.0f);
+   for (int i = 0; i < Count; i++) {
+      const glm::vec2 P1 = Points[i];
+      const glm::vec2 P2 = Points[(i + 1) % Count];
+      const float Twice = Cross(P1, P2);
+      Area += 0.5f * Twice;
+      Centroid += (P1 + P2) * Twice;
+   }
+   if (std::fabs(Area) <= FLT_EPSILON) {
+      ECHO2D_LOG(WARNING) << "[Collision] Degenerate polygon (zero area)";
+      return Circle(0.0f);
+   }
+   Centroid = Centroid / (6.0f * Area);
+
+   Shape Result;
+   Result.Kind = Type::Polygon;
+   Result.Count = Count;
+   for (int i = 0; i < Count; i++) {
+      // Positive area winding, so (edge.y, -edge.x) points outwards
+      const int Source = Area > 0.0f ? i : Count - 1 - i;
+      Result.Vertices[i] = Points[Source] - Centroid;
+   }
+   for (int i = 0; i < Count; i++) {
+      const glm::vec2 Edge = Result.Vertices[(i + 1) % Count] - Result.Vertices[i];
+      Result.Normals[i] = Normalize({Edge.y, -Edge.x});
+   }
+   return Result;
+}
+
+float Shape::GetArea() const {
+   if (Kind == Type::Circle) return 3.14159265f * Radius * Radius;
+   float Area = 0.0f;
+   for (int i = 0; i < Count; i++) Area += 0.5f * Cross(Vertices[i], Vertices[(i + 1) % Count]);
+   return Area;
+}
+
+float Shape::GetUnitInertia() const {
+   if (Kind == Type::Circle) return 0.5f * Radius * Radius;
+
+   // Sum over the triangles (centroid, Vi, Vi+1)
+   float Inertia = 0.0f;
+   float Area = 0.0f;
+   for (int i = 0; i < Count; i++) {
+      const glm::vec2 P1 = Vertices[i];
+      const glm::vec2 P2 = Vertices[(i + 1) % Count];
+      const float Twice = Cross(P1, P2);
+      Area += 0.5f * Twice;
+      Inertia += Twice * (Dot(P1, P1) + Dot(P1, P2) + Dot(P2, P2)) / 12.0f;
+   }
+   return Area > 0.0f ? Inertia / Area : 0.0f;
+}
+
+void Shape::GetBounds(const Pose& At, glm::vec2& Min, glm::vec2& Max) const {
+   if (Kind == Type::Circle) {
+      Min = At.Position - glm::vec2(Radius);
+      Max = At.Position + glm::vec2(Radius);
+      return;
+   }
+   Min = Max = At.Apply(Vertices[0]);
+   for (int i = 1; i < Count; i++) {
+      const glm::vec2 World = At.Apply(Vertices[i]);
+      Min = glm::min(Min, World);
+      Max = glm::max(Max, World);
+   }
+}
+
+// === Narrowphase ===
+
+static void CollideCircles(const Shape& A, const Pose& PoseA, const Shape& B, const Pose& PoseB, float Margin,
+                           Manifold& Out) {
+   const glm::vec2 Delta = PoseB.Position - PoseA.Position;
+   const float Reach = A.Radius + B.Radius + Margin;
+   const float DistanceSquared = Dot(Delta, Delta);
+   if (DistanceSquared > Reach * Reach) return;
+
+   const float Distance = std::sqrt(DistanceSquared);
+   const float Separation = Distance - A.Radius - B.Radius;
+   Out.Normal = Normalize(Delta);
+   Out.PointCount = 1;
+   Out.Points[0].Position = PoseA.Position + Out.Normal * (A.Radius + 0.5f * Separation);
+   Out.Points[0].Separation = Separation;
+   Out.Points[0].Feature = 0;
+}
+
+/// Polygon A against circle B; the normal points from the polygon to the circle.
+static void CollidePolygonCircle(const Shape& A, const Pose& PoseA, const Shape& B, const Pose& PoseB, float Margin,
+                                 Manifold& Out) {
+   // Work in the polygon's frame
+   const glm::vec2 Center = Unrotate(PoseA, PoseB.Position - PoseA.Position);
+   const float Radius = B.Radius;
+
+   int Face = 0;
+   float Separation = -FLT_MAX;
+   for (int i = 0; i < A.Count; i++) {
+      const float Distance = Dot(A.Normals[i], Center - A.Vertices[i]);
+      if (Distance > Radius + Margin) return;
+      if (Distance > Separation) {
+         Separation = Distance;
+         Face = i;
+      }
+   }
+
+   const glm::vec2 V1 = A.Vertices[Face];
+   const glm::vec2 V2 = A.Vertices[(Face + 1) % A.Count];
+   glm::vec2 Normal = A.Normals[Face];
+   glm::vec2 Surface; // Closest point of the polygon
+
+   // Past a vertex (and not inside), the closest feature is that vertex
+   const float U1 = Dot(Center - V1, V2 - V1);
+   const float U2 = Dot(Center - V2, V1 - V2);
+   if (Separation > FLT_EPSILON && (U1 <= 0.0f || U2 <= 0.0f)) {
+      const glm::vec2 Vertex = U1 <= 0.0f ? V1 : V2;
+      const glm::vec2 Delta = Center - Vertex;
+      if (Dot(Delta, Delta) > (Radius + Margin) * (Radius + Margin)) return;
+      Normal = Normalize(Delta);
+      Separation = std::sqrt(Dot(Delta, Delta));
+      Surface = Vertex;
+   } else {
+      Surface = Center - Normal * Separation;
+   }
+
+   Out.Normal = PoseA.Rotate(Normal);
+   Out.PointCount = 1;
+   Out.Points[0].Position = PoseA.Apply(0.5f * (Surface + Center - Normal * Radius));
+   Out.Points[0].Separation = Separation - Radius;
+   Out.Points[0].Feature = static_cast<uint32_t>(Face);
+}
+
+struct ClipVertex {
+   glm::vec2 Position;
+   uint32_t Feature;
+};
+
+/// Keeps the part of a segment behind the plane Dot(Normal, P) = Offset; returns the points left.
+static int ClipSegment(const ClipVertex In[2], ClipVertex Out[2], glm::vec2 Normal, float Offset, uint32_t Feature) {
+   int Count = 0;
+   const float Distance0 = Dot(Normal, In[0].Position) - Offset;
+   const float Distance1 = Dot(Normal, In[1].Position) - Offset;
+   if (Distance0 <= 0.0f) Out[Count++] = In[0];
+   if (Distance1 <= 0.0f) Out[Count++] = In[1];
+   if (Distance0 * Distance1 < 0.0f) {
+      const float T = Distance0 / (Distance0 - Distance1);
+      Out[Count++] = {In[0].Position + T * (In[1].Position - In[0].Position), Feature};
+   }
+   return Count;
+}
+
+/// Largest separation along the edge normals of Reference, and the edge it is found on.
+static float MaxSeparation(const glm::vec2* RefPoints, const glm::vec2* RefNormals, int RefCount,
+                           const glm::vec2* Points, int Count, int& Edge) {
+   float Best = -FLT_MAX;
+   for (int i = 0; i < RefCount; i++) {
+      float Deepest = FLT_MAX;
+      for (int j = 0; j < Count; j++) Deepest = std::min(Deepest, Dot(RefNormals[i], Points[j] - RefPoints[i]));
+      if (Deepest > Best) {
+         Best = Deepest;
+         Edge = i;
+      }
+   }
+   return Best;
+}
+
+static void CollidePolygons(const Shape& A, const Pose& PoseA, const Shape& B, const Pose& PoseB, float Margin,
+                            Manifold& Out) {
+   glm::vec2 PointsA[MAX_POLYGON_VERTICES], NormalsA[MAX_POLYGON_VERTICES];
+   glm::vec2 PointsB[MAX_POLYGON_VERTICES], NormalsB[MAX_POLYGON_VERTICES];
+   for (int i = 0; i < A.Count; i++) {
+      PointsA[i] = PoseA.Apply(A.Vertices[i]);
+      NormalsA[i] = PoseA.Rotate(A.Normals[i]);
+   }
+   for (int i = 0; i < B.Count; i++) {
+      PointsB[i] = PoseB.Apply(B.Vertices[i]);
+      NormalsB[i] = PoseB.Rotate(B.Normals[i]);
+   }
+
+   int EdgeA = 0, EdgeB = 0;
+   const float SeparationA = MaxSeparation(PointsA, NormalsA, A.Count, PointsB, B.Count, EdgeA);
+   if (SeparationA > Margin) return;
+   const float SeparationB = MaxSeparation(PointsB, NormalsB, B.Count, PointsA, A.Count, EdgeB);
+   if (SeparationB > Margin) return;
+
+   // Prefer A as the reference face unless B's is clearly better, so the choice does not flicker
+   const bool Flip = SeparationB > SeparationA + 0.05f;
+   const glm::vec2* RefPoints = Flip ? PointsB : PointsA;
+   const glm::vec2* RefNormals = Flip ? NormalsB : NormalsA;
+   const int RefCount = Flip ? B.Count : A.Count;
+   const int Edge = Flip ? EdgeB : EdgeA;
+   const glm::vec2* IncPoints = Flip ? PointsA : PointsB;
+   const glm::vec2* IncNormals = Flip ? NormalsA : NormalsB;
+   const int IncCount = Flip ? A.Count : B.Count;
+
+   // Incident edge: the one facing the reference normal most
+   const glm::vec2 Normal = RefNormals[Edge];
+   int Incident = 0;
+   float Facing = FLT_MAX;
+   for (int i = 0; i < IncCount; i++) {
+      const float Alignment = Dot(Normal, IncNormals[i]);
+      if (Alignment < Facing) {
+         Facing = Alignment;
+         Incident = i;
+      }
+   }
+   const ClipVertex IncidentEdge[2] = {{IncPoints[Incident], static_cast<uint32_t>(Incident)},
+                                       {IncPoints[(Incident + 1) % IncCount], static_cast<uint32_t>((Incident + 1) % IncCount)}};
+
+   // Clip the incident edge to the side planes of the reference edge
+   const glm::vec2 V1 = RefPoints[Edge];
+   const glm::vec2 V2 = RefPoints[(Edge + 1) % RefCount];
+   const glm::vec2 Tangent = Normalize(V2 - V1);
+   ClipVertex Clipped[2], Final[2];
+   if (ClipSegment(IncidentEdge, Clipped, -Tangent, -Dot(Tangent, V1), 0x10u | Edge) < 2) return;
+   if (ClipSegment(Clipped, Final, Tangent, Dot(Tangent, V2), 0x10u | ((Edge + 1) % RefCount)) < 2) return;
+
+   const float Front = Dot(Normal, V1);
+   const uint32_t Prefix = (Flip ? 0x10000u : 0u) | (static_cast<uint32_t>(Edge) << 8);
+   Out.Normal = Flip ? -Normal : Normal;
+   Out.PointCount = 0;
+   for (const ClipVertex& Vertex : Final) {
+      const float Separation = Dot(Normal, Vertex.Position) - Front;
+      if (Separation > Margin) continue;
+      ManifoldPoint& Point = Out.Points[Out.PointCount++];
+      Point.Position = Vertex.Position - Normal * (0.5f * Separation);
+      Point.Separation = Separation;
+      Point.Feature = Prefix | Vertex.Feature;
+   }
+}
+
+void Collide(const Shape& A, const Pose& PoseA, const Shape& B, const Pose& PoseB, float Margin, Manifold& Out) {
+   Out.PointCount = 0;
+   using Type = Shape::Type;
+   if (A.Kind == Type::Circle && B.Kind == Type::Circle) {
+      CollideCircles(A, PoseA, B, PoseB, Margin, Out);
+   } else if (A.Kind == Type::Polygon && B.Kind == Type::Circle) {
+      CollidePolygonCircle(A, PoseA, B, PoseB, Margin, Out);
+   } else if (A.Kind == Type::Circle) {
+      CollidePolygonCircle(B, PoseB, A, PoseA, Margin, Out);
+      Out.Normal = -Out.Normal;
+   } else {
+      CollidePolygons(A, PoseA, B, PoseB, Margin, Out);
+   }
+}
+
+} // namespace Echo2D
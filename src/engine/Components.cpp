@@ -0,0 +1,30 @@
+#include <core/core.h>
+#include <engine/Components.h>
+
+namespace Echo2D {
+
+void UpdateMovement(World& Entities, float dt) {
+   Entities.ParallelEach<Transform, Velocity>([dt](Transform& Placement, const Velocity& Motion) {
+      Placement.Position += Motion.Linear * dt;
+      Placement.Rotation += Motion.Angular * dt;
+   });
+}
+
+void SaveInterpolation(World& Entities) {
+   Entities.ParallelEach<Transform, Interpolation>([](const Transform& Placement, Interpolation& Previous) {
+      Previous.Position = Placement.Position;
+      Previous.Rotation = Placement.Rotation;
+      Previous.Valid = true;
+   });
+}
+
+void SyncRigidBodies(World& Entities, const PhysicsWorld& Physics) {
+   Entities.ParallelEach<Transform, RigidBody>([&Physics](Transform& Placement, const RigidBody& Body) {
+      if (Body.Physics != &Physics || !Physics.IsValid(Body.Body)) return;
+      // Transform rotates about the rect's center, so only the center has to match
+      Placement.Position = Physics.GetPosition(Body.Body) - Body.Offset;
+      Placement.Rotation = Physics.GetAngle(Body.Body);
+   });
+}
+
+} // namespace Echo2D
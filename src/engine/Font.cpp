@@ -1,86 +1,931 @@
 #include <engine/Font.h>
+#include <engine/AssetArchive.h>
+#include <engine/AssetWatcher.h>
+#include <engine/JobSystem.h>
+#include <engine/Log.h>
+#include <engine/Renderer.h>
 #include <engine/Texture.h>
-#include "external/easylogging++.h"
+#include <utils/Utils.h>
+#include FT_MODULE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
 
 namespace Echo2D {
 
 /**
- * @brief Constructs a Font object by loading glyphs from a font file.
- * 
- * Initializes FreeType, loads the specified font face, sets the desired pixel size,
- * and creates textures for the first 128 ASCII glyphs. Each glyph is then stored
- * in a map for later access.
- * 
+ * @brief Grows a dirty rectangle (minX, minY, maxX, maxY) to include another rectangle.
+ */
+static void ExpandDirty(glm::ivec4& dirty, int x, int y, int width, int height) {
+    if (dirty.z <= dirty.x || dirty.w <= dirty.y) {
+        dirty = {x, y, x + width, y + height};
+        return;
+    }
+    dirty.x = std::min(dirty.x, x);
+    dirty.y = std::min(dirty.y, y);
+    dirty.z = std::max(dirty.z, x + width);
+    dirty.w = std::max(dirty.w, y + height);
+}
+
+/**
+ * @brief Glyph bitmap produced by Rasterize, possibly on a worker thread.
+ */
+struct Font::RasterizedGlyph {
+    char32_t Codepoint = 0;
+    bool Done = false;     /**< Rasterize ran for this glyph. */
+    bool Missing = false;  /**< The face has no glyph for the code point. */
+    bool Loaded = false;   /**< FreeType loaded and rendered the glyph. */
+    int Width = 0;
+    int Height = 0;
+    glm::ivec2 Bearing = {0, 0};
+    GLuint Advance = 0;
+    std::vector<unsigned char> Pixels; /**< Tightly packed rows. */
+};
+
+/// Directory baked font blobs are read from and written to; empty disables the cache.
+static std::string& CacheDirectory() {
+    static std::string directory = ".echo2d_cache";
+    return directory;
+}
+
+static constexpr char CACHE_MAGIC[8] = {'E', '2', 'D', 'F', 'O', 'N', 'T', '\0'};
+static constexpr uint32_t CACHE_VERSION = 1;
+
+/**
+ * @brief Constructs a Font object by opening a font file.
+ *
+ * Reads the font file into memory (or uses it in place when a mounted
+ * AssetArchive holds it) and opens a FreeType face on it at the desired
+ * pixel size. The face stays open for the lifetime of the font so
+ * glyphs can be rasterized on demand. The atlas page size is derived from the
+ * line height so a page fits a few hundred glyphs, and the memory budget is
+ * converted into a maximum page count.
+ *
+ * The printable ASCII range is then restored from an atlas baked into a
+ * mounted archive by `echo2d_pack`, or from the on-disk font cache when a
+ * blob for the same file contents, size and mode exists; otherwise it is
+ * rasterized in parallel and the result is baked for the next launch.
+ *
+ * In SDF mode every glyph is first loaded as an outline and then rendered with
+ * FreeType's `FT_RENDER_MODE_SDF`, which yields a bitmap padded by
+ * `SDF_SPREAD` pixels on each side whose values encode the distance to the
+ * outline (128 on the edge). The atlas is then sampled with linear filtering
+ * so the distance interpolates smoothly between texels.
+ *
  * @param fontPath Path to the TrueType font (.ttf) file.
  * @param fontSize Pixel size for rendering the font.
+ * @param mode Glyph generation mode.
+ * @param atlasBudget Maximum bytes of atlas pages kept resident.
  */
-Font::Font(const char* fontPath, GLuint fontSize) {
-    FT_Library ft;
-    if (FT_Init_FreeType(&ft)) {
-        LOG(ERROR) << "Failed to initialize FreeType";
-        return;
+Font::Font(const char* fontPath, GLuint fontSize, FontMode mode, size_t atlasBudget)
+    : m_Mode(mode), m_FontSize(fontSize) {
+    static std::atomic<uint64_t> s_NextID{1};
+    m_ID = s_NextID++;
+
+    const AssetArchive::Entry* packed = AssetArchive::FindMounted(fontPath);
+    if (packed && packed->Type == ArchiveEntryType::Raw) {
+        m_FontData = AssetArchive::View(*packed, m_FileData);
+        m_FontDataSize = packed->Size;
+    } else {
+        std::ifstream file(fontPath, std::ios::binary | std::ios::ate);
+        if (!file) {
+            ECHO2D_LOG(ERROR) << "Failed to load font: " << fontPath;
+            return;
+        }
+        m_FileData.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(m_FileData.data()), m_FileData.size());
+        m_FontData = m_FileData.data();
+        m_FontDataSize = m_FileData.size();
     }
 
-    if (FT_New_Face(ft, fontPath, 0, &m_Face)) {
-        LOG(ERROR) << "Failed to load font: " << fontPath;
-        FT_Done_FreeType(ft);
+    if (!Setup(atlasBudget)) {
+        ECHO2D_LOG(ERROR) << "Failed to load font: " << fontPath;
         return;
     }
+    UpdateCachePath();
 
-    FT_Set_Pixel_Sizes(m_Face, 0, fontSize);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+    // Fonts read from disk are rebuilt when the file changes (see AssetWatcher)
+    if (!packed) {
+        WatchSource(fontPath);
+    }
+
+    ECHO2D_LOG(INFO) << "[Font] Loaded " << fontPath << " at " << fontSize << "px with "
+              << m_PageSize << "x" << m_PageSize << " atlas pages (max " << m_MaxPages << ").";
 
-    // Load first 128 ASCII characters
-    for (unsigned char c = 0; c < 128; c++) {
-        if (FT_Load_Char(m_Face, c, FT_LOAD_RENDER)) {
-            LOG(WARNING) << "Failed to load Glyph: " << c;
-            continue;
+    const AssetArchive::Entry* atlas = AssetArchive::FindMounted(GetArchiveEntryName(fontPath, fontSize, mode));
+    if (atlas && atlas->Type == ArchiveEntryType::FontAtlas) {
+        std::vector<unsigned char> scratch;
+        const unsigned char* blob = AssetArchive::View(*atlas, scratch);
+        if (blob && ApplyCache(blob, atlas->Size)) {
+            ECHO2D_LOG(INFO) << "[Font] Restored " << m_Glyphs.size() << " glyphs from the mounted archive.";
+            return;
         }
+    }
 
-        // Generate texture for the glyph
-        Texture* glyphTex = new Texture(
-            m_Face->glyph->bitmap.width,
-            m_Face->glyph->bitmap.rows,
-            m_Face->glyph->bitmap.buffer
-        );
+    if (!LoadCache()) {
+        std::string ascii;
+        for (char c = 32; c < 127; c++) ascii.push_back(c);
+        Preload(ascii);
+        SaveCache();
+    }
+}
 
-        // Create the Character object and store it
-        Character character = {
-            glyphTex,
-            {m_Face->glyph->bitmap.width, m_Face->glyph->bitmap.rows},
-            {m_Face->glyph->bitmap_left, m_Face->glyph->bitmap_top},
-            static_cast<GLuint>(m_Face->glyph->advance.x)
+/**
+ * @brief Builds a font that never touches OpenGL, for offline baking.
+ */
+Font::Font(HeadlessTag, const unsigned char* fontData, size_t fontDataSize, GLuint fontSize, FontMode mode,
+           size_t atlasBudget)
+    : m_Mode(mode), m_FontSize(fontSize), m_FontData(fontData), m_FontDataSize(fontDataSize), m_Headless(true) {
+    Setup(atlasBudget);
+}
+
+/**
+ * @brief Opens the main face and derives the atlas page size and page limit from it.
+ */
+bool Font::Setup(size_t atlasBudget) {
+    if (!OpenFace(m_Library, m_Face)) {
+        return false;
+    }
+
+    int cell = static_cast<int>(m_Face->size->metrics.height >> 6) + ATLAS_PADDING;
+    if (m_Mode == FontMode::SDF) cell += 2 * SDF_SPREAD;
+    m_AtlasBudget = atlasBudget;
+    m_PageSize = 512;
+    while (m_PageSize < cell * 16 && m_PageSize < 4096) {
+        m_PageSize *= 2;
+    }
+    m_MaxPages = std::max<size_t>(1, atlasBudget / (static_cast<size_t>(m_PageSize) * m_PageSize));
+    return true;
+}
+
+/**
+ * @brief Points m_CachePath at the blob for the current file contents, size and mode.
+ */
+void Font::UpdateCachePath() {
+    m_CachePath.clear();
+    if (CacheDirectory().empty()) return;
+
+    std::ostringstream name;
+    name << std::hex << Utils::HashBytes(m_FontData, m_FontDataSize) << std::dec << "-" << m_FontSize
+         << (m_Mode == FontMode::SDF ? "-sdf" : "-bitmap") << ".e2dfont";
+    m_CachePath = (std::filesystem::path(CacheDirectory()) / name.str()).string();
+}
+
+/**
+ * @brief Registers the font file with the AssetWatcher.
+ *
+ * On a change the new file is read and its printable ASCII set rasterized
+ * into a cache blob by a headless font on the watcher thread; only the page
+ * uploads happen on the GL thread, in Rebuild().
+ */
+void Font::WatchSource(const std::string& fontPath) {
+    const GLuint fontSize = m_FontSize;
+    const FontMode mode = m_Mode;
+    const size_t atlasBudget = m_AtlasBudget;
+
+    m_WatchID = AssetWatcher::Watch(fontPath, [this, fontPath, fontSize, mode, atlasBudget]() -> AssetWatcher::Apply {
+        auto fileData = std::make_shared<std::vector<unsigned char>>();
+        std::ifstream file(fontPath, std::ios::binary | std::ios::ate);
+        if (!file) return {};
+        fileData->resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(fileData->data()), fileData->size())) return {};
+
+        Font baked(HeadlessTag{}, fileData->data(), fileData->size(), fontSize, mode, atlasBudget);
+        if (!baked.m_Face) {
+            ECHO2D_LOG(ERROR) << "[Font] Changed font file is not a valid font, keeping the old one: " << fontPath;
+            return {};
+        }
+        std::string ascii;
+        for (char c = 32; c < 127; c++) ascii.push_back(c);
+        baked.Preload(ascii);
+
+        auto blob = std::make_shared<std::string>();
+        baked.SerializeCache(*blob);
+        return [this, fontPath, fileData, blob] {
+            Rebuild(std::move(*fileData), *blob);
+            ECHO2D_LOG(INFO) << "[Font] Reloaded " << fontPath << " (" << m_Glyphs.size() << " glyphs).";
         };
-        m_Characters.insert({c, character});
+    });
+}
+
+/**
+ * @brief Swaps in new font file contents and the atlas baked from them.
+ *
+ * Every page and glyph of the old file is dropped and the generation bumped,
+ * so cached text layouts reshape on their next draw.
+ */
+void Font::Rebuild(std::vector<unsigned char>&& fileData, const std::string& blob) {
+    Renderer::FlushPending();
+    for (AtlasPage& page : m_Pages) {
+        delete page.m_Texture;
+    }
+    m_Pages.clear();
+    m_Glyphs.clear();
+    m_FreeSlots.clear();
+    m_GlyphPage.clear();
+    for (auto& block : m_BMPTable) {
+        block.reset();
+    }
+    m_AstralTable.clear();
+    if (m_Face) FT_Done_Face(m_Face);
+    if (m_Library) FT_Done_FreeType(m_Library);
+
+    m_FileData = std::move(fileData);
+    m_FontData = m_FileData.data();
+    m_FontDataSize = m_FileData.size();
+    m_Generation++;
+    if (!Setup(m_AtlasBudget)) {
+        ECHO2D_LOG(ERROR) << "[Font] Could not reopen the reloaded font.";
+        return;
     }
+    UpdateCachePath();
 
-    FT_Done_Face(m_Face);
-    FT_Done_FreeType(ft);
+    if (!ApplyCache(reinterpret_cast<const unsigned char*>(blob.data()), blob.size())) {
+        std::string ascii;
+        for (char c = 32; c < 127; c++) ascii.push_back(c);
+        Preload(ascii);
+    }
+    SaveCache();
 }
 
 /**
- * @brief Destructor. Cleans up dynamically allocated glyph textures.
+ * @brief Destructor. Releases the atlas pages and the FreeType face.
  */
 Font::~Font() {
-    for (auto& [c, ch] : m_Characters) {
-        delete ch.m_Texture; // Delete each texture to free resources
+    AssetWatcher::Unwatch(m_WatchID);
+    for (AtlasPage& page : m_Pages) {
+        delete page.m_Texture;
+    }
+    if (m_Face) FT_Done_Face(m_Face);
+    if (m_Library) FT_Done_FreeType(m_Library);
+}
+
+void Font::SetCacheDirectory(const std::string& directory) {
+    CacheDirectory() = directory;
+}
+
+std::string Font::GetArchiveEntryName(const std::string& fontPath, GLuint fontSize, FontMode mode) {
+    return AssetArchive::NormalizeName(fontPath) + "#" + std::to_string(fontSize) +
+           (mode == FontMode::SDF ? "-sdf" : "-bitmap");
+}
+
+bool Font::Bake(const unsigned char* fontData, size_t fontDataSize, GLuint fontSize, FontMode mode,
+                const std::string& text, std::string& blob) {
+    Font font(HeadlessTag{}, fontData, fontDataSize, fontSize, mode, DEFAULT_ATLAS_BUDGET);
+    if (!font.m_Face) return false;
+    font.Preload(text);
+    font.SerializeCache(blob);
+    return true;
+}
+
+/**
+ * @brief Opens a FreeType library and face over the in-memory font file.
+ *
+ * FreeType faces must not be shared between threads, so every rasterization
+ * worker opens its own pair; the file bytes themselves are shared read-only.
+ */
+bool Font::OpenFace(FT_Library& library, FT_Face& face) const {
+    library = nullptr;
+    face = nullptr;
+    if (!m_FontData || FT_Init_FreeType(&library)) {
+        library = nullptr;
+        return false;
+    }
+
+    if (FT_New_Memory_Face(library, m_FontData, static_cast<FT_Long>(m_FontDataSize), 0, &face)) {
+        FT_Done_FreeType(library);
+        library = nullptr;
+        face = nullptr;
+        return false;
     }
+
+    FT_Set_Pixel_Sizes(face, 0, m_FontSize);
+    if (m_Mode == FontMode::SDF) {
+        FT_Int spread = SDF_SPREAD;
+        FT_Property_Set(library, "sdf", "spread", &spread);
+    }
+    return true;
+}
+
+/**
+ * @brief Looks up the slot index entry for a code point.
+ *
+ * BMP code points index a two-level table whose 256-entry blocks are only
+ * allocated when `create` is set; everything else goes to a hash map.
+ *
+ * @return Pointer to the entry (-1 when not cached), or nullptr if absent and not created.
+ */
+int32_t* Font::FindSlot(char32_t codepoint, bool create) {
+    if (codepoint <= 0xFFFF) {
+        std::unique_ptr<std::array<int32_t, 256>>& block = m_BMPTable[codepoint >> 8];
+        if (!block) {
+            if (!create) return nullptr;
+            block = std::make_unique<std::array<int32_t, 256>>();
+            block->fill(-1);
+        }
+        return &(*block)[codepoint & 0xFF];
+    }
+
+    auto it = m_AstralTable.find(codepoint);
+    if (it == m_AstralTable.end()) {
+        if (!create) return nullptr;
+        it = m_AstralTable.emplace(codepoint, -1).first;
+    }
+    return &it->second;
+}
+
+const Character& Font::GetGlyph(char32_t codepoint) {
+    int32_t* entry = FindSlot(codepoint, true);
+    if (*entry < 0) {
+        int32_t slot = LoadGlyph(codepoint);
+        // Loading may evict a page and erase hash entries, so look the entry up again
+        entry = FindSlot(codepoint, true);
+        *entry = slot;
+    }
+
+    int32_t slot = *entry;
+    int32_t page = m_GlyphPage[slot];
+    if (page >= 0) {
+        m_Pages[page].m_LastUse = ++m_UseTick;
+    }
+    return m_Glyphs[slot];
 }
 
 /**
  * @brief Retrieves the Character struct associated with a given character code.
- * 
+ *
  * This function retrieves a reference to the `Character` object, which contains
- * the texture and metadata for the specified character.
- * 
- * @param c The ASCII character to retrieve.
+ * the atlas rectangle and metadata for the specified character.
+ *
+ * @param c The character to retrieve.
  * @return Reference to the corresponding Character object.
- * 
- * @throws std::out_of_range If the character does not exist in the m_Characters map.
  */
-Character& Font::GetCharacter(char c) {
-    return m_Characters.at(c); // May throw if the character is not found
+const Character& Font::GetCharacter(char c) {
+    return GetGlyph(static_cast<unsigned char>(c));
 }
 
-} // namespace Echo2D
+void Font::Preload(const std::string& text) {
+    std::vector<char32_t> pending;
+    for (size_t i = 0; i < text.size();) {
+        char32_t codepoint = Utils::NextCodepoint(text, i);
+        int32_t* entry = FindSlot(codepoint, false);
+        if (!entry || *entry < 0) pending.push_back(codepoint);
+    }
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    std::vector<RasterizedGlyph> glyphs(pending.size());
+    RasterizeParallel(pending, glyphs);
+
+    m_DeferUpload = true;
+    for (const RasterizedGlyph& glyph : glyphs) {
+        if (*FindSlot(glyph.Codepoint, true) >= 0) continue;
+        int32_t slot = InsertGlyph(glyph);
+        *FindSlot(glyph.Codepoint, true) = slot;
+    }
+    m_DeferUpload = false;
+
+    for (AtlasPage& page : m_Pages) {
+        UploadDirty(page);
+    }
+}
+
+/**
+ * @brief Rasterizes a list of code points, spreading them over the JobSystem.
+ *
+ * Small batches stay on the calling thread. The list is cut into one
+ * contiguous chunk per thread and each job opens its own face for the chunks
+ * it runs; anything a job could not handle is rasterized on the calling
+ * thread afterwards.
+ */
+void Font::RasterizeParallel(const std::vector<char32_t>& codepoints, std::vector<RasterizedGlyph>& out) const {
+    const size_t chunks = std::min<size_t>(JobSystem::GetWorkerCount() + 1,
+                                           codepoints.size() / PARALLEL_GLYPHS_PER_THREAD);
+
+    if (chunks > 1) {
+        JobSystem::ParallelFor(0, chunks, 1, [this, chunks, &codepoints, &out](size_t first, size_t last) {
+            FT_Library library;
+            FT_Face face;
+            if (!OpenFace(library, face)) return;
+            const size_t end = last * codepoints.size() / chunks;
+            for (size_t i = first * codepoints.size() / chunks; i < end; i++) {
+                Rasterize(face, m_Mode, codepoints[i], out[i]);
+            }
+            FT_Done_Face(face);
+            FT_Done_FreeType(library);
+        });
+    }
+
+    for (size_t i = 0; i < codepoints.size(); i++) {
+        if (!out[i].Done) Rasterize(m_Face, m_Mode, codepoints[i], out[i]);
+    }
+}
+
+/**
+ * @brief Renders one glyph with the given face into a CPU bitmap.
+ *
+ * Touches nothing but the face and the output, so it is safe to call from
+ * worker threads that own their face.
+ */
+void Font::Rasterize(FT_Face face, FontMode mode, char32_t codepoint, RasterizedGlyph& out) {
+    out.Codepoint = codepoint;
+    out.Done = true;
+    if (!face) return;
+
+    FT_UInt glyphIndex = codepoint == NOTDEF_KEY ? 0 : FT_Get_Char_Index(face, codepoint);
+    if (glyphIndex == 0 && codepoint != NOTDEF_KEY) {
+        out.Missing = true;
+        return;
+    }
+
+    if (mode == FontMode::SDF) {
+        out.Loaded = !FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT) &&
+                     !FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF);
+    } else {
+        out.Loaded = !FT_Load_Glyph(face, glyphIndex, FT_LOAD_RENDER);
+    }
+    if (!out.Loaded) return;
+
+    const FT_Bitmap& bitmap = face->glyph->bitmap;
+    out.Width = static_cast<int>(bitmap.width);
+    out.Height = static_cast<int>(bitmap.rows);
+    out.Bearing = {face->glyph->bitmap_left, face->glyph->bitmap_top};
+    out.Advance = static_cast<GLuint>(face->glyph->advance.x);
+    out.Pixels.resize(static_cast<size_t>(out.Width) * out.Height);
+    for (int row = 0; row < out.Height && out.Width > 0; row++) {
+        std::memcpy(out.Pixels.data() + row * out.Width,
+                    bitmap.buffer + row * std::abs(bitmap.pitch), out.Width);
+    }
+}
+
+int32_t Font::LoadGlyph(char32_t codepoint) {
+    RasterizedGlyph glyph;
+    Rasterize(m_Face, m_Mode, codepoint, glyph);
+    return InsertGlyph(glyph);
+}
+
+/**
+ * @brief Copies a rasterized glyph into an atlas page and gives it a slot.
+ *
+ * Glyphs that fail to load, have no pixels, or do not fit on a page get a
+ * slot with no atlas page so they are never retried. Code points the face
+ * does not cover share the slot of the `.notdef` glyph and are registered on
+ * its page so eviction resets them too.
+ *
+ * @return Index of the glyph slot.
+ */
+int32_t Font::InsertGlyph(const RasterizedGlyph& glyph) {
+    if (glyph.Missing) {
+        GetGlyph(NOTDEF_KEY);
+        int32_t notdef = *FindSlot(NOTDEF_KEY, false);
+        if (m_GlyphPage[notdef] >= 0) {
+            m_Pages[m_GlyphPage[notdef]].m_Codepoints.push_back(glyph.Codepoint);
+        }
+        return notdef;
+    }
+
+    Character character = {nullptr, {0.0f, 0.0f, 0.0f, 0.0f}, {0, 0}, {0, 0}, 0};
+    int32_t pageIndex = -1;
+
+    if (!glyph.Loaded && m_Face) {
+        ECHO2D_LOG(WARNING) << "Failed to load Glyph: U+" << std::hex << static_cast<uint32_t>(glyph.Codepoint);
+    }
+
+    if (glyph.Loaded) {
+        character.m_Size = {glyph.Width, glyph.Height};
+        character.m_Bearing = glyph.Bearing;
+        character.m_Advance = glyph.Advance;
+
+        glm::ivec2 pos;
+        if (glyph.Width > 0 && glyph.Height > 0 && AllocateRect(glyph.Width, glyph.Height, pageIndex, pos)) {
+            AtlasPage& page = m_Pages[pageIndex];
+            page.m_LastUse = ++m_UseTick;
+            for (int row = 0; row < glyph.Height; row++) {
+                std::memcpy(page.m_Pixels.data() + (pos.y + row) * m_PageSize + pos.x,
+                            glyph.Pixels.data() + row * glyph.Width, glyph.Width);
+            }
+            ExpandDirty(page.m_Dirty, pos.x, pos.y, glyph.Width, glyph.Height);
+            page.m_Codepoints.push_back(glyph.Codepoint);
+
+            character.m_Atlas = page.m_Texture;
+            character.m_UV = {static_cast<float>(pos.x) / m_PageSize,
+                              static_cast<float>(pos.y) / m_PageSize,
+                              static_cast<float>(glyph.Width) / m_PageSize,
+                              static_cast<float>(glyph.Height) / m_PageSize};
+
+            if (!m_DeferUpload) UploadDirty(page);
+        }
+    }
+
+    return AddSlot(character, pageIndex);
+}
+
+/**
+ * @brief Stores a glyph in a free slot (or a new one) and returns its index.
+ */
+int32_t Font::AddSlot(const Character& character, int32_t page) {
+    int32_t slot;
+    if (!m_FreeSlots.empty()) {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+        m_Glyphs[slot] = character;
+        m_GlyphPage[slot] = page;
+    } else {
+        slot = static_cast<int32_t>(m_Glyphs.size());
+        m_Glyphs.push_back(character);
+        m_GlyphPage.push_back(page);
+    }
+    return slot;
+}
+
+/**
+ * @brief Creates an empty atlas page, optionally initialized from baked pixels.
+ * @return Index of the new page.
+ */
+int Font::CreatePage(const unsigned char* pixels) {
+    AtlasPage newPage;
+    if (pixels) {
+        newPage.m_Pixels.assign(pixels, pixels + static_cast<size_t>(m_PageSize) * m_PageSize);
+    } else {
+        newPage.m_Pixels.assign(static_cast<size_t>(m_PageSize) * m_PageSize, 0);
+    }
+    if (!m_Headless) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+        newPage.m_Texture = new Texture(m_PageSize, m_PageSize, newPage.m_Pixels.data(),
+                                        m_Mode == FontMode::SDF ? GL_LINEAR : GL_NEAREST);
+    }
+    // A fresh page counts as used, so it is not the next eviction victim
+    newPage.m_LastUse = ++m_UseTick;
+    m_Pages.push_back(std::move(newPage));
+    return static_cast<int>(m_Pages.size() - 1);
+}
+
+/**
+ * @brief Finds room for a glyph, creating or evicting a page if necessary.
+ */
+bool Font::AllocateRect(int width, int height, int& page, glm::ivec2& pos) {
+    if (width + 2 * ATLAS_PADDING > m_PageSize || height + 2 * ATLAS_PADDING > m_PageSize) {
+        ECHO2D_LOG(WARNING) << "[Font] Glyph of " << width << "x" << height << " does not fit an atlas page.";
+        return false;
+    }
+
+    for (size_t i = 0; i < m_Pages.size(); i++) {
+        if (AllocateOnPage(m_Pages[i], width, height, pos)) {
+            page = static_cast<int>(i);
+            return true;
+        }
+    }
+
+    if (m_Pages.size() < m_MaxPages) {
+        page = CreatePage(nullptr);
+    } else {
+        page = EvictLeastRecentlyUsedPage();
+    }
+
+    return AllocateOnPage(m_Pages[page], width, height, pos);
+}
+
+/**
+ * @brief Shelf allocation on a single page.
+ *
+ * Picks the open shelf with the least wasted height; a new shelf is opened
+ * instead when the best fit would waste more than half of it.
+ */
+bool Font::AllocateOnPage(AtlasPage& page, int width, int height, glm::ivec2& pos) {
+    glm::ivec3* best = nullptr;
+    for (glm::ivec3& shelf : page.m_Shelves) {
+        if (shelf.y >= height && shelf.z + width + ATLAS_PADDING <= m_PageSize &&
+            (!best || shelf.y < best->y)) {
+            best = &shelf;
+        }
+    }
+
+    bool canOpenShelf = page.m_NextShelfY + height + ATLAS_PADDING <= m_PageSize;
+    if (best && (best->y - height <= best->y / 2 || !canOpenShelf)) {
+        pos = {best->z, best->x};
+        best->z += width + ATLAS_PADDING;
+        return true;
+    }
+
+    if (!canOpenShelf) return false;
+
+    pos = {ATLAS_PADDING, page.m_NextShelfY};
+    page.m_Shelves.push_back({page.m_NextShelfY, height, ATLAS_PADDING + width + ATLAS_PADDING});
+    page.m_NextShelfY += height + ATLAS_PADDING;
+    return true;
+}
+
+/**
+ * @brief Clears the least recently used page and drops every glyph on it.
+ *
+ * Pending renderer geometry may still sample the page, so it is submitted
+ * before the page contents change.
+ *
+ * @return Index of the now empty page.
+ */
+int Font::EvictLeastRecentlyUsedPage() {
+    if (!m_Headless) Renderer::FlushPending();
+
+    int victim = 0;
+    for (size_t i = 1; i < m_Pages.size(); i++) {
+        if (m_Pages[i].m_LastUse < m_Pages[victim].m_LastUse) {
+            victim = static_cast<int>(i);
+        }
+    }
+
+    AtlasPage& page = m_Pages[victim];
+    for (char32_t codepoint : page.m_Codepoints) {
+        int32_t* entry = FindSlot(codepoint, false);
+        if (!entry || *entry < 0) continue;
+        // Several code points can share the .notdef slot; release it only once
+        if (m_GlyphPage[*entry] == victim) {
+            m_GlyphPage[*entry] = -1;
+            m_FreeSlots.push_back(*entry);
+        }
+        if (codepoint > 0xFFFF) {
+            m_AstralTable.erase(codepoint);
+        } else {
+            *entry = -1;
+        }
+    }
+
+    ECHO2D_LOG(INFO) << "[Font] Evicted atlas page " << victim << " holding "
+              << page.m_Codepoints.size() << " glyphs.";
+
+    m_Generation++;
+    page.m_Codepoints.clear();
+    page.m_Shelves.clear();
+    page.m_NextShelfY = ATLAS_PADDING;
+    std::fill(page.m_Pixels.begin(), page.m_Pixels.end(), 0);
+    page.m_Dirty = {0, 0, m_PageSize, m_PageSize};
+    if (!m_DeferUpload) UploadDirty(page);
+    return victim;
+}
+
+/**
+ * @brief Uploads the dirty rectangle of a page from its CPU copy.
+ */
+void Font::UploadDirty(AtlasPage& page) {
+    const glm::ivec4& dirty = page.m_Dirty;
+    if (!page.m_Texture || dirty.z <= dirty.x || dirty.w <= dirty.y) return;
+
+    page.m_Texture->Update(dirty.x, dirty.y, dirty.z - dirty.x, dirty.w - dirty.y,
+                           page.m_Pixels.data() + dirty.y * m_PageSize + dirty.x, m_PageSize);
+    page.m_Dirty = {0, 0, 0, 0};
+}
+
+/**
+ * @brief Serializes the current atlas pages and glyph table.
+ *
+ * Layout: magic, version, FreeType version, mode, size, page size, page and
+ * glyph counts, then per page its shelf state and pixels, then per cached
+ * code point its page and metrics.
+ */
+void Font::SerializeCache(std::string& buffer) const {
+    std::vector<std::pair<char32_t, int32_t>> entries;
+    for (size_t block = 0; block < m_BMPTable.size(); block++) {
+        if (!m_BMPTable[block]) continue;
+        for (size_t i = 0; i < 256; i++) {
+            int32_t slot = (*m_BMPTable[block])[i];
+            if (slot >= 0) entries.push_back({static_cast<char32_t>(block << 8 | i), slot});
+        }
+    }
+    for (const auto& [codepoint, slot] : m_AstralTable) {
+        if (slot >= 0) entries.push_back({codepoint, slot});
+    }
+
+    buffer.clear();
+    auto write = [&buffer](const void* data, size_t size) {
+        buffer.append(static_cast<const char*>(data), size);
+    };
+    auto writeU32 = [&write](uint32_t value) { write(&value, sizeof(value)); };
+
+    write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writeU32(CACHE_VERSION);
+    writeU32(FREETYPE_MAJOR * 10000 + FREETYPE_MINOR * 100 + FREETYPE_PATCH);
+    writeU32(static_cast<uint32_t>(m_Mode));
+    writeU32(m_FontSize);
+    writeU32(static_cast<uint32_t>(m_PageSize));
+    writeU32(static_cast<uint32_t>(m_Pages.size()));
+    writeU32(static_cast<uint32_t>(entries.size()));
 
+    for (const AtlasPage& page : m_Pages) {
+        writeU32(static_cast<uint32_t>(page.m_NextShelfY));
+        writeU32(static_cast<uint32_t>(page.m_Shelves.size()));
+        write(page.m_Shelves.data(), page.m_Shelves.size() * sizeof(glm::ivec3));
+        write(page.m_Pixels.data(), page.m_Pixels.size());
+    }
+
+    for (const auto& [codepoint, slot] : entries) {
+        const Character& ch = m_Glyphs[slot];
+        writeU32(static_cast<uint32_t>(codepoint));
+        writeU32(static_cast<uint32_t>(m_GlyphPage[slot]));
+        write(&ch.m_UV, sizeof(ch.m_UV));
+        write(&ch.m_Size, sizeof(ch.m_Size));
+        write(&ch.m_Bearing, sizeof(ch.m_Bearing));
+        writeU32(ch.m_Advance);
+    }
+}
+
+/**
+ * @brief Writes the current atlas pages and glyph table to the baked font cache.
+ *
+ * The blob is written to a temporary file and renamed so a crash never
+ * leaves a truncated cache entry behind.
+ */
+bool Font::SaveCache() const {
+    if (m_CachePath.empty() || !m_Face) return false;
+
+    std::string buffer;
+    SerializeCache(buffer);
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(m_CachePath).parent_path(), error);
+    std::string temporary = m_CachePath + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(buffer.data(), buffer.size())) {
+            ECHO2D_LOG(WARNING) << "[Font] Could not write font cache " << temporary;
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, m_CachePath, error);
+    if (error) {
+        ECHO2D_LOG(WARNING) << "[Font] Could not write font cache " << m_CachePath << ": " << error.message();
+        return false;
+    }
+
+    ECHO2D_LOG(INFO) << "[Font] Baked " << m_Glyphs.size() << " glyphs to " << m_CachePath;
+    return true;
+}
+
+/**
+ * @brief Restores atlas pages and glyphs from the baked font cache.
+ *
+ * The blob is read with a single read and handed to ApplyCache().
+ *
+ * @return true if the cache was applied.
+ */
+bool Font::LoadCache() {
+    if (m_CachePath.empty()) return false;
+
+    std::ifstream file(m_CachePath, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    std::vector<unsigned char> buffer(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), buffer.size())) return false;
+
+    if (!ApplyCache(buffer.data(), buffer.size())) return false;
+    ECHO2D_LOG(INFO) << "[Font] Restored " << m_Glyphs.size() << " glyphs from " << m_CachePath;
+    return true;
+}
+
+/**
+ * @brief Rebuilds atlas pages and glyphs from a serialized cache blob.
+ *
+ * Each page is uploaded once. Anything unexpected (other FreeType version,
+ * size, budget, truncation) rejects the blob before any page is created.
+ *
+ * @return true if the blob was applied.
+ */
+bool Font::ApplyCache(const unsigned char* blob, size_t blobSize) {
+    size_t offset = 0;
+    auto read = [&](void* data, size_t size) {
+        if (offset + size > blobSize) return false;
+        std::memcpy(data, blob + offset, size);
+        offset += size;
+        return true;
+    };
+    auto readU32 = [&read](uint32_t& value) { return read(&value, sizeof(value)); };
+
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t version, freetype, mode, fontSize, pageSize, pageCount, glyphCount;
+    if (!read(magic, sizeof(magic)) || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        !readU32(version) || !readU32(freetype) || !readU32(mode) || !readU32(fontSize) ||
+        !readU32(pageSize) || !readU32(pageCount) || !readU32(glyphCount)) {
+        return false;
+    }
+    if (version != CACHE_VERSION ||
+        freetype != FREETYPE_MAJOR * 10000 + FREETYPE_MINOR * 100 + FREETYPE_PATCH ||
+        mode != static_cast<uint32_t>(m_Mode) || fontSize != m_FontSize ||
+        pageSize != static_cast<uint32_t>(m_PageSize) || pageCount > m_MaxPages) {
+        return false;
+    }
+
+    // Validate the whole blob before touching GL so a bad file costs nothing
+    struct PageRecord {
+        uint32_t NextShelfY;
+        std::vector<glm::ivec3> Shelves;
+        size_t PixelOffset;
+    };
+    std::vector<PageRecord> pages(pageCount);
+    const size_t pageBytes = static_cast<size_t>(m_PageSize) * m_PageSize;
+    for (PageRecord& page : pages) {
+        uint32_t shelfCount;
+        if (!readU32(page.NextShelfY) || !readU32(shelfCount) ||
+            page.NextShelfY > static_cast<uint32_t>(m_PageSize) || shelfCount > static_cast<uint32_t>(m_PageSize)) {
+            return false;
+        }
+        page.Shelves.resize(shelfCount);
+        if (!read(page.Shelves.data(), shelfCount * sizeof(glm::ivec3))) return false;
+        // Shelves are (y, height, next x); each must lie on the page
+        for (const glm::ivec3& shelf : page.Shelves) {
+            if (shelf.x < 0 || shelf.y < 0 || shelf.z < 0 || shelf.x > m_PageSize - shelf.y ||
+                shelf.z > m_PageSize) {
+                return false;
+            }
+        }
+        page.PixelOffset = offset;
+        if (offset + pageBytes > blobSize) return false;
+        offset += pageBytes;
+    }
+
+    struct GlyphRecord {
+        uint32_t Codepoint;
+        uint32_t Page;
+        Character Glyph;
+    };
+    std::vector<GlyphRecord> glyphs(glyphCount);
+    for (GlyphRecord& record : glyphs) {
+        Character& ch = record.Glyph;
+        if (!readU32(record.Codepoint) || !readU32(record.Page) || !read(&ch.m_UV, sizeof(ch.m_UV)) ||
+            !read(&ch.m_Size, sizeof(ch.m_Size)) || !read(&ch.m_Bearing, sizeof(ch.m_Bearing)) ||
+            !readU32(ch.m_Advance)) {
+            return false;
+        }
+        // Glyphs without a bitmap are stored on page -1
+        if (record.Codepoint > NOTDEF_KEY || (record.Page != UINT32_MAX && record.Page >= pageCount)) {
+            return false;
+        }
+    }
+
+    for (const PageRecord& record : pages) {
+        int index = CreatePage(blob + record.PixelOffset);
+        m_Pages[index].m_NextShelfY = static_cast<int>(record.NextShelfY);
+        m_Pages[index].m_Shelves = record.Shelves;
+    }
+
+    for (GlyphRecord& record : glyphs) {
+        int32_t page = static_cast<int32_t>(record.Page);
+        record.Glyph.m_Atlas = page >= 0 ? m_Pages[page].m_Texture : nullptr;
+        if (page >= 0) m_Pages[page].m_Codepoints.push_back(record.Codepoint);
+        *FindSlot(record.Codepoint, true) = AddSlot(record.Glyph, page);
+    }
+    return true;
+}
+
+FontMode Font::GetMode() const {
+    return m_Mode;
+}
+
+size_t Font::GetPageCount() const {
+    return m_Pages.size();
+}
+
+int Font::GetKerning(char32_t left, char32_t right) const {
+    if (!m_Face || !FT_HAS_KERNING(m_Face)) return 0;
+
+    FT_Vector delta;
+    if (FT_Get_Kerning(m_Face, FT_Get_Char_Index(m_Face, left), FT_Get_Char_Index(m_Face, right),
+                       FT_KERNING_DEFAULT, &delta)) {
+        return 0;
+    }
+    return static_cast<int>(delta.x);
+}
+
+float Font::GetLineHeight() const {
+    if (!m_Face) return 0.0f;
+    return static_cast<float>(m_Face->size->metrics.height) / 64.0f;
+}
+
+uint64_t Font::GetID() const {
+    return m_ID;
+}
+
+uint64_t Font::GetGeneration() const {
+    return m_Generation;
+}
+
+int Font::GetPageIndex(const Texture* atlas) const {
+    for (size_t i = 0; i < m_Pages.size(); i++) {
+        if (m_Pages[i].m_Texture == atlas) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void Font::TouchPage(int page) {
+    if (page >= 0 && page < static_cast<int>(m_Pages.size())) {
+        m_Pages[page].m_LastUse = ++m_UseTick;
+    }
+}
+
+} // namespace Echo2D
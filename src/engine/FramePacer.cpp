@@ -0,0 +1,107 @@
+#include <engine/FramePacer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace Echo2D {
+
+/// Averages the first Count entries of a sample ring.
+static double Mean(const std::array<double, FramePacer::SAMPLES>& Samples, size_t Count) {
+   if (Count == 0) return 0.0;
+   double Sum = 0.0;
+   for (size_t i = 0; i < Count; i++) Sum += Samples[i];
+   return Sum / Count;
+}
+
+double FramePacer::Now() {
+   using Clock = std::chrono::steady_clock;
+   return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+void FramePacer::SetTargetFrameTime(double Seconds) {
+   m_TargetFrameTime = std::max(0.0, Seconds);
+   m_Deadline = 0.0;
+}
+
+double FramePacer::GetTargetFrameTime() const {
+   return m_TargetFrameTime;
+}
+
+void FramePacer::Wait() {
+   double Current = Now();
+   if (m_TargetFrameTime <= 0.0) {
+      RecordFrame(Current);
+      return;
+   }
+
+   // Deadlines advance by whole frames so sleep errors never accumulate
+   m_Deadline = m_Deadline == 0.0 ? Current + m_TargetFrameTime : m_Deadline + m_TargetFrameTime;
+   if (Current >= m_Deadline) {
+      // Late: start over from now instead of rushing the next frames
+      m_Deadline = Current;
+      RecordFrame(Current);
+      return;
+   }
+
+   const double Spin = GetSpinWindow();
+   while (m_Deadline - Current > Spin) {
+      const double Request = m_Deadline - Current - Spin;
+      std::this_thread::sleep_for(std::chrono::duration<double>(Request));
+      const double Woke = Now();
+      m_Oversleep = std::max(m_Oversleep, Woke - Current - Request);
+      Current = Woke;
+   }
+   while (Current < m_Deadline) {
+      std::this_thread::yield();
+      Current = Now();
+   }
+
+   // Forget old outliers slowly (halves in about 70 frames)
+   m_Oversleep *= 0.99;
+   RecordFrame(Current);
+}
+
+void FramePacer::RecordFrame(double Now) {
+   if (m_LastFrameEnd != 0.0) {
+      m_FrameTimes[m_FrameCount % SAMPLES] = Now - m_LastFrameEnd;
+      m_FrameCount++;
+   }
+   m_LastFrameEnd = Now;
+}
+
+void FramePacer::RecordLatency(double Seconds) {
+   m_Latencies[m_LatencyCount % SAMPLES] = Seconds;
+   m_LatencyCount++;
+}
+
+double FramePacer::GetAverageFrameTime() const {
+   return Mean(m_FrameTimes, std::min(m_FrameCount, SAMPLES));
+}
+
+double FramePacer::GetJitter() const {
+   const size_t Count = std::min(m_FrameCount, SAMPLES);
+   if (Count < 2) return 0.0;
+   const double Average = Mean(m_FrameTimes, Count);
+   double Variance = 0.0;
+   for (size_t i = 0; i < Count; i++) {
+      Variance += (m_FrameTimes[i] - Average) * (m_FrameTimes[i] - Average);
+   }
+   return std::sqrt(Variance / (Count - 1));
+}
+
+double FramePacer::GetMaxFrameTime() const {
+   const size_t Count = std::min(m_FrameCount, SAMPLES);
+   return Count == 0 ? 0.0 : *std::max_element(m_FrameTimes.begin(), m_FrameTimes.begin() + Count);
+}
+
+double FramePacer::GetAverageLatency() const {
+   return Mean(m_Latencies, std::min(m_LatencyCount, SAMPLES));
+}
+
+double FramePacer::GetSpinWindow() const {
+   return std::clamp(m_Oversleep * 1.25, MIN_SPIN, MAX_SPIN);
+}
+
+} // namespace Echo2D
@@ -0,0 +1,169 @@
+#include <engine/FrameStats.h>
+#include <engine/Log.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+
+namespace Echo2D {
+
+/// log2(SUB_BUCKETS): powers of two below this are counted exactly.
+static constexpr int SUB_BITS = std::countr_zero(FrameStats::SUB_BUCKETS);
+
+size_t FrameStats::BucketOf(uint64_t Microseconds) {
+   if (Microseconds < SUB_BUCKETS) return static_cast<size_t>(Microseconds);
+   const int Exponent = std::bit_width(Microseconds) - 1;
+   const uint64_t Mantissa = (Microseconds >> (Exponent - SUB_BITS)) - SUB_BUCKETS;
+   return static_cast<size_t>(SUB_BUCKETS + (Exponent - SUB_BITS) * SUB_BUCKETS + Mantissa);
+}
+
+uint64_t FrameStats::BucketLow(size_t Bucket) {
+   if (Bucket < SUB_BUCKETS) return Bucket;
+   const uint64_t Offset = Bucket - SUB_BUCKETS;
+   const int Shift = static_cast<int>(Offset / SUB_BUCKETS);
+   return (SUB_BUCKETS + Offset % SUB_BUCKETS) << Shift;
+}
+
+uint64_t FrameStats::BucketHigh(size_t Bucket) {
+   if (Bucket < SUB_BUCKETS) return Bucket;
+   const int Shift = static_cast<int>((Bucket - SUB_BUCKETS) / SUB_BUCKETS);
+   return BucketLow(Bucket) + (uint64_t(1) << Shift) - 1;
+}
+
+void FrameStats::Record(double Seconds) {
+   const double Clamped = std::clamp(Seconds * 1e6, 0.0, static_cast<double>(MAX_MICROSECONDS));
+   const uint64_t Microseconds = static_cast<uint64_t>(std::llround(Clamped));
+
+   m_Buckets[BucketOf(Microseconds)].fetch_add(1, std::memory_order_relaxed);
+   m_Total.fetch_add(Microseconds, std::memory_order_relaxed);
+   // Single writer: plain load/store pairs are enough
+   if (Microseconds > m_Max.load(std::memory_order_relaxed)) m_Max.store(Microseconds, std::memory_order_relaxed);
+   if (Microseconds < m_Min.load(std::memory_order_relaxed)) m_Min.store(Microseconds, std::memory_order_relaxed);
+
+   const uint64_t Written = m_Written.load(std::memory_order_relaxed);
+   m_Recent[Written % HISTORY].store(Seconds, std::memory_order_relaxed);
+   m_Written.store(Written + 1, std::memory_order_release);
+   m_Count.fetch_add(1, std::memory_order_release);
+}
+
+void FrameStats::Reset() {
+   for (auto& Bucket : m_Buckets) Bucket.store(0, std::memory_order_relaxed);
+   m_Count = 0;
+   m_Total = 0;
+   m_Max = 0;
+   m_Min = UINT64_MAX;
+   m_Written = 0;
+}
+
+double FrameStats::GetPercentile(double Percentile) const {
+   // Count from the buckets themselves, so the walk always ends inside them
+   uint64_t Total = 0;
+   for (const auto& Bucket : m_Buckets) Total += Bucket.load(std::memory_order_relaxed);
+   if (Total == 0) return 0.0;
+
+   const uint64_t Rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(Percentile, 0.0, 1.0) * Total)));
+   uint64_t Seen = 0;
+   for (size_t i = 0; i < BUCKET_COUNT; i++) {
+      Seen += m_Buckets[i].load(std::memory_order_relaxed);
+      if (Seen >= Rank) {
+         return std::min(BucketHigh(i), m_Max.load(std::memory_order_relaxed)) * 1e-6;
+      }
+   }
+   return GetMax();
+}
+
+double FrameStats::GetMax() const {
+   return m_Max.load(std::memory_order_relaxed) * 1e-6;
+}
+
+double FrameStats::GetMin() const {
+   const uint64_t Min = m_Min.load(std::memory_order_relaxed);
+   return Min == UINT64_MAX ? 0.0 : Min * 1e-6;
+}
+
+double FrameStats::GetMean() const {
+   const uint64_t Count = m_Count.load(std::memory_order_acquire);
+   return Count == 0 ? 0.0 : m_Total.load(std::memory_order_relaxed) * 1e-6 / Count;
+}
+
+uint64_t FrameStats::GetCount() const {
+   return m_Count.load(std::memory_order_acquire);
+}
+
+size_t FrameStats::GetRecent(double* Out, size_t MaxCount) const {
+   const uint64_t Written = m_Written.load(std::memory_order_acquire);
+   const size_t Count = static_cast<size_t>(std::min<uint64_t>({Written, MaxCount, HISTORY}));
+   for (size_t i = 0; i < Count; i++) {
+      Out[i] = m_Recent[(Written - Count + i) % HISTORY].load(std::memory_order_relaxed);
+   }
+   return Count;
+}
+
+double FrameStats::GetRecentMean(size_t Count) const {
+   double Recent[HISTORY];
+   const size_t Read = GetRecent(Recent, Count);
+   if (Read == 0) return 0.0;
+   double Sum = 0.0;
+   for (size_t i = 0; i < Read; i++) Sum += Recent[i];
+   return Sum / Read;
+}
+
+bool FrameStats::Export(const std::string& Path) const {
+   std::ofstream Out(Path, std::ios::trunc);
+   if (!Out) {
+      ECHO2D_LOG(ERROR) << "[FrameStats] Could not write " << Path;
+      return false;
+   }
+
+   struct Summary {
+      const char* Name;
+      double Seconds;
+   };
+   const Summary Rows[] = {
+      {"mean", GetMean()},           {"min", GetMin()},
+      {"p50", GetPercentile(0.50)},  {"p90", GetPercentile(0.90)},
+      {"p95", GetPercentile(0.95)},  {"p99", GetPercentile(0.99)},
+      {"p99.9", GetPercentile(0.999)}, {"max", GetMax()},
+   };
+
+   uint64_t Total = 0;
+   for (const auto& Bucket : m_Buckets) Total += Bucket.load(std::memory_order_relaxed);
+
+   const bool Json = Path.size() >= 5 && Path.compare(Path.size() - 5, 5, ".json") == 0;
+   if (Json) {
+      Out << "{\n  \"frames\": " << GetCount() << ",\n  \"summary_ms\": {";
+      for (size_t i = 0; i < std::size(Rows); i++) {
+         Out << (i ? ", " : "") << '"' << Rows[i].Name << "\": " << Rows[i].Seconds * 1e3;
+      }
+      Out << "},\n  \"buckets\": [";
+   } else {
+      Out << "# frames," << GetCount() << '\n';
+      for (const Summary& Row : Rows) Out << "# " << Row.Name << "_ms," << Row.Seconds * 1e3 << '\n';
+      Out << "lower_ms,upper_ms,count,cumulative\n";
+   }
+
+   uint64_t Seen = 0;
+   bool First = true;
+   for (size_t i = 0; i < BUCKET_COUNT; i++) {
+      const uint64_t Count = m_Buckets[i].load(std::memory_order_relaxed);
+      if (Count == 0) continue;
+      Seen += Count;
+      const double Low = BucketLow(i) * 1e-3;
+      const double High = (BucketHigh(i) + 1) * 1e-3;
+      const double Cumulative = static_cast<double>(Seen) / Total;
+      if (Json) {
+         Out << (First ? "\n" : ",\n") << "    {\"lower_ms\": " << Low << ", \"upper_ms\": " << High
+             << ", \"count\": " << Count << ", \"cumulative\": " << Cumulative << '}';
+      } else {
+         Out << Low << ',' << High << ',' << Count << ',' << Cumulative << '\n';
+      }
+      First = false;
+   }
+   if (Json) Out << (First ? "]\n}\n" : "\n  ]\n}\n");
+
+   ECHO2D_LOG(INFO) << "[FrameStats] Exported " << GetCount() << " frames to " << Path;
+   return static_cast<bool>(Out);
+}
+
+} // namespace Echo2D
@@ -1,92 +1,200 @@
 #include "core/core.h"
 #include <engine/InputHandler.h>
-#include "external/easylogging++.h"
+#include <engine/FramePacer.h>
+#include <engine/Log.h>
 
 namespace Echo2D {
 
+bool InputQueue::Push(const InputEvent& Event) {
+   const size_t Tail = m_Tail.load(std::memory_order_relaxed);
+   if (Tail - m_Head.load(std::memory_order_acquire) == CAPACITY) {
+      m_Dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+   m_Events[Tail & (CAPACITY - 1)] = Event;
+   m_Tail.store(Tail + 1, std::memory_order_release);
+   return true;
+}
+
+bool InputQueue::Pop(InputEvent& Event) {
+   const size_t Head = m_Head.load(std::memory_order_relaxed);
+   if (Head == m_Tail.load(std::memory_order_acquire)) return false;
+   Event = m_Events[Head & (CAPACITY - 1)];
+   m_Head.store(Head + 1, std::memory_order_release);
+   return true;
+}
+
+void Input::Push(const InputEvent& Event) {
+   GetInstance().m_Queue.Push(Event);
+}
+
+const InputSnapshot& Input::Update() {
+   auto& instance = GetInstance();
+   instance.m_Pending.clear();
+   InputEvent Event;
+   while (instance.m_Queue.Pop(Event)) instance.m_Pending.push_back(Event);
+
+   const uint64_t Dropped = instance.m_Queue.GetDroppedCount();
+   if (Dropped != instance.m_ReportedDrops) {
+      ECHO2D_LOG(WARNING) << "[Input] Event queue overflowed; " << Dropped - instance.m_ReportedDrops << " events dropped.";
+      instance.m_ReportedDrops = Dropped;
+   }
+   return instance.Build(instance.m_Pending.data(), instance.m_Pending.size(), FramePacer::Now());
+}
+
+const InputSnapshot& Input::Update(const InputEvent* Events, size_t Count, double Time) {
+   auto& instance = GetInstance();
+   // Live events are discarded so they cannot leak into a replay
+   InputEvent Ignored;
+   while (instance.m_Queue.Pop(Ignored)) {}
+   return instance.Build(Events, Count, Time);
+}
+
+const InputSnapshot& Input::Build(const InputEvent* Events, size_t Count, double Time) {
+   InputSnapshot& Snapshot = m_Snapshot;
+
+   // Down state carries over; edges, motion and scrolling start afresh every frame
+   Snapshot.m_KeysPressed.reset();
+   Snapshot.m_KeysReleased.reset();
+   Snapshot.m_ButtonsPressed.reset();
+   Snapshot.m_ButtonsReleased.reset();
+   Snapshot.m_MouseDelta = {0.0f, 0.0f};
+   Snapshot.m_Scroll = {0.0f, 0.0f};
+   Snapshot.m_Events.assign(Events, Events + Count);
+
+   for (size_t i = 0; i < Count; i++) {
+      const InputEvent& Event = Events[i];
+      switch (Event.Type) {
+      case InputEventType::Key:
+         if (Event.Code < 0 || Event.Code >= KEY_COUNT) break;
+         if (Event.Action == GLFW_PRESS) {
+            Snapshot.m_KeysDown.set(Event.Code);
+            Snapshot.m_KeysPressed.set(Event.Code);
+         } else if (Event.Action == GLFW_RELEASE) {
+            Snapshot.m_KeysDown.reset(Event.Code);
+            Snapshot.m_KeysReleased.set(Event.Code);
+         }
+         break;
+      case InputEventType::MouseButton:
+         if (Event.Code < 0 || Event.Code >= MOUSE_BUTTON_COUNT) break;
+         if (Event.Action == GLFW_PRESS) {
+            Snapshot.m_ButtonsDown.set(Event.Code);
+            Snapshot.m_ButtonsPressed.set(Event.Code);
+         } else if (Event.Action == GLFW_RELEASE) {
+            Snapshot.m_ButtonsDown.reset(Event.Code);
+            Snapshot.m_ButtonsReleased.set(Event.Code);
+            Snapshot.m_Dragging = false;
+         }
+         break;
+      case InputEventType::MouseMove: {
+         const glm::vec2 Position(Event.X, Event.Y);
+         // The first position has nothing to be measured against
+         if (Snapshot.m_HasMousePosition) {
+            Snapshot.m_MouseDelta += Position - Snapshot.m_MousePosition;
+         }
+         Snapshot.m_MousePosition = Position;
+         Snapshot.m_HasMousePosition = true;
+         Snapshot.m_Dragging = Snapshot.m_ButtonsDown.any();
+         break;
+      }
+      case InputEventType::Scroll:
+         Snapshot.m_Scroll += glm::vec2(Event.X, Event.Y);
+         break;
+      }
+   }
+
+   Snapshot.m_Time = Time;
+   Snapshot.m_Frame++;
+   return Snapshot;
+}
+
+const InputSnapshot& Input::GetSnapshot() {
+   return GetInstance().m_Snapshot;
+}
+
+uint64_t Input::GetDroppedCount() {
+   return GetInstance().m_Queue.GetDroppedCount();
+}
+
 bool KeyListener::IsKeyPressed(int Key) {
-   // Return current key state from the singleton instance
-   return GetInstance().m_Keys[Key];
+   // Read from the frame's snapshot, so replayed input drives it too
+   return Input::GetSnapshot().IsKeyDown(Key);
 }
 
 void KeyListener::KeyCallback(GLFWwindow* Window, int Key, int Scancode, int Action, int Mods) {
-   if (Action == GLFW_PRESS) {
-      GetInstance().m_Keys[Key] = true;
-   } else if (Action == GLFW_RELEASE) {
-      GetInstance().m_Keys[Key] = false;
-   }
+   // GLFW_KEY_UNKNOWN (-1) has no slot
+   if (Key < 0 || Key >= KEY_COUNT) return;
+
+   InputEvent Event;
+   Event.Time = FramePacer::Now();
+   Event.Type = InputEventType::Key;
+   Event.Code = static_cast<int16_t>(Key);
+   Event.Action = static_cast<int8_t>(Action);
+   Event.Mods = static_cast<uint8_t>(Mods);
+   Input::Push(Event);
 }
 
 bool MouseListener::IsMouseButtonDown(int MouseButton) {
-   // Only check for valid mouse buttons (0–2)
-   return (MouseButton < 3) ? GetInstance().m_MouseButtons[MouseButton] : false;
+   return Input::GetSnapshot().IsButtonDown(MouseButton);
 }
 
 bool MouseListener::GetIsDragging() {
-   return GetInstance().m_IsDragging;
+   return Input::GetSnapshot().IsDragging();
 }
 
 void MouseListener::MousePosCallback(GLFWwindow* Window, double PosX, double PosY) {
-   auto& instance = GetInstance();
-
-   // Save previous position for delta calculation
-   instance.m_LastPosX = instance.m_PosX;
-   instance.m_LastPosY = instance.m_PosY;
-
-   // Update to new position
-   instance.m_PosX = PosX;
-   instance.m_PosY = PosY;
-
-   // Determine if dragging (any button held)
-   instance.m_IsDragging =
-      instance.m_MouseButtons[0] ||
-      instance.m_MouseButtons[1] ||
-      instance.m_MouseButtons[2];
+   InputEvent Event;
+   Event.Time = FramePacer::Now();
+   Event.Type = InputEventType::MouseMove;
+   Event.X = static_cast<float>(PosX);
+   Event.Y = static_cast<float>(PosY);
+   Input::Push(Event);
 }
 
 void MouseListener::MouseButtonCallback(GLFWwindow* Window, int Button, int Action, int Mods) {
-   auto& instance = GetInstance();
-
-   if (Button < 3) {
-      if (Action == GLFW_PRESS) {
-         instance.m_MouseButtons[Button] = true;
-      } else if (Action == GLFW_RELEASE) {
-         instance.m_MouseButtons[Button] = false;
-         instance.m_IsDragging = false;
-      }
-   }
+   if (Button < 0 || Button >= MOUSE_BUTTON_COUNT) return;
+
+   InputEvent Event;
+   Event.Time = FramePacer::Now();
+   Event.Type = InputEventType::MouseButton;
+   Event.Code = static_cast<int16_t>(Button);
+   Event.Action = static_cast<int8_t>(Action);
+   Event.Mods = static_cast<uint8_t>(Mods);
+   Input::Push(Event);
 }
 
 void MouseListener::ScrollCallback(GLFWwindow* Window, double ScrollX, double ScrollY) {
-   auto& instance = GetInstance();
-   instance.m_ScrollX = ScrollX;
-   instance.m_ScrollY = ScrollY;
+   InputEvent Event;
+   Event.Time = FramePacer::Now();
+   Event.Type = InputEventType::Scroll;
+   Event.X = static_cast<float>(ScrollX);
+   Event.Y = static_cast<float>(ScrollY);
+   Input::Push(Event);
 }
 
 float MouseListener::GetX() {
-   return static_cast<float>(GetInstance().m_PosX);
+   return Input::GetSnapshot().GetMousePosition().x;
 }
 
 float MouseListener::GetY() {
-   return static_cast<float>(GetInstance().m_PosY);
+   return Input::GetSnapshot().GetMousePosition().y;
 }
 
 float MouseListener::GetScrollX() {
-   return static_cast<float>(GetInstance().m_ScrollX);
+   return Input::GetSnapshot().GetScroll().x;
 }
 
 float MouseListener::GetScrollY() {
-   return static_cast<float>(GetInstance().m_ScrollY);
+   return Input::GetSnapshot().GetScroll().y;
 }
 
 float MouseListener::GetDx() {
-   // Delta X = last frame X - current X
-   return static_cast<float>(GetInstance().m_LastPosX - GetInstance().m_PosX);
+   // Summed over every move of the frame, so the callback order no longer matters
+   return -Input::GetSnapshot().GetMouseDelta().x;
 }
 
 float MouseListener::GetDy() {
-   // Delta Y = last frame Y - current Y
-   return static_cast<float>(GetInstance().m_LastPosY - GetInstance().m_PosY);
+   return -Input::GetSnapshot().GetMouseDelta().y;
 }
 
 void InputHandler::Init(GLFWwindow* Window) {
@@ -96,7 +204,7 @@ void InputHandler::Init(GLFWwindow* Window) {
    glfwSetScrollCallback(Window, MouseListener::ScrollCallback);
    glfwSetCursorPosCallback(Window, MouseListener::MousePosCallback);
 
-   LOG(INFO) << "[InputHandler] Initialized input callbacks for GLFW window.";
+   ECHO2D_LOG(INFO) << "[InputHandler] Initialized input callbacks for GLFW window.";
 }
 
 } // namespace Echo2D
@@ -0,0 +1,152 @@
+#include <core/core.h>
+#include <engine/InputRecording.h>
+#include <engine/Log.h>
+
+#include <cstring>
+
+namespace Echo2D {
+
+/// Buffered bytes that trigger a write to the file.
+static constexpr size_t FLUSH_SIZE = 64 * 1024;
+
+/// Serialized size of one InputEvent.
+static constexpr size_t EVENT_SIZE = 8 + 1 + 1 + 1 + 2 + 4 + 4;
+
+InputRecorder::~InputRecorder() {
+   Close();
+}
+
+bool InputRecorder::Open(const std::string& Path) {
+   Close();
+   m_File.open(Path, std::ios::binary | std::ios::trunc);
+   if (!m_File) {
+      ECHO2D_LOG(ERROR) << "[InputRecorder] Could not create " << Path;
+      return false;
+   }
+   m_Path = Path;
+   m_Frames = 0;
+   m_Failed = false;
+   m_Buffer.clear();
+   m_Buffer.append(MAGIC, sizeof(MAGIC));
+   m_Buffer.append(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+   ECHO2D_LOG(INFO) << "[InputRecorder] Recording input to " << Path;
+   return true;
+}
+
+void InputRecorder::Record(double DeltaTime, const InputSnapshot& Snapshot) {
+   if (!m_File.is_open()) return;
+   auto write = [this](const void* Data, size_t Size) { m_Buffer.append(static_cast<const char*>(Data), Size); };
+
+   const double Time = Snapshot.GetTime();
+   const std::vector<InputEvent>& Events = Snapshot.GetEvents();
+   const uint32_t Count = static_cast<uint32_t>(Events.size());
+   write(&DeltaTime, sizeof(DeltaTime));
+   write(&Time, sizeof(Time));
+   write(&Count, sizeof(Count));
+   for (const InputEvent& Event : Events) {
+      write(&Event.Time, sizeof(Event.Time));
+      write(&Event.Type, sizeof(Event.Type));
+      write(&Event.Action, sizeof(Event.Action));
+      write(&Event.Mods, sizeof(Event.Mods));
+      write(&Event.Code, sizeof(Event.Code));
+      write(&Event.X, sizeof(Event.X));
+      write(&Event.Y, sizeof(Event.Y));
+   }
+   m_Frames++;
+
+   if (m_Buffer.size() >= FLUSH_SIZE) Flush();
+}
+
+void InputRecorder::Flush() {
+   if (!m_File.write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()))) m_Failed = true;
+   m_Buffer.clear();
+}
+
+bool InputRecorder::Close() {
+   if (!m_File.is_open()) return !m_Failed;
+   Flush();
+   m_File.close();
+   if (m_Failed || m_File.fail()) {
+      ECHO2D_LOG(ERROR) << "[InputRecorder] Failed to write " << m_Path;
+      m_Failed = true;
+      return false;
+   }
+   ECHO2D_LOG(INFO) << "[InputRecorder] Recorded " << m_Frames << " frames to " << m_Path;
+   return true;
+}
+
+bool InputReplay::Load(const std::string& Path) {
+   m_DeltaTimes.clear();
+   m_Times.clear();
+   m_FirstEvent.assign(1, 0);
+   m_Events.clear();
+   m_Position = 0;
+
+   std::ifstream File(Path, std::ios::binary | std::ios::ate);
+   if (!File) {
+      ECHO2D_LOG(ERROR) << "[InputReplay] Could not open " << Path;
+      return false;
+   }
+   std::vector<unsigned char> Buffer(static_cast<size_t>(File.tellg()));
+   File.seekg(0);
+   if (!File.read(reinterpret_cast<char*>(Buffer.data()), static_cast<std::streamsize>(Buffer.size()))) {
+      ECHO2D_LOG(ERROR) << "[InputReplay] Could not read " << Path;
+      return false;
+   }
+
+   size_t Offset = 0;
+   auto read = [&](void* Data, size_t Size) {
+      if (Offset + Size > Buffer.size()) return false;
+      std::memcpy(Data, Buffer.data() + Offset, Size);
+      Offset += Size;
+      return true;
+   };
+
+   char Magic[sizeof(InputRecorder::MAGIC)];
+   uint32_t Version;
+   if (!read(Magic, sizeof(Magic)) || std::memcmp(Magic, InputRecorder::MAGIC, sizeof(Magic)) != 0 ||
+       !read(&Version, sizeof(Version)) || Version != InputRecorder::VERSION) {
+      ECHO2D_LOG(ERROR) << "[InputReplay] " << Path << " is not an input recording of version " << InputRecorder::VERSION;
+      return false;
+   }
+
+   while (Offset < Buffer.size()) {
+      double DeltaTime, Time;
+      uint32_t Count;
+      if (!read(&DeltaTime, sizeof(DeltaTime)) || !read(&Time, sizeof(Time)) || !read(&Count, sizeof(Count)) ||
+          Count > (Buffer.size() - Offset) / EVENT_SIZE) {
+         ECHO2D_LOG(ERROR) << "[InputReplay] " << Path << " is truncated after " << m_DeltaTimes.size() << " frames";
+         return false;
+      }
+      for (uint32_t i = 0; i < Count; i++) {
+         InputEvent Event;
+         read(&Event.Time, sizeof(Event.Time));
+         read(&Event.Type, sizeof(Event.Type));
+         read(&Event.Action, sizeof(Event.Action));
+         read(&Event.Mods, sizeof(Event.Mods));
+         read(&Event.Code, sizeof(Event.Code));
+         read(&Event.X, sizeof(Event.X));
+         read(&Event.Y, sizeof(Event.Y));
+         m_Events.push_back(Event);
+      }
+      m_DeltaTimes.push_back(DeltaTime);
+      m_Times.push_back(Time);
+      m_FirstEvent.push_back(m_Events.size());
+   }
+
+   ECHO2D_LOG(INFO) << "[InputReplay] Loaded " << m_DeltaTimes.size() << " frames and " << m_Events.size()
+             << " events from " << Path;
+   return true;
+}
+
+bool InputReplay::Next(double& DeltaTime, double& Time, const InputEvent*& Events, size_t& Count) {
+   if (IsFinished()) return false;
+   DeltaTime = m_DeltaTimes[m_Position];
+   Time = m_Times[m_Position];
+   Events = m_Events.data() + m_FirstEvent[m_Position];
+   Count = m_FirstEvent[m_Position + 1] - m_FirstEvent[m_Position];
+   m_Position++;
+   return true;
+}
+
+} // namespace Echo2D
@@ -0,0 +1,197 @@
+#include <core/core.h>
+#include <engine/JobSystem.h>
+#include <engine/Log.h>
+
+#include <algorithm>
+
+namespace Echo2D {
+
+/// Index of the calling thread's queue: workers own theirs, every other thread shares [0].
+static thread_local size_t t_QueueIndex = 0;
+
+void JobSystem::Start(unsigned Workers) {
+   auto& Jobs = GetInstance();
+   if (Jobs.m_Running) return;
+
+   if (Workers == 0) {
+      const unsigned Hardware = std::thread::hardware_concurrency();
+      Workers = Hardware > 1 ? Hardware - 1 : 1;
+   }
+
+   Jobs.m_MainThread = std::this_thread::get_id();
+   Jobs.m_Queues.clear();
+   for (unsigned i = 0; i <= Workers; i++) {
+      Jobs.m_Queues.push_back(std::make_unique<Queue>());
+   }
+   Jobs.m_Running = true;
+   for (unsigned i = 1; i <= Workers; i++) {
+      Jobs.m_Threads.emplace_back(&JobSystem::WorkerLoop, &Jobs, i);
+   }
+   ECHO2D_LOG(INFO) << "[JobSystem] Started " << Workers << " worker threads.";
+}
+
+void JobSystem::Shutdown() {
+   auto& Jobs = GetInstance();
+   if (!Jobs.m_Running) return;
+
+   // Finish queued work first, so nobody waits on a counter forever
+   while (Jobs.TryRunOne()) {}
+
+   {
+      std::lock_guard<std::mutex> Lock(Jobs.m_SleepMutex);
+      Jobs.m_Running = false;
+   }
+   Jobs.m_Wake.notify_all();
+   for (std::thread& Thread : Jobs.m_Threads) {
+      Thread.join();
+   }
+   Jobs.m_Threads.clear();
+
+   // Jobs queued by the last running jobs
+   while (Jobs.TryRunOne()) {}
+   Jobs.m_Queues.clear();
+}
+
+void JobSystem::Run(Job Fn, JobCounter* Done, JobCounter* After) {
+   auto& Jobs = GetInstance();
+   if (!Jobs.m_Running) Start();
+   if (Done) Done->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+   if (After) {
+      std::lock_guard<std::mutex> Lock(After->m_Mutex);
+      if (After->m_Pending.load(std::memory_order_acquire) != 0) {
+         After->m_Continuations.push_back({std::move(Fn), Done});
+         return;
+      }
+   }
+   Jobs.Push({std::move(Fn), Done});
+}
+
+void JobSystem::Push(Task Item) {
+   Queue& Own = *m_Queues[std::min(t_QueueIndex, m_Queues.size() - 1)];
+   {
+      std::lock_guard<std::mutex> Lock(Own.Mutex);
+      Own.Tasks.push_back(std::move(Item));
+   }
+   m_Stealable.fetch_add(1, std::memory_order_release);
+
+   // Taking the lock orders this against a worker deciding to sleep
+   { std::lock_guard<std::mutex> Lock(m_SleepMutex); }
+   m_Wake.notify_one();
+}
+
+/**
+ * @brief Runs one queued job: the newest of the caller's own queue, else the oldest stolen from another.
+ * @return false if no job was available.
+ */
+bool JobSystem::TryRunOne() {
+   Task Item;
+   bool Found = false;
+
+   const size_t Count = m_Queues.size();
+   if (Count == 0 || m_Stealable.load(std::memory_order_acquire) == 0) return false;
+
+   const size_t Own = std::min(t_QueueIndex, Count - 1);
+   {
+      Queue& Local = *m_Queues[Own];
+      std::lock_guard<std::mutex> Lock(Local.Mutex);
+      if (!Local.Tasks.empty()) {
+         Item = std::move(Local.Tasks.back());
+         Local.Tasks.pop_back();
+         Found = true;
+      }
+   }
+   for (size_t i = 1; !Found && i < Count; i++) {
+      Queue& Victim = *m_Queues[(Own + i) % Count];
+      std::lock_guard<std::mutex> Lock(Victim.Mutex);
+      if (!Victim.Tasks.empty()) {
+         Item = std::move(Victim.Tasks.front());
+         Victim.Tasks.pop_front();
+         Found = true;
+      }
+   }
+   if (!Found) return false;
+
+   m_Stealable.fetch_sub(1, std::memory_order_relaxed);
+   Execute(Item);
+   return true;
+}
+
+/**
+ * @brief Runs a job and signals its counter, releasing the jobs chained after it.
+ */
+void JobSystem::Execute(Task& Item) {
+   Item.Fn();
+   if (!Item.Done) return;
+
+   std::vector<JobCounter::Deferred> Released;
+   {
+      // The waiter takes this lock before returning, so the counter outlives it
+      std::lock_guard<std::mutex> Lock(Item.Done->m_Mutex);
+      if (Item.Done->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+         Released.swap(Item.Done->m_Continuations);
+      }
+   }
+   for (JobCounter::Deferred& Next : Released) {
+      Push({std::move(Next.Fn), Next.Done});
+   }
+}
+
+void JobSystem::Wait(JobCounter& Counter) {
+   auto& Jobs = GetInstance();
+   while (!Counter.IsDone()) {
+      if (!Jobs.TryRunOne()) std::this_thread::yield();
+   }
+   std::lock_guard<std::mutex> Lock(Counter.m_Mutex);
+}
+
+void JobSystem::ParallelFor(size_t Begin, size_t End, size_t Grain,
+                            const std::function<void(size_t, size_t)>& Body) {
+   if (End <= Begin) return;
+   auto& Jobs = GetInstance();
+   if (!Jobs.m_Running) Start();
+
+   // A few blocks per thread, so stealing can even out uneven blocks
+   const size_t Threads = Jobs.m_Queues.size();
+   const size_t Blocks = std::min((End - Begin + std::max<size_t>(Grain, 1) - 1) / std::max<size_t>(Grain, 1),
+                                  Threads * 4);
+   if (Blocks <= 1) {
+      Body(Begin, End);
+      return;
+   }
+
+   const size_t Step = (End - Begin + Blocks - 1) / Blocks;
+   JobCounter Counter;
+   for (size_t First = Begin + Step; First < End; First += Step) {
+      const size_t Last = std::min(First + Step, End);
+      Run([&Body, First, Last]() { Body(First, Last); }, &Counter);
+   }
+   Body(Begin, std::min(Begin + Step, End));
+   Wait(Counter);
+}
+
+unsigned JobSystem::GetWorkerCount() {
+   return static_cast<unsigned>(GetInstance().m_Threads.size());
+}
+
+bool JobSystem::IsMainThread() {
+   auto& Jobs = GetInstance();
+   return !Jobs.m_Running || std::this_thread::get_id() == Jobs.m_MainThread;
+}
+
+void JobSystem::WorkerLoop(size_t Index) {
+   t_QueueIndex = Index;
+   while (true) {
+      if (TryRunOne()) continue;
+
+      std::unique_lock<std::mutex> Lock(m_SleepMutex);
+      m_Wake.wait(Lock, [this] { return !m_Running || m_Stealable.load(std::memory_order_acquire) > 0; });
+      if (!m_Running) return;
+   }
+}
+
+JobSystem::~JobSystem() {
+   Shutdown();
+}
+
+} // namespace Echo2D
@@ -0,0 +1,247 @@
+#include <engine/Log.h>
+#include "external/easylogging++.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+
+namespace Echo2D {
+
+/// Writer sleep when the queue is empty, bounding how late a message is written.
+static constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(2);
+
+/**
+ * @brief Stream buffer over a fixed array, so formatting a message never allocates.
+ *
+ * Output past the end is discarded and the message marked as truncated.
+ */
+class LogBuffer : public std::streambuf {
+public:
+   LogBuffer() { Reset(); }
+
+   void Reset() {
+      setp(m_Text, m_Text + LogQueue::MESSAGE_SIZE - 1);
+      m_Truncated = false;
+   }
+
+   /// @return The message, terminated, with "..." at the end if it did not fit.
+   const char* Finish(size_t& Length) {
+      Length = static_cast<size_t>(pptr() - m_Text);
+      if (m_Truncated) std::memcpy(m_Text + Length - 3, "...", 3);
+      m_Text[Length] = '\0';
+      return m_Text;
+   }
+
+protected:
+   int_type overflow(int_type Character) override {
+      m_Truncated = true;
+      return traits_type::not_eof(Character);
+   }
+
+private:
+   char m_Text[LogQueue::MESSAGE_SIZE];
+   bool m_Truncated = false;
+};
+
+struct LogFormatter {
+   LogBuffer Buffer;
+   std::ostream Stream{&Buffer};
+
+   ~LogFormatter();
+};
+
+/// Set once the thread's formatter is destroyed; trivially destructible, so it outlives it.
+static thread_local bool t_FormatterGone = false;
+
+LogFormatter::~LogFormatter() {
+   t_FormatterGone = true;
+}
+
+/**
+ * @brief The calling thread's formatter.
+ *
+ * The main thread's thread_local objects are destroyed before its statics,
+ * so destructors of static objects that log get a shared formatter that is
+ * never destroyed. Static teardown runs on one thread, so sharing it is safe.
+ */
+static LogFormatter& GetFormatter() {
+   if (!t_FormatterGone) {
+      static thread_local LogFormatter Formatter;
+      return Formatter;
+   }
+   static LogFormatter* Teardown = new LogFormatter;
+   return *Teardown;
+}
+
+static int64_t NowNanoseconds() {
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+LogQueue::LogQueue() {
+   for (size_t i = 0; i < CAPACITY; i++) m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LogQueue::Push(LogLevel Level, const char* Text, size_t Length) {
+   size_t Tail = m_Tail.load(std::memory_order_relaxed);
+   Slot* Claimed;
+   for (;;) {
+      Claimed = &m_Slots[Tail & (CAPACITY - 1)];
+      const size_t Sequence = Claimed->Sequence.load(std::memory_order_acquire);
+      if (Sequence == Tail) {
+         if (m_Tail.compare_exchange_weak(Tail, Tail + 1, std::memory_order_relaxed)) break;
+      } else if (Sequence < Tail + 1) {
+         return false; // Still holds the message from one lap ago
+      } else {
+         Tail = m_Tail.load(std::memory_order_relaxed);
+      }
+   }
+
+   Length = std::min(Length, MESSAGE_SIZE - 1);
+   Claimed->Message.Level = Level;
+   std::memcpy(Claimed->Message.Text, Text, Length);
+   Claimed->Message.Text[Length] = '\0';
+   Claimed->Sequence.store(Tail + 1, std::memory_order_release);
+   return true;
+}
+
+bool LogQueue::Pop(Record& Out) {
+   const size_t Head = m_Head.load(std::memory_order_relaxed);
+   Slot& Next = m_Slots[Head & (CAPACITY - 1)];
+   if (Next.Sequence.load(std::memory_order_acquire) != Head + 1) return false;
+   Out.Level = Next.Message.Level;
+   std::strcpy(Out.Text, Next.Message.Text);
+   Next.Sequence.store(Head + CAPACITY, std::memory_order_release);
+   m_Head.store(Head + 1, std::memory_order_release);
+   return true;
+}
+
+LogLimiter::LogLimiter(double Seconds) : m_Interval(static_cast<int64_t>(Seconds * 1e9)) {}
+
+bool LogLimiter::Allow() {
+   const int64_t Now = NowNanoseconds();
+   int64_t Next = m_Next.load(std::memory_order_relaxed);
+   if (Now < Next || !m_Next.compare_exchange_strong(Next, Now + m_Interval, std::memory_order_relaxed)) {
+      m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+   return true;
+}
+
+LogMessage::LogMessage(LogLevel Level, uint64_t Suppressed)
+   : m_Level(Level), m_Suppressed(Suppressed), m_Formatter(&GetFormatter()) {
+   m_Formatter->Buffer.Reset();
+}
+
+LogMessage::~LogMessage() {
+   if (m_Suppressed > 0) m_Formatter->Stream << " (" << m_Suppressed << " similar messages suppressed)";
+   size_t Length;
+   const char* Text = m_Formatter->Buffer.Finish(Length);
+   Log::Write(m_Level, Text, Length);
+}
+
+std::ostream& LogMessage::Stream() {
+   return m_Formatter->Stream;
+}
+
+Log::~Log() {
+   Stop();
+}
+
+void Log::Start() {
+   auto& Logger = GetInstance();
+   if (Logger.m_Active) return;
+   Logger.m_Stopping = false;
+   Logger.m_Thread = std::thread(&Log::WriterLoop, &Logger);
+   Logger.m_Active = true;
+}
+
+void Log::Stop() {
+   auto& Logger = GetInstance();
+   if (!Logger.m_Active) return;
+   Logger.m_Stopping = true;
+   Logger.m_Thread.join();
+   Logger.m_Active = false;
+
+   // Messages pushed while the writer was finishing
+   Logger.Drain();
+}
+
+void Log::Flush() {
+   auto& Logger = GetInstance();
+   const size_t Target = Logger.m_Queue.GetPushed();
+   while (Logger.m_Active && Logger.m_Queue.GetPopped() < Target) {
+      std::this_thread::yield();
+   }
+}
+
+void Log::SetLevel(LogLevel Level) {
+   GetInstance().m_Level.store(std::min(Level, LogLevel::Error), std::memory_order_relaxed);
+}
+
+LogLevel Log::GetLevel() {
+   return GetInstance().m_Level.load(std::memory_order_relaxed);
+}
+
+void Log::Write(LogLevel Level, const char* Text, size_t Length) {
+   auto& Logger = GetInstance();
+   if (Level == LogLevel::Fatal) {
+      Flush();
+      Emit(Level, Text);
+      return;
+   }
+   if (!Logger.m_Active) {
+      Emit(Level, Text);
+      return;
+   }
+
+   while (!Logger.m_Queue.Push(Level, Text, Length)) {
+      if (Level < LogLevel::Error) {
+         Logger.m_Dropped.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+      std::this_thread::yield();
+   }
+}
+
+uint64_t Log::GetDroppedCount() {
+   return GetInstance().m_Dropped.load(std::memory_order_relaxed);
+}
+
+void Log::WriterLoop() {
+   while (!m_Stopping.load(std::memory_order_acquire)) {
+      if (!Drain()) std::this_thread::sleep_for(WRITE_INTERVAL);
+   }
+   Drain();
+}
+
+bool Log::Drain() {
+   LogQueue::Record Message;
+   bool Wrote = false;
+   while (m_Queue.Pop(Message)) {
+      Emit(Message.Level, Message.Text);
+      Wrote = true;
+   }
+
+   const uint64_t Dropped = m_Dropped.load(std::memory_order_relaxed);
+   if (Dropped != m_ReportedDrops) {
+      LOG(WARNING) << "[Log] Queue overflowed; " << Dropped - m_ReportedDrops << " messages dropped.";
+      m_ReportedDrops = Dropped;
+   }
+   return Wrote;
+}
+
+void Log::Emit(LogLevel Level, const char* Text) {
+   switch (Level) {
+   case LogLevel::Trace: LOG(TRACE) << Text; break;
+   case LogLevel::Debug: LOG(DEBUG) << Text; break;
+   case LogLevel::Info: LOG(INFO) << Text; break;
+   case LogLevel::Warning: LOG(WARNING) << Text; break;
+   case LogLevel::Error: LOG(ERROR) << Text; break;
+   case LogLevel::Fatal: LOG(FATAL) << Text; break;
+   }
+}
+
+} // namespace Echo2D
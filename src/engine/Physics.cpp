@@ -0,0 +1,672 @@
+#include <core/core.h>
+#include <engine/Physics.h>
+#include <engine/JobSystem.h>
+#include <engine/Renderer.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+namespace Echo2D {
+
+// === Tuning (pixels and seconds) ===
+
+/// Shapes closer than this get contact points, so bodies stop before they overlap.
+static constexpr float CONTACT_MARGIN = 2.0f;
+
+/// Penetration left alone, so resting contacts do not jitter.
+static constexpr float LINEAR_SLOP = 0.5f;
+
+/// Fraction of the remaining penetration pushed out per step.
+static constexpr float BAUMGARTE = 0.2f;
+
+/// Fastest speed penetration recovery may push bodies apart with.
+static constexpr float MAX_PUSH_SPEED = 300.0f;
+
+/// Slower impacts do not bounce, so resting bodies settle.
+static constexpr float RESTITUTION_THRESHOLD = 30.0f;
+
+/// Bodies slower than this count as resting.
+static constexpr float SLEEP_LINEAR_SPEED = 2.0f;
+static constexpr float SLEEP_ANGULAR_SPEED = 0.035f;
+
+/// Broadphase grid cell; about the size of a typical body.
+static constexpr float CELL_SIZE = 64.0f;
+
+static float Cross(glm::vec2 A, glm::vec2 B) { return A.x * B.y - A.y * B.x; }
+static float Dot(glm::vec2 A, glm::vec2 B) { return A.x * B.x + A.y * B.y; }
+
+/// Velocity of a point at R from the center of a body spinning at W.
+static glm::vec2 Cross(float W, glm::vec2 R) { return {-W * R.y, W * R.x}; }
+
+template <typename T> static void SwapRemove(std::vector<T>& Items, size_t Slot) {
+   Items[Slot] = std::move(Items.back());
+   Items.pop_back();
+}
+
+PhysicsWorld::PhysicsWorld() : m_Broadphase(CELL_SIZE) {}
+
+// === Bodies ===
+
+uint32_t PhysicsWorld::CreateBody(const BodyDef& Def, const Shape& Geometry) {
+   uint32_t ID;
+   if (!m_FreeIDs.empty()) {
+      ID = m_FreeIDs.back();
+      m_FreeIDs.pop_back();
+   } else {
+      ID = static_cast<uint32_t>(m_Slots.size());
+      m_Slots.push_back(INVALID);
+   }
+   const uint32_t Slot = static_cast<uint32_t>(m_IDs.size());
+   m_Slots[ID] = Slot;
+   m_IDs.push_back(ID);
+
+   float InvMass = 0.0f;
+   float InvInertia = 0.0f;
+   if (Def.Type == BodyType::Dynamic) {
+      // Zero-area shapes still need a mass to be moved by contacts
+      const float Mass = Def.Density * Geometry.GetArea();
+      InvMass = Mass > 0.0f ? 1.0f / Mass : 1.0f;
+      const float Inertia = (InvMass > 0.0f ? 1.0f / InvMass : 0.0f) * Geometry.GetUnitInertia();
+      InvInertia = Def.FixedRotation || Inertia <= 0.0f ? 0.0f : 1.0f / Inertia;
+   }
+
+   const bool Moving = Def.LinearVelocity != glm::vec2(0.0f) || Def.AngularVelocity != 0.0f;
+   m_Type.push_back(Def.Type);
+   m_Shape.push_back(Geometry);
+   m_Position.push_back(Def.Position);
+   m_Angle.push_back(Def.Angle);
+   m_LinearVelocity.push_back(Def.Type == BodyType::Static ? glm::vec2(0.0f) : Def.LinearVelocity);
+   m_AngularVelocity.push_back(Def.Type == BodyType::Static || Def.FixedRotation ? 0.0f : Def.AngularVelocity);
+   m_Force.emplace_back(0.0f);
+   m_Torque.push_back(0.0f);
+   m_InvMass.push_back(InvMass);
+   m_InvInertia.push_back(InvInertia);
+   m_Friction.push_back(std::max(Def.Friction, 0.0f));
+   m_Restitution.push_back(std::clamp(Def.Restitution, 0.0f, 1.0f));
+   m_LinearDamping.push_back(std::max(Def.LinearDamping, 0.0f));
+   m_AngularDamping.push_back(std::max(Def.AngularDamping, 0.0f));
+   m_GravityScale.push_back(Def.GravityScale);
+   m_Category.push_back(Def.Category);
+   m_Mask.push_back(Def.Mask);
+   m_UserData.push_back(Def.UserData);
+   m_Proxy.push_back(m_Broadphase.AddBox({}, ID));
+   m_SleepTime.push_back(0.0f);
+   m_Awake.push_back(Def.Type == BodyType::Dynamic || (Def.Type == BodyType::Kinematic && Moving));
+
+   UpdateProxy(Slot);
+   return ID;
+}
+
+void PhysicsWorld::DestroyBody(uint32_t Body) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+
+   // Whatever rested on the body has to fall now
+   for (const Contact& Touching : m_Contacts) {
+      if (Touching.Geometry.PointCount == 0) continue;
+      if (Touching.BodyA == Body) WakeSlot(m_Slots[Touching.BodyB]);
+      if (Touching.BodyB == Body) WakeSlot(m_Slots[Touching.BodyA]);
+   }
+   std::erase_if(m_Contacts, [Body](const Contact& C) { return C.BodyA == Body || C.BodyB == Body; });
+   m_ContactIndex.clear();
+   for (uint32_t i = 0; i < m_Contacts.size(); i++) {
+      m_ContactIndex[PairKey(m_Contacts[i].BodyA, m_Contacts[i].BodyB)] = i;
+   }
+
+   m_Broadphase.Remove(m_Proxy[Slot]);
+
+   // Keep the arrays dense: the last body moves into the freed slot
+   SwapRemove(m_IDs, Slot);
+   SwapRemove(m_Type, Slot);
+   SwapRemove(m_Shape, Slot);
+   SwapRemove(m_Position, Slot);
+   SwapRemove(m_Angle, Slot);
+   SwapRemove(m_LinearVelocity, Slot);
+   SwapRemove(m_AngularVelocity, Slot);
+   SwapRemove(m_Force, Slot);
+   SwapRemove(m_Torque, Slot);
+   SwapRemove(m_InvMass, Slot);
+   SwapRemove(m_InvInertia, Slot);
+   SwapRemove(m_Friction, Slot);
+   SwapRemove(m_Restitution, Slot);
+   SwapRemove(m_LinearDamping, Slot);
+   SwapRemove(m_AngularDamping, Slot);
+   SwapRemove(m_GravityScale, Slot);
+   SwapRemove(m_Category, Slot);
+   SwapRemove(m_Mask, Slot);
+   SwapRemove(m_UserData, Slot);
+   SwapRemove(m_Proxy, Slot);
+   SwapRemove(m_SleepTime, Slot);
+   SwapRemove(m_Awake, Slot);
+   if (Slot < m_IDs.size()) m_Slots[m_IDs[Slot]] = Slot;
+
+   m_Slots[Body] = INVALID;
+   m_FreeIDs.push_back(Body);
+}
+
+void PhysicsWorld::Clear() {
+   m_IDs.clear();
+   m_Slots.clear();
+   m_FreeIDs.clear();
+   m_Type.clear();
+   m_Shape.clear();
+   m_Position.clear();
+   m_Angle.clear();
+   m_LinearVelocity.clear();
+   m_AngularVelocity.clear();
+   m_Force.clear();
+   m_Torque.clear();
+   m_InvMass.clear();
+   m_InvInertia.clear();
+   m_Friction.clear();
+   m_Restitution.clear();
+   m_LinearDamping.clear();
+   m_AngularDamping.clear();
+   m_GravityScale.clear();
+   m_Category.clear();
+   m_Mask.clear();
+   m_UserData.clear();
+   m_Proxy.clear();
+   m_SleepTime.clear();
+   m_Awake.clear();
+   m_Broadphase.Clear();
+   m_Contacts.clear();
+   m_ContactIndex.clear();
+   m_IslandStart.clear();
+}
+
+const Shape& PhysicsWorld::GetShape(uint32_t Body) const {
+   static const Shape None;
+   return IsValid(Body) ? m_Shape[m_Slots[Body]] : None;
+}
+
+float PhysicsWorld::GetMass(uint32_t Body) const {
+   if (!IsValid(Body)) return 0.0f;
+   const float InvMass = m_InvMass[m_Slots[Body]];
+   return InvMass > 0.0f ? 1.0f / InvMass : 0.0f;
+}
+
+void PhysicsWorld::SetTransform(uint32_t Body, glm::vec2 Position, float Angle) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+   m_Position[Slot] = Position;
+   m_Angle[Slot] = Angle;
+   UpdateProxy(Slot);
+   WakeSlot(Slot);
+}
+
+void PhysicsWorld::SetLinearVelocity(uint32_t Body, glm::vec2 Velocity) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+   if (m_Type[Slot] == BodyType::Static) return;
+   m_LinearVelocity[Slot] = Velocity;
+   if (Velocity != glm::vec2(0.0f)) WakeSlot(Slot);
+}
+
+void PhysicsWorld::SetAngularVelocity(uint32_t Body, float Velocity) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+   if (m_Type[Slot] == BodyType::Static) return;
+   if (m_Type[Slot] == BodyType::Dynamic && m_InvInertia[Slot] == 0.0f) return;
+   m_AngularVelocity[Slot] = Velocity;
+   if (Velocity != 0.0f) WakeSlot(Slot);
+}
+
+void PhysicsWorld::ApplyForce(uint32_t Body, glm::vec2 Force) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+   if (m_Type[Slot] != BodyType::Dynamic) return;
+   m_Force[Slot] += Force;
+   WakeSlot(Slot);
+}
+
+void PhysicsWorld::ApplyTorque(uint32_t Body, float Torque) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+   if (m_Type[Slot] != BodyType::Dynamic) return;
+   m_Torque[Slot] += Torque;
+   WakeSlot(Slot);
+}
+
+void PhysicsWorld::ApplyImpulse(uint32_t Body, glm::vec2 Impulse, glm::vec2 Point) {
+   if (!IsValid(Body)) return;
+   const uint32_t Slot = m_Slots[Body];
+   if (m_Type[Slot] != BodyType::Dynamic) return;
+   m_LinearVelocity[Slot] += Impulse * m_InvMass[Slot];
+   m_AngularVelocity[Slot] += m_InvInertia[Slot] * Cross(Point - m_Position[Slot], Impulse);
+   WakeSlot(Slot);
+}
+
+void PhysicsWorld::Wake(uint32_t Body) {
+   if (IsValid(Body)) WakeSlot(m_Slots[Body]);
+}
+
+void PhysicsWorld::WakeSlot(uint32_t Slot) {
+   if (m_Type[Slot] == BodyType::Static) return;
+   m_Awake[Slot] = 1;
+   m_SleepTime[Slot] = 0.0f;
+}
+
+void PhysicsWorld::SetSleeping(bool Enabled) {
+   m_Sleeping = Enabled;
+   if (Enabled) return;
+   for (uint32_t Slot = 0; Slot < m_IDs.size(); Slot++) {
+      if (m_Type[Slot] == BodyType::Dynamic) WakeSlot(Slot);
+   }
+}
+
+size_t PhysicsWorld::GetAwakeCount() const {
+   return static_cast<size_t>(std::count(m_Awake.begin(), m_Awake.end(), uint8_t(1)));
+}
+
+void PhysicsWorld::QueryRegion(const AABB& Region, std::vector<uint32_t>& Out) {
+   const size_t First = Out.size();
+   m_Broadphase.QueryRegion(Region, Out);
+   for (size_t i = First; i < Out.size(); i++) Out[i] = m_Broadphase.GetUserData(Out[i]);
+}
+
+void PhysicsWorld::UpdateProxy(uint32_t Slot) {
+   AABB Bounds;
+   m_Shape[Slot].GetBounds(Pose(m_Position[Slot], m_Angle[Slot]), Bounds.Min, Bounds.Max);
+   // Half the margin on each side: bounds overlap once shapes are within the margin
+   const glm::vec2 Fat(0.5f * CONTACT_MARGIN);
+   Bounds.Min -= Fat;
+   Bounds.Max += Fat;
+
+   // Sweep over the next step's motion so fast bodies meet what lies in their way
+   const glm::vec2 Motion = m_StepTime * m_LinearVelocity[Slot];
+   Bounds.Min += glm::min(Motion, glm::vec2(0.0f));
+   Bounds.Max += glm::max(Motion, glm::vec2(0.0f));
+   m_Broadphase.MoveBox(m_Proxy[Slot], Bounds);
+}
+
+// === Simulation ===
+
+void PhysicsWorld::Step(float dt) {
+   if (dt <= 0.0f || m_IDs.empty()) return;
+   m_StepTime = dt;
+   const uint32_t Count = static_cast<uint32_t>(m_IDs.size());
+
+   for (uint32_t Slot = 0; Slot < Count; Slot++) {
+      if (m_Type[Slot] != BodyType::Dynamic || !m_Awake[Slot]) {
+         m_Force[Slot] = glm::vec2(0.0f);
+         m_Torque[Slot] = 0.0f;
+         continue;
+      }
+      glm::vec2 Velocity = m_LinearVelocity[Slot];
+      Velocity += dt * (m_Gravity * m_GravityScale[Slot] + m_Force[Slot] * m_InvMass[Slot]);
+      m_LinearVelocity[Slot] = Velocity * (1.0f / (1.0f + dt * m_LinearDamping[Slot]));
+      const float Spin = m_AngularVelocity[Slot] + dt * m_InvInertia[Slot] * m_Torque[Slot];
+      m_AngularVelocity[Slot] = Spin * (1.0f / (1.0f + dt * m_AngularDamping[Slot]));
+      m_Force[Slot] = glm::vec2(0.0f);
+      m_Torque[Slot] = 0.0f;
+   }
+
+   FindContacts();
+   BuildIslands();
+
+   const uint32_t Islands = static_cast<uint32_t>(GetIslandCount());
+   JobSystem::ParallelFor(0, Islands, 1, [this, dt](size_t First, size_t Last) {
+      for (size_t Island = First; Island < Last; Island++) SolveIsland(static_cast<uint32_t>(Island), dt);
+   });
+
+   for (uint32_t Slot = 0; Slot < Count; Slot++) {
+      if (m_Type[Slot] != BodyType::Kinematic || !m_Awake[Slot]) continue;
+      m_Position[Slot] += dt * m_LinearVelocity[Slot];
+      m_Angle[Slot] += dt * m_AngularVelocity[Slot];
+      m_Awake[Slot] = m_LinearVelocity[Slot] != glm::vec2(0.0f) || m_AngularVelocity[Slot] != 0.0f;
+      UpdateProxy(Slot);
+   }
+   for (uint32_t Slot : m_IslandBodies) UpdateProxy(Slot);
+}
+
+void PhysicsWorld::FindContacts() {
+   const std::vector<ProxyPair>& Pairs = m_Broadphase.FindPairs();
+   m_NewContacts.resize(Pairs.size());
+   m_NewValid.assign(Pairs.size(), 0);
+
+   JobSystem::ParallelFor(0, Pairs.size(), 256, [&](size_t First, size_t Last) {
+      for (size_t i = First; i < Last; i++) {
+         uint32_t A = m_Broadphase.GetUserData(Pairs[i].A);
+         uint32_t B = m_Broadphase.GetUserData(Pairs[i].B);
+         if (A > B) std::swap(A, B);
+         const uint32_t SlotA = m_Slots[A];
+         const uint32_t SlotB = m_Slots[B];
+         if (m_Type[SlotA] != BodyType::Dynamic && m_Type[SlotB] != BodyType::Dynamic) continue;
+         if (!(m_Category[SlotA] & m_Mask[SlotB]) || !(m_Category[SlotB] & m_Mask[SlotA])) continue;
+
+         const auto Previous = m_ContactIndex.find(PairKey(A, B));
+         Contact& Current = m_NewContacts[i];
+         if (!m_Awake[SlotA] && !m_Awake[SlotB]) {
+            // Nothing here moved: keep the sleeping contact as it was
+            if (Previous != m_ContactIndex.end()) {
+               Current = m_Contacts[Previous->second];
+               m_NewValid[i] = 1;
+            }
+            continue;
+         }
+
+         Current = Contact();
+         Current.BodyA = A;
+         Current.BodyB = B;
+         Current.Friction = std::sqrt(m_Friction[SlotA] * m_Friction[SlotB]);
+         Current.Restitution = std::max(m_Restitution[SlotA], m_Restitution[SlotB]);
+         // Speculative margin covers the distance the pair can close this step, so nothing tunnels
+         const glm::vec2 Closing = m_LinearVelocity[SlotB] - m_LinearVelocity[SlotA];
+         const float Margin = CONTACT_MARGIN + m_StepTime * std::sqrt(Dot(Closing, Closing));
+         Collide(m_Shape[SlotA], Pose(m_Position[SlotA], m_Angle[SlotA]), m_Shape[SlotB],
+                 Pose(m_Position[SlotB], m_Angle[SlotB]), Margin, Current.Geometry);
+         if (Current.Geometry.PointCount == 0) continue;
+
+         // Warm start: points touching the same features as last step keep their impulses
+         if (Previous != m_ContactIndex.end()) {
+            const Manifold& Old = m_Contacts[Previous->second].Geometry;
+            for (int p = 0; p < Current.Geometry.PointCount; p++) {
+               ManifoldPoint& Point = Current.Geometry.Points[p];
+               for (int q = 0; q < Old.PointCount; q++) {
+                  if (Old.Points[q].Feature != Point.Feature) continue;
+                  Point.NormalImpulse = Old.Points[q].NormalImpulse;
+                  Point.TangentImpulse = Old.Points[q].TangentImpulse;
+               }
+            }
+         }
+         m_NewValid[i] = 1;
+      }
+   });
+
+   // Pair order depends on the broadphase's job split; sorting makes the solve order repeatable
+   m_Contacts.clear();
+   for (size_t i = 0; i < m_NewContacts.size(); i++) {
+      if (m_NewValid[i]) m_Contacts.push_back(m_NewContacts[i]);
+   }
+   std::sort(m_Contacts.begin(), m_Contacts.end(), [](const Contact& Left, const Contact& Right) {
+      return PairKey(Left.BodyA, Left.BodyB) < PairKey(Right.BodyA, Right.BodyB);
+   });
+   m_ContactIndex.clear();
+   for (uint32_t i = 0; i < m_Contacts.size(); i++) {
+      m_ContactIndex[PairKey(m_Contacts[i].BodyA, m_Contacts[i].BodyB)] = i;
+   }
+}
+
+uint32_t PhysicsWorld::FindRoot(uint32_t Slot) {
+   while (m_Parent[Slot] != Slot) {
+      m_Parent[Slot] = m_Parent[m_Parent[Slot]];
+      Slot = m_Parent[Slot];
+   }
+   return Slot;
+}
+
+void PhysicsWorld::BuildIslands() {
+   const uint32_t Count = static_cast<uint32_t>(m_IDs.size());
+   m_Parent.resize(Count);
+   std::iota(m_Parent.begin(), m_Parent.end(), 0u);
+
+   // Touching dynamic bodies share an island; static and kinematic bodies never join one,
+   // but a moving kinematic body wakes what it touches
+   for (const Contact& Touching : m_Contacts) {
+      if (Touching.Geometry.PointCount == 0) continue;
+      const uint32_t SlotA = m_Slots[Touching.BodyA];
+      const uint32_t SlotB = m_Slots[Touching.BodyB];
+      if (m_Type[SlotA] != BodyType::Dynamic || m_Type[SlotB] != BodyType::Dynamic) {
+         if (m_Type[SlotA] == BodyType::Kinematic && m_Awake[SlotA]) WakeSlot(SlotB);
+         if (m_Type[SlotB] == BodyType::Kinematic && m_Awake[SlotB]) WakeSlot(SlotA);
+         continue;
+      }
+      const uint32_t RootA = FindRoot(SlotA);
+      const uint32_t RootB = FindRoot(SlotB);
+      if (RootA != RootB) m_Parent[std::max(RootA, RootB)] = std::min(RootA, RootB);
+   }
+
+   // An island is awake if any of its bodies is; then all of them are
+   m_RootAwake.assign(Count, 0);
+   for (uint32_t Slot = 0; Slot < Count; Slot++) {
+      if (m_Type[Slot] == BodyType::Dynamic && m_Awake[Slot]) m_RootAwake[FindRoot(Slot)] = 1;
+   }
+
+   // Number awake islands in slot order, then bucket bodies and contacts by island
+   uint32_t Islands = 0;
+   m_IslandOf.assign(Count, INVALID);
+   m_IslandStart.assign(1, 0);
+   for (uint32_t Slot = 0; Slot < Count; Slot++) {
+      if (m_Type[Slot] != BodyType::Dynamic) continue;
+      const uint32_t Root = FindRoot(Slot);
+      if (!m_RootAwake[Root]) continue;
+      if (m_IslandOf[Root] == INVALID) {
+         m_IslandOf[Root] = Islands++;
+         m_IslandStart.push_back(0);
+      }
+      m_IslandOf[Slot] = m_IslandOf[Root];
+      m_IslandStart[m_IslandOf[Slot] + 1]++;
+      if (!m_Awake[Slot]) WakeSlot(Slot);
+   }
+   for (uint32_t i = 0; i < Islands; i++) m_IslandStart[i + 1] += m_IslandStart[i];
+
+   m_IslandBodies.resize(m_IslandStart[Islands]);
+   std::vector<uint32_t>& Fill = m_LocalIndex; // Scratch until SolveIsland() sets it
+   Fill.assign(m_IslandStart.begin(), m_IslandStart.end() - 1);
+   for (uint32_t Slot = 0; Slot < Count; Slot++) {
+      if (m_IslandOf[Slot] != INVALID) m_IslandBodies[Fill[m_IslandOf[Slot]]++] = Slot;
+   }
+
+   auto IslandOfContact = [this](const Contact& Touching) {
+      const uint32_t SlotA = m_Slots[Touching.BodyA];
+      return m_Type[SlotA] == BodyType::Dynamic ? m_IslandOf[SlotA] : m_IslandOf[m_Slots[Touching.BodyB]];
+   };
+   m_ContactStart.assign(Islands + 1, 0);
+   for (const Contact& Touching : m_Contacts) {
+      const uint32_t Island = IslandOfContact(Touching);
+      if (Island != INVALID) m_ContactStart[Island + 1]++;
+   }
+   for (uint32_t i = 0; i < Islands; i++) m_ContactStart[i + 1] += m_ContactStart[i];
+   m_IslandContacts.resize(m_ContactStart[Islands]);
+   Fill.assign(m_ContactStart.begin(), m_ContactStart.end() - 1);
+   for (uint32_t i = 0; i < m_Contacts.size(); i++) {
+      const uint32_t Island = IslandOfContact(m_Contacts[i]);
+      if (Island != INVALID) m_IslandContacts[Fill[Island]++] = i;
+   }
+   m_LocalIndex.resize(Count);
+}
+
+void PhysicsWorld::SolveIsland(uint32_t Island, float dt) {
+   // Per worker scratch, reused across islands and steps
+   thread_local std::vector<SolverBody> Bodies;
+   thread_local std::vector<SolverContact> Constraints;
+   Bodies.clear();
+   Constraints.clear();
+
+   const uint32_t FirstBody = m_IslandStart[Island];
+   const uint32_t LastBody = m_IslandStart[Island + 1];
+   for (uint32_t i = FirstBody; i < LastBody; i++) {
+      const uint32_t Slot = m_IslandBodies[i];
+      m_LocalIndex[Slot] = i - FirstBody;
+      Bodies.push_back({m_LinearVelocity[Slot], m_AngularVelocity[Slot], m_InvMass[Slot], m_InvInertia[Slot]});
+   }
+
+   // Static and kinematic bodies may touch several islands: each contact gets its own copy
+   auto LocalBody = [&](uint32_t Slot) -> uint32_t {
+      if (m_Type[Slot] == BodyType::Dynamic) return m_LocalIndex[Slot];
+      Bodies.push_back({m_LinearVelocity[Slot], m_AngularVelocity[Slot], 0.0f, 0.0f});
+      return static_cast<uint32_t>(Bodies.size() - 1);
+   };
+
+   const float InvDt = 1.0f / dt;
+   for (uint32_t i = m_ContactStart[Island]; i < m_ContactStart[Island + 1]; i++) {
+      Contact& Touching = m_Contacts[m_IslandContacts[i]];
+      const uint32_t SlotA = m_Slots[Touching.BodyA];
+      const uint32_t SlotB = m_Slots[Touching.BodyB];
+
+      SolverContact Constraint;
+      Constraint.A = LocalBody(SlotA);
+      Constraint.B = LocalBody(SlotB);
+      Constraint.Normal = Touching.Geometry.Normal;
+      Constraint.Friction = Touching.Friction;
+      Constraint.PointCount = Touching.Geometry.PointCount;
+      Constraint.Source = &Touching;
+
+      const SolverBody& A = Bodies[Constraint.A];
+      const SolverBody& B = Bodies[Constraint.B];
+      const glm::vec2 Normal = Constraint.Normal;
+      const glm::vec2 Tangent(Normal.y, -Normal.x);
+      for (int p = 0; p < Constraint.PointCount; p++) {
+         const ManifoldPoint& Source = Touching.Geometry.Points[p];
+         SolverPoint& Point = Constraint.Points[p];
+         Point.AnchorA = Source.Position - m_Position[SlotA];
+         Point.AnchorB = Source.Position - m_Position[SlotB];
+         Point.NormalImpulse = Source.NormalImpulse;
+         Point.TangentImpulse = Source.TangentImpulse;
+
+         const float NormalA = Cross(Point.AnchorA, Normal);
+         const float NormalB = Cross(Point.AnchorB, Normal);
+         const float NormalK = A.InvMass + B.InvMass + A.InvInertia * NormalA * NormalA + B.InvInertia * NormalB * NormalB;
+         Point.NormalMass = NormalK > 0.0f ? 1.0f / NormalK : 0.0f;
+         const float TangentA = Cross(Point.AnchorA, Tangent);
+         const float TangentB = Cross(Point.AnchorB, Tangent);
+         const float TangentK = A.InvMass + B.InvMass + A.InvInertia * TangentA * TangentA + B.InvInertia * TangentB * TangentB;
+         Point.TangentMass = TangentK > 0.0f ? 1.0f / TangentK : 0.0f;
+
+         // Speculative points may approach until the gap closes; penetrating ones are pushed out gradually
+         const float Separation = Source.Separation;
+         Point.Bias = Separation > 0.0f
+                         ? -Separation * InvDt
+                         : std::min(BAUMGARTE * InvDt * std::max(-(Separation + LINEAR_SLOP), 0.0f), MAX_PUSH_SPEED);
+         const glm::vec2 Relative = B.LinearVelocity + Cross(B.AngularVelocity, Point.AnchorB) - A.LinearVelocity -
+                                    Cross(A.AngularVelocity, Point.AnchorA);
+         const float Approach = Dot(Relative, Normal);
+         if (Touching.Restitution > 0.0f && Approach < -RESTITUTION_THRESHOLD && Separation + Approach * dt < 0.0f) {
+            Point.Bias = std::max(Point.Bias, -Touching.Restitution * Approach);
+         }
+      }
+      Constraints.push_back(Constraint);
+   }
+
+   auto Apply = [&](SolverContact& Constraint, const SolverPoint& Point, glm::vec2 Impulse) {
+      SolverBody& A = Bodies[Constraint.A];
+      SolverBody& B = Bodies[Constraint.B];
+      A.LinearVelocity -= Impulse * A.InvMass;
+      A.AngularVelocity -= A.InvInertia * Cross(Point.AnchorA, Impulse);
+      B.LinearVelocity += Impulse * B.InvMass;
+      B.AngularVelocity += B.InvInertia * Cross(Point.AnchorB, Impulse);
+   };
+
+   // Warm start with last step's impulses
+   for (SolverContact& Constraint : Constraints) {
+      const glm::vec2 Tangent(Constraint.Normal.y, -Constraint.Normal.x);
+      for (int p = 0; p < Constraint.PointCount; p++) {
+         const SolverPoint& Point = Constraint.Points[p];
+         Apply(Constraint, Point, Point.NormalImpulse * Constraint.Normal + Point.TangentImpulse * Tangent);
+      }
+   }
+
+   for (int Iteration = 0; Iteration < m_Iterations; Iteration++) {
+      for (SolverContact& Constraint : Constraints) {
+         const glm::vec2 Normal = Constraint.Normal;
+         const glm::vec2 Tangent(Normal.y, -Normal.x);
+         for (int p = 0; p < Constraint.PointCount; p++) {
+            SolverPoint& Point = Constraint.Points[p];
+            const SolverBody& A = Bodies[Constraint.A];
+            const SolverBody& B = Bodies[Constraint.B];
+            const glm::vec2 Relative = B.LinearVelocity + Cross(B.AngularVelocity, Point.AnchorB) - A.LinearVelocity -
+                                       Cross(A.AngularVelocity, Point.AnchorA);
+
+            // Non-penetration: accumulated normal impulse never pulls
+            const float Delta = Point.NormalMass * (Point.Bias - Dot(Relative, Normal));
+            const float Accumulated = std::max(Point.NormalImpulse + Delta, 0.0f);
+            const float Applied = Accumulated - Point.NormalImpulse;
+            Point.NormalImpulse = Accumulated;
+            Apply(Constraint, Point, Applied * Normal);
+         }
+         for (int p = 0; p < Constraint.PointCount; p++) {
+            SolverPoint& Point = Constraint.Points[p];
+            const SolverBody& A = Bodies[Constraint.A];
+            const SolverBody& B = Bodies[Constraint.B];
+            const glm::vec2 Relative = B.LinearVelocity + Cross(B.AngularVelocity, Point.AnchorB) - A.LinearVelocity -
+                                       Cross(A.AngularVelocity, Point.AnchorA);
+
+            // Coulomb friction: bounded by the normal impulse
+            const float Limit = Constraint.Friction * Point.NormalImpulse;
+            const float Delta = -Point.TangentMass * Dot(Relative, Tangent);
+            const float Accumulated = std::clamp(Point.TangentImpulse + Delta, -Limit, Limit);
+            const float Applied = Accumulated - Point.TangentImpulse;
+            Point.TangentImpulse = Accumulated;
+            Apply(Constraint, Point, Applied * Tangent);
+         }
+      }
+   }
+
+   for (const SolverContact& Constraint : Constraints) {
+      for (int p = 0; p < Constraint.PointCount; p++) {
+         Constraint.Source->Geometry.Points[p].NormalImpulse = Constraint.Points[p].NormalImpulse;
+         Constraint.Source->Geometry.Points[p].TangentImpulse = Constraint.Points[p].TangentImpulse;
+      }
+   }
+
+   // Integrate positions and let the island sleep once all of it has rested long enough
+   float Rested = FLT_MAX;
+   for (uint32_t i = FirstBody; i < LastBody; i++) {
+      const uint32_t Slot = m_IslandBodies[i];
+      const SolverBody& Body = Bodies[i - FirstBody];
+      m_LinearVelocity[Slot] = Body.LinearVelocity;
+      m_AngularVelocity[Slot] = Body.AngularVelocity;
+      m_Position[Slot] += dt * Body.LinearVelocity;
+      m_Angle[Slot] += dt * Body.AngularVelocity;
+
+      const bool Still = Dot(Body.LinearVelocity, Body.LinearVelocity) <= SLEEP_LINEAR_SPEED * SLEEP_LINEAR_SPEED &&
+                         Body.AngularVelocity * Body.AngularVelocity <= SLEEP_ANGULAR_SPEED * SLEEP_ANGULAR_SPEED;
+      m_SleepTime[Slot] = Still ? m_SleepTime[Slot] + dt : 0.0f;
+      Rested = std::min(Rested, m_SleepTime[Slot]);
+   }
+
+   if (m_Sleeping && Rested >= TIME_TO_SLEEP) {
+      for (uint32_t i = FirstBody; i < LastBody; i++) {
+         const uint32_t Slot = m_IslandBodies[i];
+         m_Awake[Slot] = 0;
+         m_LinearVelocity[Slot] = glm::vec2(0.0f);
+         m_AngularVelocity[Slot] = 0.0f;
+      }
+   }
+}
+
+// === Debug Draw ===
+
+void PhysicsWorld::DebugDraw() const {
+   constexpr float LINE_WIDTH = 1.5f;
+   constexpr int CIRCLE_SEGMENTS = 24;
+
+   for (uint32_t Slot = 0; Slot < m_IDs.size(); Slot++) {
+      glm::vec4 Color = GREEN;
+      if (m_Type[Slot] == BodyType::Static) Color = GREY;
+      else if (m_Type[Slot] == BodyType::Kinematic) Color = LIGHT_BLUE;
+      else if (!m_Awake[Slot]) Color = DARK_GREEN;
+
+      const Pose At(m_Position[Slot], m_Angle[Slot]);
+      const Shape& Geometry = m_Shape[Slot];
+      if (Geometry.Kind == Shape::Type::Circle) {
+         glm::vec2 Previous = At.Apply({Geometry.Radius, 0.0f});
+         for (int i = 1; i <= CIRCLE_SEGMENTS; i++) {
+            const float Angle = 6.28318531f * i / CIRCLE_SEGMENTS;
+            const glm::vec2 Next = At.Apply(Geometry.Radius * glm::vec2(std::cos(Angle), std::sin(Angle)));
+            Renderer::DrawLine(Previous, Next, LINE_WIDTH, Color);
+            Previous = Next;
+         }
+         // Spoke to show the rotation
+         Renderer::DrawLine(At.Position, At.Apply({Geometry.Radius, 0.0f}), LINE_WIDTH, Color);
+      } else {
+         for (int i = 0; i < Geometry.Count; i++) {
+            Renderer::DrawLine(At.Apply(Geometry.Vertices[i]), At.Apply(Geometry.Vertices[(i + 1) % Geometry.Count]),
+                               LINE_WIDTH, Color);
+         }
+      }
+   }
+
+   for (const Contact& Touching : m_Contacts) {
+      for (int p = 0; p < Touching.Geometry.PointCount; p++) {
+         const glm::vec2 Point = Touching.Geometry.Points[p].Position;
+         Renderer::DrawLine(Point - glm::vec2(2.0f, 0.0f), Point + glm::vec2(2.0f, 0.0f), 2.0f * LINE_WIDTH, RED);
+         Renderer::DrawLine(Point, Point + 8.0f * Touching.Geometry.Normal, LINE_WIDTH, YELLOW);
+      }
+   }
+}
+
+} // namespace Echo2D
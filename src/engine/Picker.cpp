@@ -0,0 +1,199 @@
+#include <core/core.h>
+#include <engine/Picker.h>
+#include <engine/Components.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Echo2D {
+
+static float Dot(glm::vec2 A, glm::vec2 B) { return A.x * B.x + A.y * B.y; }
+
+/// A world vector in the frame of a rect rotated by Axis = (cos, sin).
+static glm::vec2 ToLocal(glm::vec2 Vector, glm::vec2 Axis) {
+   return {Vector.x * Axis.x + Vector.y * Axis.y, -Vector.x * Axis.y + Vector.y * Axis.x};
+}
+
+Picker::Picker(float CellSize) : m_Index(CellSize) {}
+
+uint32_t Picker::ProxyOf(Entity Target) const {
+   if (Target.Index >= m_ProxyOf.size()) return Broadphase::INVALID;
+   const uint32_t Proxy = m_ProxyOf[Target.Index];
+   return Proxy != Broadphase::INVALID && m_Entities[Proxy] == Target ? Proxy : Broadphase::INVALID;
+}
+
+void Picker::Update(World& Entities, float Alpha) {
+   if (++m_Update == 0) {
+      std::fill(m_Seen.begin(), m_Seen.end(), 0);
+      m_Update = 1;
+   }
+
+   // Same iteration order and interpolation as Renderer::DrawWorld(), so the
+   // order seen here is the draw order and rects are where they are drawn
+   uint32_t Order = 0;
+   Entities.EachChunk<Transform, Sprite, Pickable>([&](const World::ChunkView& View) {
+      const Entity* Owners = View.Entities();
+      const Transform* Placements = View.Column<Transform>();
+      const Sprite* Sprites = View.Column<Sprite>();
+      const Pickable* Picks = View.Column<Pickable>();
+      const Interpolation* Previous = View.Column<Interpolation>();
+
+      for (uint32_t i = 0; i < View.Size(); i++) {
+         const Entity Owner = Owners[i];
+         const Sprite& Drawn = Sprites[i];
+         const Pickable& Pick = Picks[i];
+         Transform Placement = Placements[i];
+         if (Previous && Previous[i].Valid) {
+            Placement.Position = glm::mix(Previous[i].Position, Placement.Position, Alpha);
+            Placement.Rotation = glm::mix(Previous[i].Rotation, Placement.Rotation, Alpha);
+         }
+
+         const glm::vec2 Size = Drawn.Size * Placement.Scale;
+         const glm::vec2 Half = 0.5f * glm::abs(Size);
+         const glm::vec2 Center = Placement.Position + 0.5f * Size;
+         const glm::vec2 Axis(std::cos(Placement.Rotation), std::sin(Placement.Rotation));
+         const glm::vec2 Reach(Half.x * std::abs(Axis.x) + Half.y * std::abs(Axis.y),
+                               Half.x * std::abs(Axis.y) + Half.y * std::abs(Axis.x));
+         const AABB Bounds = {Center - Reach, Center + Reach};
+
+         uint32_t Proxy = ProxyOf(Owner);
+         if (Proxy == Broadphase::INVALID) {
+            Proxy = m_Index.AddBox(Bounds, Owner.Index);
+            if (Proxy >= m_Entities.size()) {
+               m_Entities.resize(Proxy + 1);
+               m_Centers.resize(Proxy + 1);
+               m_HalfSizes.resize(Proxy + 1);
+               m_Axes.resize(Proxy + 1);
+               m_Depths.resize(Proxy + 1);
+               m_Layers.resize(Proxy + 1);
+               m_DrawOrder.resize(Proxy + 1);
+               m_Seen.resize(Proxy + 1);
+            }
+            if (Owner.Index >= m_ProxyOf.size()) m_ProxyOf.resize(Owner.Index + 1, Broadphase::INVALID);
+            m_ProxyOf[Owner.Index] = Proxy;
+            m_Entities[Proxy] = Owner;
+         } else {
+            m_Index.MoveBox(Proxy, Bounds);
+         }
+
+         m_Centers[Proxy] = Center;
+         m_HalfSizes[Proxy] = Half;
+         m_Axes[Proxy] = Axis;
+         m_Depths[Proxy] = Pick.Depth;
+         m_Layers[Proxy] = Pick.Layers;
+         m_DrawOrder[Proxy] = Order++;
+         m_Seen[Proxy] = m_Update;
+      }
+   });
+
+   // Entities destroyed or no longer pickable since the last update
+   for (uint32_t Proxy = 0; Proxy < m_Entities.size(); Proxy++) {
+      if (!m_Index.IsValid(Proxy) || m_Seen[Proxy] == m_Update) continue;
+      m_Index.Remove(Proxy);
+      const uint32_t Index = m_Entities[Proxy].Index;
+      if (m_ProxyOf[Index] == Proxy) m_ProxyOf[Index] = Broadphase::INVALID;
+      m_Entities[Proxy] = Entity();
+   }
+}
+
+void Picker::Clear() {
+   m_Index.Clear();
+   m_Entities.clear();
+   m_Centers.clear();
+   m_HalfSizes.clear();
+   m_Axes.clear();
+   m_Depths.clear();
+   m_Layers.clear();
+   m_DrawOrder.clear();
+   m_Seen.clear();
+   m_ProxyOf.clear();
+}
+
+void Picker::Sort(std::vector<PickHit>::iterator First, std::vector<PickHit>::iterator Last, bool ByDistance) const {
+   std::sort(First, Last, [this, ByDistance](const PickHit& Left, const PickHit& Right) {
+      if (ByDistance && Left.Distance != Right.Distance) return Left.Distance < Right.Distance;
+      if (Left.Depth != Right.Depth) return Left.Depth > Right.Depth;
+      return m_DrawOrder[ProxyOf(Left.Target)] > m_DrawOrder[ProxyOf(Right.Target)];
+   });
+}
+
+void Picker::QueryPoint(glm::vec2 Point, std::vector<PickHit>& Out, uint32_t LayerMask) {
+   m_Candidates.clear();
+   m_Index.QueryRegion({Point, Point}, m_Candidates);
+
+   const size_t First = Out.size();
+   for (uint32_t Proxy : m_Candidates) {
+      if (!(m_Layers[Proxy] & LayerMask)) continue;
+      const glm::vec2 Local = glm::abs(ToLocal(Point - m_Centers[Proxy], m_Axes[Proxy]));
+      const glm::vec2 Half = m_HalfSizes[Proxy];
+      if (Local.x > Half.x || Local.y > Half.y) continue;
+      Out.push_back({m_Entities[Proxy], m_Depths[Proxy], 0.0f});
+   }
+   Sort(Out.begin() + First, Out.end(), false);
+}
+
+void Picker::QueryRect(const AABB& Region, std::vector<PickHit>& Out, uint32_t LayerMask) {
+   m_Candidates.clear();
+   m_Index.QueryRegion(Region, m_Candidates);
+
+   const glm::vec2 RegionCenter = 0.5f * (Region.Min + Region.Max);
+   const glm::vec2 RegionHalf = 0.5f * (Region.Max - Region.Min);
+   const size_t First = Out.size();
+   for (uint32_t Proxy : m_Candidates) {
+      if (!(m_Layers[Proxy] & LayerMask)) continue;
+
+      // The index already compared the world axes; separate along the rect's own axes too
+      const glm::vec2 Axis = m_Axes[Proxy];
+      const glm::vec2 Half = m_HalfSizes[Proxy];
+      const glm::vec2 Local = glm::abs(ToLocal(RegionCenter - m_Centers[Proxy], Axis));
+      const float ReachX = RegionHalf.x * std::abs(Axis.x) + RegionHalf.y * std::abs(Axis.y);
+      const float ReachY = RegionHalf.x * std::abs(Axis.y) + RegionHalf.y * std::abs(Axis.x);
+      if (Local.x > Half.x + ReachX || Local.y > Half.y + ReachY) continue;
+      Out.push_back({m_Entities[Proxy], m_Depths[Proxy], 0.0f});
+   }
+   Sort(Out.begin() + First, Out.end(), false);
+}
+
+void Picker::QueryRay(glm::vec2 Origin, glm::vec2 Direction, float MaxDistance, std::vector<PickHit>& Out,
+                      uint32_t LayerMask) {
+   const float Length = std::sqrt(Dot(Direction, Direction));
+   if (Length == 0.0f) return;
+   Direction /= Length;
+   m_RayHits.clear();
+   m_Index.QueryRay(Origin, Direction, MaxDistance, m_RayHits);
+
+   const size_t First = Out.size();
+   for (const RayHit& Hit : m_RayHits) {
+      const uint32_t Proxy = Hit.Proxy;
+      if (!(m_Layers[Proxy] & LayerMask)) continue;
+
+      // Slab test in the rect's frame; rotation keeps distances along the ray
+      const glm::vec2 Start = ToLocal(Origin - m_Centers[Proxy], m_Axes[Proxy]);
+      const glm::vec2 Step = ToLocal(Direction, m_Axes[Proxy]);
+      const glm::vec2 Half = m_HalfSizes[Proxy];
+      float Enter = 0.0f;
+      float Exit = MaxDistance;
+      for (int Axis = 0; Axis < 2 && Enter <= Exit; Axis++) {
+         if (Step[Axis] == 0.0f) {
+            if (std::abs(Start[Axis]) > Half[Axis]) Enter = INFINITY;
+            continue;
+         }
+         float Near = (-Half[Axis] - Start[Axis]) / Step[Axis];
+         float Far = (Half[Axis] - Start[Axis]) / Step[Axis];
+         if (Near > Far) std::swap(Near, Far);
+         Enter = std::max(Enter, Near);
+         Exit = std::min(Exit, Far);
+      }
+      if (Enter > Exit) continue;
+      Out.push_back({m_Entities[Proxy], m_Depths[Proxy], Enter});
+   }
+   Sort(Out.begin() + First, Out.end(), true);
+}
+
+Entity Picker::Pick(glm::vec2 Point, uint32_t LayerMask) {
+   m_Scratch.clear();
+   QueryPoint(Point, m_Scratch, LayerMask);
+   return m_Scratch.empty() ? Entity() : m_Scratch.front().Target;
+}
+
+} // namespace Echo2D
@@ -0,0 +1,292 @@
+#include <core/core.h>
+#include <engine/RenderThread.h>
+#include <engine/Log.h>
+#include <engine/Renderer.h>
+#include "external/imgui.h"
+#include "external/imgui_impl_opengl3.h"
+
+#include <chrono>
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace Echo2D {
+
+void FramePacket::Clear() {
+   Vertices.clear();
+   Indices.clear();
+   Textures.clear();
+   Batches.clear();
+   DeletedTextures.clear();
+   UiListCount = 0;
+}
+
+void RenderThread::Start(GLFWwindow* Window) {
+   auto& Render = GetInstance();
+   if (Render.m_Active || !Window) return;
+
+   // A hidden window only to get a context sharing textures, buffers and programs
+   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+   glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+   Render.m_Loader = glfwCreateWindow(1, 1, "", nullptr, Window);
+   glfwDefaultWindowHints();
+   if (!Render.m_Loader) {
+      ECHO2D_LOG(ERROR) << "[RenderThread] Could not create a shared context; staying single-threaded.";
+      return;
+   }
+
+   glm::vec4 ClearColor;
+   glGetFloatv(GL_COLOR_CLEAR_VALUE, &ClearColor[0]);
+   for (FramePacket& Packet : Render.m_Packets) {
+      Packet.Clear();
+      Packet.ClearColor = ClearColor;
+   }
+
+   Render.m_Window = Window;
+   Render.m_Recording = 0;
+   Render.m_HasWork = false;
+   Render.m_Stopping = false;
+   glfwMakeContextCurrent(Render.m_Loader);
+   Render.m_Active = true;
+   Render.m_Thread = std::thread(&RenderThread::RenderLoop, &Render);
+   ECHO2D_LOG(INFO) << "[RenderThread] Started; GL submission runs one frame behind the main thread.";
+}
+
+void RenderThread::Stop() {
+   auto& Render = GetInstance();
+   if (!Render.m_Active) return;
+
+   {
+      std::lock_guard<std::mutex> Lock(Render.m_Mutex);
+      Render.m_Stopping = true;
+   }
+   Render.m_Wake.notify_all();
+   Render.m_Thread.join();
+   Render.m_Active = false;
+
+   // Deletions recorded after the last submit
+   FramePacket& Pending = Render.m_Packets[Render.m_Recording];
+   glfwMakeContextCurrent(Render.m_Window);
+   if (!Pending.DeletedTextures.empty()) {
+      glDeleteTextures(static_cast<GLsizei>(Pending.DeletedTextures.size()), Pending.DeletedTextures.data());
+   }
+   for (FramePacket& Packet : Render.m_Packets) {
+      Packet.Clear();
+   }
+
+   glfwDestroyWindow(Render.m_Loader);
+   Render.m_Loader = nullptr;
+   ECHO2D_LOG(INFO) << "[RenderThread] Stopped.";
+}
+
+bool RenderThread::IsActive() {
+   return GetInstance().m_Active;
+}
+
+FramePacket& RenderThread::GetPacket() {
+   auto& Render = GetInstance();
+   return Render.m_Packets[Render.m_Recording];
+}
+
+/**
+ * @brief Copies ImGui's draw lists into the packet's pooled lists.
+ *
+ * ImGui rebuilds its lists in the next NewFrame(), which runs while the render
+ * thread may still be drawing this frame.
+ */
+void RenderThread::CaptureImGui() {
+   FramePacket& Packet = GetPacket();
+   ImDrawData* Data = ImGui::GetDrawData();
+   Packet.UiListCount = 0;
+   if (!Data || !Data->Valid) return;
+
+   Packet.UiDisplayPos = {Data->DisplayPos.x, Data->DisplayPos.y};
+   Packet.UiDisplaySize = {Data->DisplaySize.x, Data->DisplaySize.y};
+   Packet.UiFramebufferScale = {Data->FramebufferScale.x, Data->FramebufferScale.y};
+   while (Packet.UiLists.size() < static_cast<size_t>(Data->CmdListsCount)) {
+      Packet.UiLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+   }
+
+   // resize() keeps capacity, so steady-state frames copy without allocating
+   for (int i = 0; i < Data->CmdListsCount; i++) {
+      const ImDrawList* Source = Data->CmdLists[i];
+      ImDrawList* Copy = Packet.UiLists[i];
+      Copy->CmdBuffer.resize(Source->CmdBuffer.Size);
+      Copy->IdxBuffer.resize(Source->IdxBuffer.Size);
+      Copy->VtxBuffer.resize(Source->VtxBuffer.Size);
+      if (Source->CmdBuffer.Size) std::memcpy(Copy->CmdBuffer.Data, Source->CmdBuffer.Data, Source->CmdBuffer.size_in_bytes());
+      if (Source->IdxBuffer.Size) std::memcpy(Copy->IdxBuffer.Data, Source->IdxBuffer.Data, Source->IdxBuffer.size_in_bytes());
+      if (Source->VtxBuffer.Size) std::memcpy(Copy->VtxBuffer.Data, Source->VtxBuffer.Data, Source->VtxBuffer.size_in_bytes());
+   }
+   Packet.UiListCount = Data->CmdListsCount;
+}
+
+void RenderThread::Submit() {
+   auto& Render = GetInstance();
+   if (!Render.m_Active) return;
+
+   // Uploads made on the main thread's context must land before the render thread samples them
+   GLsync Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+   glFlush();
+
+   std::unique_lock<std::mutex> Lock(Render.m_Mutex);
+   Render.m_Wake.wait(Lock, [&Render] { return !Render.m_HasWork; });
+   Render.m_Fence = Fence;
+   Render.m_HasWork = true;
+
+   const glm::vec4 ClearColor = Render.m_Packets[Render.m_Recording].ClearColor;
+   Render.m_Recording ^= 1;
+   FramePacket& Next = Render.m_Packets[Render.m_Recording];
+   Next.Clear();
+   Next.ClearColor = ClearColor;
+   Lock.unlock();
+   Render.m_Wake.notify_all();
+}
+
+void RenderThread::ReleaseTexture(GLuint ID) {
+   if (ID == 0) return;
+   if (IsActive()) {
+      GetPacket().DeletedTextures.push_back(ID);
+   } else {
+      glDeleteTextures(1, &ID);
+   }
+}
+
+double RenderThread::GetLatency() {
+   auto& Render = GetInstance();
+   std::lock_guard<std::mutex> Lock(Render.m_Mutex);
+   return Render.m_Latency;
+}
+
+void RenderThread::SetSwapInterval(int Interval) {
+   GetInstance().m_SwapInterval = Interval;
+}
+
+double RenderThread::GetSubmitTime() {
+   auto& Render = GetInstance();
+   std::lock_guard<std::mutex> Lock(Render.m_Mutex);
+   return Render.m_SubmitTime;
+}
+
+void RenderThread::RenderLoop() {
+   glfwMakeContextCurrent(m_Window);
+
+   // Vertex arrays are not shared between contexts, so this thread has its own
+   GLuint VAO = 0, VBO = 0, EBO = 0;
+   Renderer::CreateVertexArray(VAO, VBO, EBO, 0, 0);
+
+   while (true) {
+      FramePacket* Packet;
+      GLsync Fence;
+      {
+         std::unique_lock<std::mutex> Lock(m_Mutex);
+         m_Wake.wait(Lock, [this] { return m_Stopping || m_HasWork; });
+         if (!m_HasWork) break;
+         Packet = &m_Packets[m_Recording ^ 1];
+         Fence = m_Fence;
+      }
+
+      const auto Start = std::chrono::steady_clock::now();
+      glWaitSync(Fence, 0, GL_TIMEOUT_IGNORED);
+      glDeleteSync(Fence);
+      Draw(*Packet, VAO, VBO, EBO);
+      const int Interval = m_SwapInterval.exchange(NO_INTERVAL);
+      if (Interval != NO_INTERVAL) glfwSwapInterval(Interval);
+      glfwSwapBuffers(m_Window);
+      const double Elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+      const double Latency = FramePacer::Now() - Packet->InputTime;
+
+      {
+         std::lock_guard<std::mutex> Lock(m_Mutex);
+         m_HasWork = false;
+         m_SubmitTime = Elapsed;
+         m_Latency = Latency;
+      }
+      m_Wake.notify_all();
+   }
+
+   glDeleteVertexArrays(1, &VAO);
+   glDeleteBuffers(1, &VBO);
+   glDeleteBuffers(1, &EBO);
+   glfwMakeContextCurrent(nullptr);
+}
+
+/**
+ * @brief Replays a packet: uploads all its geometry at once, then draws batch by batch.
+ */
+void RenderThread::Draw(FramePacket& Packet, GLuint VAO, GLuint VBO, GLuint EBO) {
+   glClearColor(Packet.ClearColor.r, Packet.ClearColor.g, Packet.ClearColor.b, Packet.ClearColor.a);
+   glClear(GL_COLOR_BUFFER_BIT);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+   if (!Packet.Batches.empty()) {
+      glBindVertexArray(VAO);
+      // Orphaning the buffers lets the driver keep drawing the last frame from the old storage
+      glBindBuffer(GL_ARRAY_BUFFER, VBO);
+      glBufferData(GL_ARRAY_BUFFER, sizeof(Utils::Vertex) * Packet.Vertices.size(), Packet.Vertices.data(),
+                   GL_STREAM_DRAW);
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * Packet.Indices.size(), Packet.Indices.data(),
+                   GL_STREAM_DRAW);
+
+      GLuint Program = 0;
+      GLint Projection = -1, View = -1, Model = -1, Tint = -1;
+      for (const DrawBatch& Batch : Packet.Batches) {
+         if (Batch.Program != Program) {
+            Program = Batch.Program;
+            glUseProgram(Program);
+            Projection = glGetUniformLocation(Program, "projection");
+            View = glGetUniformLocation(Program, "view");
+            Model = glGetUniformLocation(Program, "model");
+            Tint = glGetUniformLocation(Program, "Tint");
+         }
+         glUniformMatrix4fv(Projection, 1, GL_FALSE, glm::value_ptr(Batch.Projection));
+         glUniformMatrix4fv(View, 1, GL_FALSE, glm::value_ptr(Batch.View));
+         glUniformMatrix4fv(Model, 1, GL_FALSE, glm::value_ptr(Batch.Model));
+         glUniform4f(Tint, 1.0f, 1.0f, 1.0f, 1.0f);
+
+         for (uint32_t i = 0; i < Batch.TextureCount; i++) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, Packet.Textures[Batch.FirstTexture + i]);
+         }
+         glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(Batch.IndexCount), GL_UNSIGNED_INT,
+                                  reinterpret_cast<void*>(sizeof(GLuint) * Batch.FirstIndex),
+                                  static_cast<GLint>(Batch.FirstVertex));
+      }
+      glActiveTexture(GL_TEXTURE0);
+   }
+
+   if (Packet.UiListCount > 0) {
+      // Lives as long as this thread; CmdLists keeps its capacity between frames
+      static thread_local ImDrawData Ui;
+      Ui.Clear();
+      Ui.Valid = true;
+      Ui.DisplayPos = {Packet.UiDisplayPos.x, Packet.UiDisplayPos.y};
+      Ui.DisplaySize = {Packet.UiDisplaySize.x, Packet.UiDisplaySize.y};
+      Ui.FramebufferScale = {Packet.UiFramebufferScale.x, Packet.UiFramebufferScale.y};
+      // Filled by hand: AddDrawList() checks the builder state a copied list does not have
+      for (int i = 0; i < Packet.UiListCount; i++) {
+         ImDrawList* List = Packet.UiLists[i];
+         Ui.CmdLists.push_back(List);
+         Ui.TotalVtxCount += List->VtxBuffer.Size;
+         Ui.TotalIdxCount += List->IdxBuffer.Size;
+      }
+      Ui.CmdListsCount = Packet.UiListCount;
+      ImGui_ImplOpenGL3_RenderDrawData(&Ui);
+   }
+
+   if (!Packet.DeletedTextures.empty()) {
+      glDeleteTextures(static_cast<GLsizei>(Packet.DeletedTextures.size()), Packet.DeletedTextures.data());
+   }
+}
+
+RenderThread::~RenderThread() {
+   for (FramePacket& Packet : m_Packets) {
+      for (ImDrawList* List : Packet.UiLists) IM_DELETE(List);
+   }
+}
+
+} // namespace Echo2D
@@ -6,10 +6,16 @@
  */
 
 #include "external/glad.h"
+#include <algorithm>
 #include <cmath>
 #include <core/core.h>
+#include <engine/Animator.h>
 #include <engine/ApplicationInfo.h>
+#include <engine/Components.h>
+#include <engine/JobSystem.h>
 #include <engine/Renderer.h>
+#include <engine/RenderThread.h>
+#include <engine/TextureResidency.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <utils/ShaderUtils.h>
 
@@ -25,15 +31,30 @@ Renderer::Renderer() {
    m_Projection = glm::ortho(20.0f, (float)g_AppInfo.ScreenWidth,
                            (float)g_AppInfo.ScreenHeight, 0.0f);
 
-   glGenVertexArrays(1, &m_VAO);
-   glGenBuffers(1, &m_VBO);
-   glGenBuffers(1, &m_EBO);
+   CreateVertexArray(m_VAO, m_VBO, m_EBO, m_VBOMaxSize, m_EBOMaxSize);
 
-   glBindVertexArray(m_VAO);
-   glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-   glBufferData(GL_ARRAY_BUFFER, m_VBOMaxSize, nullptr, GL_DYNAMIC_DRAW);
-   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-   glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_EBOMaxSize, nullptr, GL_DYNAMIC_DRAW);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+   int MaxSamplers;
+   glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &MaxSamplers);
+   m_MaxTextureSlots = (GLuint)MaxSamplers;
+
+   m_Shader->Use();
+   SetSamplerUniforms();
+}
+
+
+void Renderer::CreateVertexArray(GLuint &VAO, GLuint &VBO, GLuint &EBO, GLuint VBOSize, GLuint EBOSize) {
+   glGenVertexArrays(1, &VAO);
+   glGenBuffers(1, &VBO);
+   glGenBuffers(1, &EBO);
+
+   glBindVertexArray(VAO);
+   glBindBuffer(GL_ARRAY_BUFFER, VBO);
+   glBufferData(GL_ARRAY_BUFFER, VBOSize, nullptr, GL_DYNAMIC_DRAW);
+   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+   glBufferData(GL_ELEMENT_ARRAY_BUFFER, EBOSize, nullptr, GL_DYNAMIC_DRAW);
 
    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Utils::Vertex),
                          (void *)offsetof(Utils::Vertex, Position));
@@ -51,18 +72,18 @@ Renderer::Renderer() {
                          (void *)offsetof(Utils::Vertex, TextureIndex));
    glEnableVertexAttribArray(3);
 
-   glEnable(GL_BLEND);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+   glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(Utils::Vertex),
+                         (void *)offsetof(Utils::Vertex, DistanceField));
+   glEnableVertexAttribArray(4);
+}
 
-   m_Shader->Use();
-   int MaxSamplers;
-   glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &MaxSamplers);
-   int Samplers[MaxSamplers];
-   for (int i = 0; i < MaxSamplers; i++)
-      Samplers[i] = i;
-   m_Shader->SetIntV("Textures", MaxSamplers, Samplers);
 
-   m_MaxTextureSlots = (GLuint)MaxSamplers;
+void Renderer::SetSamplerUniforms() {
+   std::vector<int> Samplers(m_MaxTextureSlots);
+   for (GLuint i = 0; i < m_MaxTextureSlots; i++)
+      Samplers[i] = i;
+   m_Shader->SetIntV("Textures", m_MaxTextureSlots, Samplers.data());
+   m_ShaderGeneration = m_Shader->GetGeneration();
 }
 
 
@@ -91,6 +112,7 @@ void Renderer::CheckAndFlush(const GLuint &VertexCount) {
 
 
 void Renderer::AddTexture(Texture &Texture) {
+   TextureResidency::Touch(Texture);
    for (int i = 0; i < GetInstance().m_Textures.size(); i++) {
       if (Texture.GetID() == GetInstance().m_Textures.at(i)->GetID()) {
          return;
@@ -112,6 +134,10 @@ int Renderer::FindTextureIndex(Texture &Texture) {
 
 void Renderer::ClearScreenColor(glm::vec4 ScreenColor) {
    glm::vec4 pcColor = (1.0f / 255.0f) * ScreenColor;
+   if (RenderThread::IsActive()) {
+      RenderThread::GetPacket().ClearColor = pcColor;
+      return;
+   }
    glClearColor(pcColor.r, pcColor.g, pcColor.b, pcColor.a);
 }
 
@@ -128,6 +154,7 @@ void Renderer::DrawCircle(float Radius, glm::vec2 Center, glm::vec4 Color) {
    CenterVertex.Color = Color;
    CenterVertex.TexCoords = {0.0f, 0.0f};
    CenterVertex.TextureIndex = -1.0f;
+   CenterVertex.DistanceField = 0.0f;
    GetInstance().m_VertexData.push_back(CenterVertex);
 
    for (int i = 0; i < VertexCount; i++) {
@@ -139,6 +166,7 @@ void Renderer::DrawCircle(float Radius, glm::vec2 Center, glm::vec4 Color) {
       TempVert.Color = (1.0f / 255.0f) * Color;
       TempVert.TexCoords = {0.0f, 0.0f};
       TempVert.TextureIndex = -1.0f;
+      TempVert.DistanceField = 0.0f;
       GetInstance().m_VertexData.push_back(TempVert);
    }
 
@@ -167,6 +195,7 @@ void Renderer::DrawRect(glm::vec2 Dimensions, glm::vec2 Center,
       vertices[i].Color = (1.0f / 255.f) * Color;
       vertices[i].TexCoords = {0.0f, 0.0f};
       vertices[i].TextureIndex = -1.0f;
+      vertices[i].DistanceField = 0.0f;
       GetInstance().m_VertexData.push_back(vertices[i]);
    }
 
@@ -191,6 +220,7 @@ void Renderer::DrawTriangle(glm::vec2 V0, glm::vec2 V1, glm::vec2 V2,
       vertices[i].Color = (1.0f / 255.f) * Color;
       vertices[i].TexCoords = {0.0f, 0.0f};
       vertices[i].TextureIndex = -1.0f;
+      vertices[i].DistanceField = 0.0f;
       GetInstance().m_VertexData.push_back(vertices[i]);
    }
 
@@ -201,6 +231,35 @@ void Renderer::DrawTriangle(glm::vec2 V0, glm::vec2 V1, glm::vec2 V2,
 }
 
 
+void Renderer::DrawLine(glm::vec2 Start, glm::vec2 End, float Thickness,
+                        glm::vec4 Color) {
+   const GLuint VertexCount = 4;
+   const glm::vec2 Direction = End - Start;
+   const float Length = std::sqrt(Direction.x * Direction.x + Direction.y * Direction.y);
+   if (Length <= 0.0f) return;
+   CheckAndFlush(VertexCount);
+
+   const glm::vec2 Side = glm::vec2(-Direction.y, Direction.x) * (0.5f * Thickness / Length);
+   glm::vec2 positions[4] = {Start - Side, End - Side, End + Side, Start + Side};
+
+   Utils::Vertex vertices[4];
+   for (int i = 0; i < 4; i++) {
+      vertices[i].Position = {positions[i].x, positions[i].y, 0.0f};
+      vertices[i].Color = (1.0f / 255.f) * Color;
+      vertices[i].TexCoords = {0.0f, 0.0f};
+      vertices[i].TextureIndex = -1.0f;
+      vertices[i].DistanceField = 0.0f;
+      GetInstance().m_VertexData.push_back(vertices[i]);
+   }
+
+   GLuint StartingIndex = GetInstance().m_VertexData.size() - VertexCount;
+   GLuint indices[] = {StartingIndex, StartingIndex + 1, StartingIndex + 2,
+      StartingIndex, StartingIndex + 3, StartingIndex + 2};
+   for (GLuint index : indices)
+      GetInstance().m_IndexData.push_back(index);
+}
+
+
 void Renderer::DrawRectTexture(glm::vec2 Dimensions, glm::vec2 Position,
                                 Texture &Tex, glm::vec4 Tint) {
    const GLuint VertexCount = 4;
@@ -221,6 +280,7 @@ void Renderer::DrawRectTexture(glm::vec2 Dimensions, glm::vec2 Position,
       vertices[i].Color = (1.0f / 255.f) * Tint;
       vertices[i].TexCoords = uvs[i];
       vertices[i].TextureIndex = (float)Index;
+      vertices[i].DistanceField = 0.0f;
       GetInstance().m_VertexData.push_back(vertices[i]);
    }
 
@@ -247,6 +307,7 @@ void Renderer::DrawTriangleTexture(glm::vec2 V0, glm::vec2 V1, glm::vec2 V2,
       vertices[i].Color = (1.0f / 255.f) * Tint;
       vertices[i].TexCoords = uvs[i];
       vertices[i].TextureIndex = (float)Index;
+      vertices[i].DistanceField = 0.0f;
       GetInstance().m_VertexData.push_back(vertices[i]);
    }
 
@@ -272,6 +333,7 @@ void Renderer::DrawCircleTexture(float Radius, glm::vec2 Center,
    CenterVertex.Color = (1.0f / 255.0f) * Tint;
    CenterVertex.TexCoords = {0.5f, 0.5f};
    CenterVertex.TextureIndex = (float)Index;
+   CenterVertex.DistanceField = 0.0f;
    GetInstance().m_VertexData.push_back(CenterVertex);
 
    // Perimeter vertices
@@ -285,6 +347,7 @@ void Renderer::DrawCircleTexture(float Radius, glm::vec2 Center,
       TempVert.TexCoords = {0.5f * std::cos(glm::radians(CurrAngle)) + 0.5f,
          0.5f * std::sin(glm::radians(CurrAngle)) + 0.5f};
       TempVert.TextureIndex = (float)Index;
+      TempVert.DistanceField = 0.0f;
       GetInstance().m_VertexData.push_back(TempVert);
    }
 
@@ -298,34 +361,181 @@ void Renderer::DrawCircleTexture(float Radius, glm::vec2 Center,
 
 void Renderer::DrawText(const std::string &text, glm::vec2 position, Font &font,
                         glm::vec4 color, float scale) {
-   // Starting X position (we'll advance this per character)
-   float x = position.x;
-   float y = position.y;
-
-   for (char c : text) {
-      Character &ch = font.GetCharacter(c);
-
-      float xpos = x + ch.m_Bearing.x * scale;
-      float ypos = y - ch.m_Bearing.y * scale;
-
-      float w = ch.m_Size.x * scale;
-      float h = ch.m_Size.y * scale;
-
-      DrawRectTexture({w, h}, {xpos, ypos}, *ch.m_Texture, color);
+   DrawTextLayout(TextLayoutCache::Get(font, text, scale), position, color);
+}
 
-      x += (ch.m_Advance >> 6) * scale;
+void Renderer::DrawTextLayout(TextLayout &Layout, glm::vec2 Position, glm::vec4 Color) {
+   Layout.Refresh();
+
+   Renderer &Instance = GetInstance();
+   // Keep one element of headroom, matching CheckAndFlush's ">=" test
+   const size_t MaxVertices = Instance.m_VBOMaxSize / sizeof(Utils::Vertex) - 1;
+   const size_t MaxIndices = Instance.m_EBOMaxSize / sizeof(GLuint) - 1;
+
+   for (size_t RunIndex = 0; RunIndex < Layout.m_Runs.size(); RunIndex++) {
+      const TextLayout::Run &Run = Layout.m_Runs[RunIndex];
+      size_t Done = 0;
+      // Cached runs skip glyph lookups, so keep their page from looking cold to eviction
+      Layout.m_Font->TouchPage(Run.Page);
+
+      while (Done < Run.QuadCount) {
+         if (FindTextureIndex(*Run.Atlas) < 0 &&
+             Instance.m_Textures.size() >= Instance.m_MaxTextureSlots) {
+            FlushPending();
+         }
+
+         size_t Fit = std::min((MaxVertices - Instance.m_VertexData.size()) / 4,
+                               (MaxIndices - Instance.m_IndexData.size()) / 6);
+         if (Fit == 0) {
+            FlushPending();
+            continue;
+         }
+
+         AddTexture(*Run.Atlas);
+         float Index = static_cast<float>(FindTextureIndex(*Run.Atlas));
+         const Utils::Vertex *Baked = Layout.Bake(RunIndex, Position, Color, Index);
+
+         // Baked quads are already in batch layout: copy them as one block
+         size_t Count = std::min(Fit, Run.QuadCount - Done);
+         GLuint StartingIndex = static_cast<GLuint>(Instance.m_VertexData.size());
+         Instance.m_VertexData.insert(Instance.m_VertexData.end(), Baked + Done * 4,
+                                      Baked + (Done + Count) * 4);
+
+         for (GLuint Quad = 0; Quad < Count; Quad++) {
+            GLuint Base = StartingIndex + Quad * 4;
+            GLuint indices[] = {Base, Base + 1, Base + 2, Base, Base + 3, Base + 2};
+            Instance.m_IndexData.insert(Instance.m_IndexData.end(), indices, indices + 6);
+         }
+         Done += Count;
+      }
    }
 }
 
 void Renderer::DrawRectSprite(glm::vec2 Dimensions, glm::vec2 Position,
                               Spritesheet &Sprites, int i,
                               int j, glm::vec4 Tint) {
-    const GLuint VertexCount = 4;
-    CheckAndFlush(VertexCount);
-    AddTexture(Sprites.GetTex());
-    int Index = FindTextureIndex(Sprites.GetTex());
+    DrawRectRegion(Dimensions, Position, Sprites.GetTex(), Sprites.GetTexCoords(i, j), Tint);
+}
 
-    Utils::Vertex vertices[4];
+void Renderer::DrawAnimation(glm::vec2 Dimensions, glm::vec2 Position, uint32_t Instance, glm::vec4 Tint) {
+    Texture *Tex = Animator::GetTexture(Instance);
+    if (!Tex) return;
+    DrawSpriteFrame(Dimensions, Position, *Tex, Animator::GetSpriteFrame(Instance), Tint);
+}
+
+/// A sprite's quad, transformed on a worker and pushed into the batch on the GL thread.
+struct WorldQuad {
+    glm::vec2 Positions[4];
+    glm::vec2 UVs[4];
+    Texture *Tex;
+    glm::vec4 Tint;
+};
+
+void Renderer::DrawWorld(World &Entities, float Alpha) {
+    static std::vector<World::ChunkView> views;
+    static std::vector<size_t> firsts;
+    static std::vector<WorldQuad> quads;
+    static std::vector<SpriteFrame> frames;
+
+    views.clear();
+    firsts.clear();
+    size_t count = 0;
+    Entities.EachChunk<Transform, Sprite>([&](const World::ChunkView &View) {
+        views.push_back(View);
+        firsts.push_back(count);
+        count += View.Size();
+    });
+    quads.resize(count);
+    frames.resize(count);
+
+    // Asset handles and the Animator are main-thread only, so textures and
+    // frames are resolved here before the workers run
+    for (size_t c = 0; c < views.size(); c++) {
+        const World::ChunkView &View = views[c];
+        const Sprite *Sprites = View.Column<Sprite>();
+        const Animation *Animations = View.Column<Animation>();
+
+        for (uint32_t i = 0; i < View.Size(); i++) {
+            const Sprite &Drawn = Sprites[i];
+            WorldQuad &Quad = quads[firsts[c] + i];
+            if (Animations && Animations[i].Instance != Animator::INVALID) {
+                // Clips without a sheet animate the sprite's own texture
+                Quad.Tex = Animator::GetTexture(Animations[i].Instance);
+                if (!Quad.Tex) Quad.Tex = Drawn.Texture.Get();
+                frames[firsts[c] + i] = Animator::GetSpriteFrame(Animations[i].Instance);
+            } else {
+                Quad.Tex = Drawn.Texture.Get();
+                frames[firsts[c] + i] = SpriteFrame::FromRegion(Drawn.Region);
+            }
+        }
+    }
+
+    // Building the quads only reads components, so chunks are spread over the
+    // job system; texture slots and buffers are filled in order afterwards
+    JobSystem::ParallelFor(0, views.size(), 1, [Alpha](size_t First, size_t Last) {
+        for (size_t c = First; c < Last; c++) {
+            const World::ChunkView &View = views[c];
+            const Transform *Placements = View.Column<Transform>();
+            const Sprite *Sprites = View.Column<Sprite>();
+            const Interpolation *Previous = View.Column<Interpolation>();
+
+            for (uint32_t i = 0; i < View.Size(); i++) {
+                WorldQuad &Quad = quads[firsts[c] + i];
+                if (!Quad.Tex) continue;
+
+                Transform Placement = Placements[i];
+                if (Previous && Previous[i].Valid) {
+                    Placement.Position = glm::mix(Previous[i].Position, Placement.Position, Alpha);
+                    Placement.Rotation = glm::mix(Previous[i].Rotation, Placement.Rotation, Alpha);
+                }
+                const Sprite &Drawn = Sprites[i];
+                const SpriteFrame &Frame = frames[firsts[c] + i];
+
+                // Trimmed rect, scaled, then rotated about the untrimmed rect's center
+                const glm::vec2 Size = Drawn.Size * Placement.Scale;
+                const glm::vec2 Center = Placement.Position + 0.5f * Size;
+                const glm::vec2 Min = Placement.Position + Frame.Offset * Size - Center;
+                const glm::vec2 Max = Min + Frame.Size * Size;
+                const glm::vec2 Corners[4] = {{Min.x, Min.y}, {Max.x, Min.y}, {Max.x, Max.y}, {Min.x, Max.y}};
+
+                const float Cos = std::cos(Placement.Rotation);
+                const float Sin = std::sin(Placement.Rotation);
+                for (int k = 0; k < 4; k++) {
+                    const glm::vec2 &Corner = Corners[k];
+                    Quad.Positions[k] = Center + glm::vec2(Corner.x * Cos - Corner.y * Sin, Corner.x * Sin + Corner.y * Cos);
+                    Quad.UVs[k] = Frame.UV[k];
+                }
+                Quad.Tint = Drawn.Tint;
+            }
+        }
+    });
+
+    for (const WorldQuad &Quad : quads) {
+        if (Quad.Tex) PushQuad(Quad.Positions, Quad.UVs, *Quad.Tex, Quad.Tint);
+    }
+}
+
+void Renderer::DrawSpriteFrame(glm::vec2 Dimensions, glm::vec2 Position, Spritesheet &Sprites, int Frame,
+                               glm::vec4 Tint) {
+    DrawSpriteFrame(Dimensions, Position, Sprites.GetTex(), Sprites.GetFrame(Frame), Tint);
+}
+
+void Renderer::DrawSpriteFrame(glm::vec2 Dimensions, glm::vec2 Position, Texture &Tex,
+                               const SpriteFrame &Frame, glm::vec4 Tint) {
+    // Only the trimmed image is drawn, placed where it sat in the untrimmed frame
+    glm::vec2 Min = Position + Frame.Offset * Dimensions;
+    glm::vec2 Max = Min + Frame.Size * Dimensions;
+    glm::vec2 positions[4] = {
+        {Min.x, Min.y},
+        {Max.x, Min.y},
+        {Max.x, Max.y},
+        {Min.x, Max.y}
+    };
+    PushQuad(positions, Frame.UV, Tex, Tint);
+}
+
+void Renderer::DrawRectRegion(glm::vec2 Dimensions, glm::vec2 Position,
+                              Texture &Tex, glm::vec4 Region, glm::vec4 Tint) {
     glm::vec2 positions[4] = {
         {Position.x, Position.y},
         {Position.x + Dimensions.x, Position.y},
@@ -333,12 +543,11 @@ void Renderer::DrawRectSprite(glm::vec2 Dimensions, glm::vec2 Position,
         {Position.x, Position.y + Dimensions.y}
     };
 
-    // GetTexCoords returns (u, v, width, height)
-    glm::vec4 texCoords = Sprites.GetTexCoords(i, j);
-    float u = texCoords.x;
-    float v = texCoords.y;
-    float w = texCoords.z;
-    float h = texCoords.w;
+    // Region is (u, v, width, height)
+    float u = Region.x;
+    float v = Region.y;
+    float w = Region.z;
+    float h = Region.w;
 
     glm::vec2 uvs[4] = {
         {u, v},
@@ -346,14 +555,24 @@ void Renderer::DrawRectSprite(glm::vec2 Dimensions, glm::vec2 Position,
         {u + w, v + h},
         {u, v + h}
     };
+    PushQuad(positions, uvs, Tex, Tint);
+}
+
+void Renderer::PushQuad(const glm::vec2 Positions[4], const glm::vec2 UVs[4], Texture &Tex, glm::vec4 Tint) {
+    const GLuint VertexCount = 4;
+    CheckAndFlush(VertexCount);
+    AddTexture(Tex);
+    int Index = FindTextureIndex(Tex);
 
+    Utils::Vertex vertices[4];
     glm::vec4 normalizedTint = Tint * (1.0f / 255.0f);
 
     for (int k = 0; k < 4; k++) {
-        vertices[k].Position = {positions[k].x, positions[k].y, 0.0f};
+        vertices[k].Position = {Positions[k].x, Positions[k].y, 0.0f};
         vertices[k].Color = normalizedTint;
-        vertices[k].TexCoords = uvs[k];
+        vertices[k].TexCoords = UVs[k];
         vertices[k].TextureIndex = static_cast<float>(Index);
+        vertices[k].DistanceField = 0.0f;
         GetInstance().m_VertexData.push_back(vertices[k]);
     }
 
@@ -368,6 +587,19 @@ void Renderer::DrawRectSprite(glm::vec2 Dimensions, glm::vec2 Position,
 }
 
 void Renderer::EndDraw() {
+   if (RenderThread::IsActive()) {
+      // Buffers and matrices go into the packet; the render thread sets them
+      if (GetInstance().m_Camera != nullptr) {
+         GetInstance().m_View = GetInstance().m_Camera->GetViewMatrix();
+         GetInstance().m_Projection = GetInstance().m_Camera->GetProjectionMatrix();
+      }
+      if (GetInstance().m_ShaderGeneration != GetInstance().m_Shader->GetGeneration()) {
+         GetInstance().m_Shader->Use();
+         GetInstance().SetSamplerUniforms();
+      }
+      return;
+   }
+
    glBindBuffer(GL_ARRAY_BUFFER, GetInstance().m_VBO);
    glBufferSubData(GL_ARRAY_BUFFER, 0,
                    sizeof(Utils::Vertex) * GetInstance().m_VertexData.size(),
@@ -383,6 +615,10 @@ void Renderer::EndDraw() {
    }
 
    GetInstance().m_Shader->Use();
+   // A hot-reloaded program starts with default uniforms
+   if (GetInstance().m_ShaderGeneration != GetInstance().m_Shader->GetGeneration()) {
+      GetInstance().SetSamplerUniforms();
+   }
    GetInstance().m_Shader->SetMat4("projection", GetInstance().m_Projection);
    GetInstance().m_Shader->SetMat4("model", GetInstance().m_Model);
    GetInstance().m_Shader->SetMat4("view", GetInstance().m_View);
@@ -391,6 +627,12 @@ void Renderer::EndDraw() {
 
 
 void Renderer::Flush() {
+   if (RenderThread::IsActive()) {
+      GetInstance().RecordBatch();
+      g_BatchData.DrawCalls++;
+      return;
+   }
+
    for (uint32_t i = 0; i < GetInstance().m_Textures.size(); i++) {
       GetInstance().m_Textures.at(i)->Bind(i);
    }
@@ -405,6 +647,37 @@ void Renderer::Flush() {
    }
 }
 
+void Renderer::RecordBatch() {
+   if (m_IndexData.empty()) return;
+   FramePacket &Packet = RenderThread::GetPacket();
+
+   DrawBatch Batch;
+   Batch.FirstVertex = static_cast<uint32_t>(Packet.Vertices.size());
+   Batch.VertexCount = static_cast<uint32_t>(m_VertexData.size());
+   Batch.FirstIndex = static_cast<uint32_t>(Packet.Indices.size());
+   Batch.IndexCount = static_cast<uint32_t>(m_IndexData.size());
+   Batch.FirstTexture = static_cast<uint32_t>(Packet.Textures.size());
+   Batch.TextureCount = static_cast<uint32_t>(m_Textures.size());
+   Batch.Program = m_Shader->GetID();
+   Batch.Projection = m_Projection;
+   Batch.View = m_View;
+   Batch.Model = m_Model;
+
+   Packet.Vertices.insert(Packet.Vertices.end(), m_VertexData.begin(), m_VertexData.end());
+   Packet.Indices.insert(Packet.Indices.end(), m_IndexData.begin(), m_IndexData.end());
+   for (Texture *Tex : m_Textures) {
+      Packet.Textures.push_back(Tex->GetID());
+   }
+   Packet.Batches.push_back(Batch);
+}
+
+void Renderer::FlushPending() {
+   if (GetInstance().m_IndexData.empty()) return;
+   EndDraw();
+   Flush();
+   InitDraw();
+}
+
 Renderer::~Renderer() {
    delete m_Shader;
    glDeleteVertexArrays(1, &m_VAO);
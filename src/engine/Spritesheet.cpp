@@ -1,5 +1,14 @@
+#include <engine/AssetArchive.h>
+#include <engine/AssetCache.h>
+#include <engine/Log.h>
 #include <engine/Spritesheet.h>
 #include <engine/Texture.h>
+#include <utils/Json.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 namespace Echo2D {
 
@@ -11,36 +20,203 @@ namespace Echo2D {
  * on their grid position.
  */
 
-Spritesheet::Spritesheet(const std::string filepath, int spriteWidth, int spriteHeight, float FrameInterval, int SpriteAmount)
-   : m_TextureMap(new Texture(filepath.c_str())),
+/// Reads a metadata file from the mounted archives, then the file system.
+static bool ReadText(const std::string& Path, std::string& Text) {
+   if (const AssetArchive::Entry* Packed = AssetArchive::FindMounted(Path)) {
+      std::vector<unsigned char> Scratch;
+      const unsigned char* Data = AssetArchive::View(*Packed, Scratch);
+      if (!Data) return false;
+      Text.assign(reinterpret_cast<const char*>(Data), Packed->Size);
+      return true;
+   }
+
+   std::ifstream File(Path, std::ios::binary);
+   if (!File) return false;
+   std::stringstream Stream;
+   Stream << File.rdbuf();
+   Text = Stream.str();
+   return true;
+}
+
+Spritesheet::Spritesheet(const std::string filepath, int spriteWidth, int spriteHeight)
+   : m_TextureMap(AssetCache::LoadTexture(filepath)),
    m_SpriteWidthRatio(static_cast<float>(spriteWidth) / m_TextureMap->GetWidth()),
-   m_SpriteHeightRatio(static_cast<float>(spriteHeight) / m_TextureMap->GetHeight()), m_FrameInterval(FrameInterval), m_SpriteAmount(SpriteAmount) {}
+   m_SpriteHeightRatio(static_cast<float>(spriteHeight) / m_TextureMap->GetHeight()) {
+   if (spriteWidth <= 0 || spriteHeight <= 0) return;
+   if (m_TextureMap->GetWidth() < spriteWidth || m_TextureMap->GetHeight() < spriteHeight) {
+      ECHO2D_LOG(ERROR) << "[Spritesheet] " << filepath << " (" << m_TextureMap->GetWidth() << "x"
+                        << m_TextureMap->GetHeight() << ") is smaller than one " << spriteWidth << "x" << spriteHeight
+                        << " sprite.";
+      return;
+   }
+
+   // Cells row by row, so frame j * columns + i is cell (i, j)
+   m_Columns = m_TextureMap->GetWidth() / spriteWidth;
+   const int Rows = m_TextureMap->GetHeight() / spriteHeight;
+   m_Frames.reserve(static_cast<size_t>(m_Columns) * Rows);
+   for (int j = 0; j < Rows; j++) {
+      for (int i = 0; i < m_Columns; i++) {
+         m_Frames.push_back(SpriteFrame::FromRegion({i * m_SpriteWidthRatio, j * m_SpriteHeightRatio,
+                                                     m_SpriteWidthRatio, m_SpriteHeightRatio}));
+      }
+   }
+}
+
+Spritesheet::Spritesheet(const std::string& MetadataPath) : m_SpriteWidthRatio(1.0f), m_SpriteHeightRatio(1.0f) {
+   if (LoadMetadata(MetadataPath)) return;
+
+   ECHO2D_LOG(ERROR) << "[Spritesheet] Could not read sprite metadata: " << MetadataPath;
+   m_TextureMap = AssetCache::LoadTexture(std::filesystem::path(MetadataPath).replace_extension(".png").string());
+   m_Frames.assign(1, SpriteFrame::FromRegion({0.0f, 0.0f, 1.0f, 1.0f}));
+}
+
+Spritesheet::~Spritesheet() = default;
+
+/**
+ * @brief Builds the frame table from TexturePacker / Aseprite JSON.
+ * @return false if the file is missing or not JSON.
+ */
+bool Spritesheet::LoadMetadata(const std::string& MetadataPath) {
+   std::string Text;
+   if (!ReadText(MetadataPath, Text)) return false;
+
+   Utils::JsonValue Root;
+   std::string Error;
+   if (!Utils::JsonValue::Parse(Text, Root, &Error)) {
+      ECHO2D_LOG(ERROR) << "[Spritesheet] " << MetadataPath << ": " << Error;
+      return false;
+   }
+
+   const Utils::JsonValue& Meta = Root["meta"];
+   std::filesystem::path Image = std::filesystem::path(MetadataPath).parent_path();
+   Image /= Meta["image"].IsString() ? std::filesystem::path(Meta["image"].AsString())
+                                     : std::filesystem::path(MetadataPath).filename().replace_extension(".png");
+   m_TextureMap = AssetCache::LoadTexture(Image.lexically_normal().string());
+
+   // Frame rects are in pixels of the atlas the metadata was written for
+   const float AtlasWidth = std::max(static_cast<float>(Meta["size"]["w"].AsNumber(1.0)), 1.0f);
+   const float AtlasHeight = std::max(static_cast<float>(Meta["size"]["h"].AsNumber(1.0)), 1.0f);
+   if (m_TextureMap->IsReady() && (m_TextureMap->GetWidth() != static_cast<int>(AtlasWidth) ||
+                                   m_TextureMap->GetHeight() != static_cast<int>(AtlasHeight))) {
+      ECHO2D_LOG(WARNING) << "[Spritesheet] " << MetadataPath << " describes a " << AtlasWidth << "x" << AtlasHeight
+                          << " atlas, but " << Image.string() << " is " << m_TextureMap->GetWidth() << "x"
+                          << m_TextureMap->GetHeight() << ".";
+   }
+
+   auto AddFrame = [&](const std::string& Name, const Utils::JsonValue& Data) {
+      const Utils::JsonValue& Rect = Data["frame"];
+      const float x = static_cast<float>(Rect["x"].AsNumber());
+      const float y = static_cast<float>(Rect["y"].AsNumber());
+      const float w = static_cast<float>(Rect["w"].AsNumber());
+      const float h = static_cast<float>(Rect["h"].AsNumber());
+      const bool Rotated = Data["rotated"].AsBool();
+
+      SpriteFrame Frame;
+      if (!Rotated) {
+         Frame = SpriteFrame::FromRegion({x / AtlasWidth, y / AtlasHeight, w / AtlasWidth, h / AtlasHeight});
+      } else {
+         // Stored turned 90 degrees clockwise: the region is h x w and the
+         // image's top-left corner sits at the region's top-right
+         const float u0 = x / AtlasWidth;
+         const float v0 = y / AtlasHeight;
+         const float u1 = (x + h) / AtlasWidth;
+         const float v1 = (y + w) / AtlasHeight;
+         Frame.Bounds = {u0, v0, u1 - u0, v1 - v0};
+         Frame.UV[0] = {u1, v0};
+         Frame.UV[1] = {u1, v1};
+         Frame.UV[2] = {u0, v1};
+         Frame.UV[3] = {u0, v0};
+      }
 
-Spritesheet::~Spritesheet() {
-   delete m_TextureMap;
+      const Utils::JsonValue& Source = Data["sourceSize"];
+      const Utils::JsonValue& Trimmed = Data["spriteSourceSize"];
+      const float SourceWidth = static_cast<float>(Source["w"].AsNumber(w));
+      const float SourceHeight = static_cast<float>(Source["h"].AsNumber(h));
+      if (Trimmed.IsObject() && SourceWidth > 0.0f && SourceHeight > 0.0f) {
+         Frame.Offset = glm::vec2(static_cast<float>(Trimmed["x"].AsNumber()),
+                                  static_cast<float>(Trimmed["y"].AsNumber())) / glm::vec2(SourceWidth, SourceHeight);
+         Frame.Size = glm::vec2(static_cast<float>(Trimmed["w"].AsNumber(SourceWidth)),
+                                static_cast<float>(Trimmed["h"].AsNumber(SourceHeight))) / glm::vec2(SourceWidth, SourceHeight);
+      }
+
+      // Aseprite durations are in milliseconds
+      if (Data["duration"].IsNumber()) {
+         Frame.Duration = std::max(static_cast<float>(Data["duration"].AsNumber()) / 1000.0f, 1e-3f);
+      }
+
+      if (!Name.empty()) m_FrameNames.emplace(Name, static_cast<int>(m_Frames.size()));
+      m_Frames.push_back(Frame);
+   };
+
+   // "frames" is an object keyed by file name (hash layout) or an array of frames with a "filename"
+   const Utils::JsonValue& Frames = Root["frames"];
+   if (Frames.IsObject()) {
+      for (const auto& [Name, Data] : Frames.Members()) AddFrame(Name, Data);
+   } else {
+      for (const Utils::JsonValue& Data : Frames.Elements()) AddFrame(Data["filename"].AsString(), Data);
+   }
+
+   for (const Utils::JsonValue& Data : Meta["frameTags"].Elements()) {
+      SpriteTag Tag;
+      Tag.Name = Data["name"].AsString();
+      Tag.From = std::clamp(static_cast<int>(Data["from"].AsNumber()), 0, std::max(0, GetFrameCount() - 1));
+      Tag.To = std::clamp(static_cast<int>(Data["to"].AsNumber()), Tag.From, std::max(0, GetFrameCount() - 1));
+      const std::string& Direction = Data["direction"].AsString();
+      if (Direction == "reverse") Tag.Direction = TagDirection::Reverse;
+      else if (Direction == "pingpong") Tag.Direction = TagDirection::PingPong;
+      m_Tags.push_back(std::move(Tag));
+   }
+
+   if (m_Frames.empty()) {
+      ECHO2D_LOG(WARNING) << "[Spritesheet] No frames in " << MetadataPath << "; using the whole image.";
+      m_Frames.push_back(SpriteFrame::FromRegion({0.0f, 0.0f, 1.0f, 1.0f}));
+   }
+
+   ECHO2D_LOG(INFO) << "[Spritesheet] Loaded " << m_Frames.size() << " frames and " << m_Tags.size() << " tags from "
+             << MetadataPath;
+   return true;
 }
 
 glm::vec4 Spritesheet::GetTexCoords(int i, int j) {
+   if (m_Columns == 0) {
+      // Atlases have no grid; i is the frame index
+      return i >= 0 && i < GetFrameCount() ? m_Frames[i].Bounds : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+   }
+   if (i >= 0 && i < m_Columns && j >= 0 && j * m_Columns + i < GetFrameCount()) {
+      return m_Frames[j * m_Columns + i].Bounds;
+   }
+
    float u = i * m_SpriteWidthRatio;
    float v = j * m_SpriteHeightRatio;
    return {u, v, m_SpriteWidthRatio, m_SpriteHeightRatio}; // (u, v, width, height)
 }
 
-Texture& Spritesheet::GetTex() {
-   return *m_TextureMap;
+int Spritesheet::GetFrameCount() const {
+   return static_cast<int>(m_Frames.size());
+}
+
+const SpriteFrame& Spritesheet::GetFrame(int Index) const {
+   return m_Frames[Index];
+}
+
+int Spritesheet::FindFrame(const std::string& Name) const {
+   auto It = m_FrameNames.find(Name);
+   return It == m_FrameNames.end() ? -1 : It->second;
 }
 
-void Spritesheet::SpriteUpdate(float dt) {
-   m_Timer += dt;
-   if (m_Timer >= m_FrameInterval) {
-      m_Count = (m_Count + 1) % m_SpriteAmount;
-      m_Timer = 0.0f;
+const SpriteTag* Spritesheet::FindTag(const std::string& Name) const {
+   for (const SpriteTag& Tag : m_Tags) {
+      if (Tag.Name == Name) return &Tag;
    }
+   return nullptr;
 }
 
-int Spritesheet::GetCount() {
-   return m_Count;
+const std::vector<SpriteTag>& Spritesheet::GetTags() const {
+   return m_Tags;
 }
 
-}; // namespace Echo2D
+Texture& Spritesheet::GetTex() {
+   return *m_TextureMap;
+}
 
+}; // namespace Echo2D
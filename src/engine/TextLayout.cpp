@@ -0,0 +1,209 @@
+#include <engine/TextLayout.h>
+#include <utils/Utils.h>
+#include <algorithm>
+#include <functional>
+
+namespace Echo2D {
+
+TextLayout::TextLayout(Font &Font, const std::string &Text, float Scale, float MaxWidth,
+                       TextAlign Align)
+   : m_Font(&Font), m_Text(Text), m_Scale(Scale), m_MaxWidth(MaxWidth), m_Align(Align) {
+   Build();
+}
+
+glm::vec2 TextLayout::GetSize() const { return m_Size; }
+
+size_t TextLayout::GetQuadCount() const { return m_Local.size() / 4; }
+
+const Font &TextLayout::GetFont() const { return *m_Font; }
+
+void TextLayout::Build() {
+   struct Item {
+      char32_t Codepoint;
+      Character Glyph;
+   };
+
+   // Resolving glyphs can evict atlas pages, which would invalidate UVs taken
+   // earlier in the same pass, so shape again if that happened.
+   std::vector<Item> Items;
+   for (int Attempt = 0; Attempt < 2; Attempt++) {
+      m_Generation = m_Font->GetGeneration();
+      Items.clear();
+      for (size_t i = 0; i < m_Text.size();) {
+         char32_t Codepoint = Utils::NextCodepoint(m_Text, i);
+         Items.push_back({Codepoint, m_Font->GetGlyph(Codepoint)});
+      }
+      if (m_Font->GetGeneration() == m_Generation) break;
+   }
+
+   auto Kerning = [&](size_t i, size_t LineStart) {
+      if (i == LineStart) return 0.0f;
+      return m_Font->GetKerning(Items[i - 1].Codepoint, Items[i].Codepoint) / 64.0f * m_Scale;
+   };
+   auto Advance = [&](size_t i) { return (Items[i].Glyph.m_Advance >> 6) * m_Scale; };
+
+   // Break into lines on '\n' and, when wrapping, at the last space that fits
+   std::vector<std::pair<size_t, size_t>> Lines;
+   size_t LineStart = 0;
+   size_t LastSpace = std::string::npos;
+   float x = 0.0f;
+   for (size_t i = 0; i < Items.size();) {
+      char32_t Codepoint = Items[i].Codepoint;
+      if (Codepoint == '\n') {
+         Lines.push_back({LineStart, i});
+         LineStart = ++i;
+         LastSpace = std::string::npos;
+         x = 0.0f;
+         continue;
+      }
+
+      float Step = Kerning(i, LineStart) + Advance(i);
+      if (m_MaxWidth > 0.0f && Codepoint != ' ' && x + Step > m_MaxWidth &&
+          LastSpace != std::string::npos) {
+         Lines.push_back({LineStart, LastSpace});
+         LineStart = i = LastSpace + 1;
+         LastSpace = std::string::npos;
+         x = 0.0f;
+         continue;
+      }
+
+      if (Codepoint == ' ') LastSpace = i;
+      x += Step;
+      i++;
+   }
+   Lines.push_back({LineStart, Items.size()});
+
+   std::vector<float> LineWidths;
+   float Widest = 0.0f;
+   for (const auto &[Start, End] : Lines) {
+      float Width = 0.0f;
+      for (size_t i = Start; i < End; i++) Width += Kerning(i, Start) + Advance(i);
+      LineWidths.push_back(Width);
+      Widest = std::max(Widest, Width);
+   }
+   float BlockWidth = m_MaxWidth > 0.0f ? m_MaxWidth : Widest;
+   float LineHeight = m_Font->GetLineHeight() * m_Scale;
+
+   m_DistanceField = m_Font->GetMode() == FontMode::SDF ? 1.0f : 0.0f;
+   m_Local.clear();
+   m_Runs.clear();
+
+   for (size_t Line = 0; Line < Lines.size(); Line++) {
+      auto [Start, End] = Lines[Line];
+      float PenX = 0.0f;
+      if (m_Align == TextAlign::Center) PenX = (BlockWidth - LineWidths[Line]) * 0.5f;
+      if (m_Align == TextAlign::Right) PenX = BlockWidth - LineWidths[Line];
+      float Baseline = Line * LineHeight;
+
+      for (size_t i = Start; i < End; i++) {
+         PenX += Kerning(i, Start);
+         const Character &ch = Items[i].Glyph;
+
+         if (ch.m_Atlas != nullptr) {
+            float xpos = PenX + ch.m_Bearing.x * m_Scale;
+            float ypos = Baseline - ch.m_Bearing.y * m_Scale;
+            float w = ch.m_Size.x * m_Scale;
+            float h = ch.m_Size.y * m_Scale;
+
+            glm::vec2 positions[4] = {{xpos, ypos}, {xpos + w, ypos},
+               {xpos + w, ypos + h}, {xpos, ypos + h}};
+            glm::vec4 UV = ch.m_UV;
+            glm::vec2 uvs[4] = {{UV.x, UV.y}, {UV.x + UV.z, UV.y},
+               {UV.x + UV.z, UV.y + UV.w}, {UV.x, UV.y + UV.w}};
+
+            for (int k = 0; k < 4; k++) {
+               Utils::Vertex vertex;
+               vertex.Position = {positions[k].x, positions[k].y, 0.0f};
+               vertex.Color = glm::vec4(1.0f);
+               vertex.TexCoords = uvs[k];
+               vertex.TextureIndex = -1.0f;
+               vertex.DistanceField = m_DistanceField;
+               m_Local.push_back(vertex);
+            }
+
+            size_t Quad = m_Local.size() / 4 - 1;
+            if (m_Runs.empty() || m_Runs.back().Atlas != ch.m_Atlas) {
+               m_Runs.push_back({ch.m_Atlas, m_Font->GetPageIndex(ch.m_Atlas), Quad, 0});
+            }
+            m_Runs.back().QuadCount++;
+         }
+
+         PenX += Advance(i);
+      }
+   }
+
+   m_Size = {Widest, LineHeight * Lines.size()};
+   m_Baked = m_Local;
+   m_BakedColor = glm::vec4(-1.0f);
+}
+
+const Utils::Vertex *TextLayout::Bake(size_t RunIndex, glm::vec2 Position, glm::vec4 Color,
+                                      float TextureIndex) {
+   if (!(Position == m_BakedPosition) || !(Color == m_BakedColor)) {
+      for (Run &run : m_Runs) run.BakedIndex = -2.0f;
+      m_BakedPosition = Position;
+      m_BakedColor = Color;
+   }
+
+   Run &run = m_Runs[RunIndex];
+   if (run.BakedIndex != TextureIndex) {
+      glm::vec4 Normalized = (1.0f / 255.0f) * Color;
+      for (size_t v = run.FirstQuad * 4; v < (run.FirstQuad + run.QuadCount) * 4; v++) {
+         m_Baked[v] = m_Local[v];
+         m_Baked[v].Position.x += Position.x;
+         m_Baked[v].Position.y += Position.y;
+         m_Baked[v].Color = Normalized;
+         m_Baked[v].TextureIndex = TextureIndex;
+      }
+      run.BakedIndex = TextureIndex;
+   }
+   return m_Baked.data() + run.FirstQuad * 4;
+}
+
+void TextLayout::Refresh() {
+   if (m_Font->GetGeneration() != m_Generation) {
+      Build();
+   }
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const KeyView &K) const {
+   size_t Hash = std::hash<std::string_view>()(K.Text);
+   auto Combine = [&Hash](size_t Value) {
+      Hash ^= Value + 0x9e3779b97f4a7c15ull + (Hash << 6) + (Hash >> 2);
+   };
+   Combine(std::hash<uint64_t>()(K.FontID));
+   Combine(std::hash<float>()(K.Scale));
+   Combine(std::hash<float>()(K.MaxWidth));
+   Combine(static_cast<size_t>(K.Align));
+   return Hash;
+}
+
+TextLayout &TextLayoutCache::Get(Font &Font, const std::string &Text, float Scale,
+                                 float MaxWidth, TextAlign Align) {
+   auto &Cache = GetInstance();
+   const KeyView View = {Font.GetID(), Scale, MaxWidth, Align, Text};
+
+   auto It = Cache.m_Index.find(View);
+   if (It != Cache.m_Index.end()) {
+      Cache.m_Entries.splice(Cache.m_Entries.begin(), Cache.m_Entries, It->second);
+      return It->second->Layout;
+   }
+
+   // Only a miss copies the string
+   Key K = {View.FontID, Scale, MaxWidth, Align, Text};
+   Cache.m_Entries.push_front({K, TextLayout(Font, Text, Scale, MaxWidth, Align)});
+   Cache.m_Index.emplace(std::move(K), Cache.m_Entries.begin());
+
+   if (Cache.m_Entries.size() > MAX_ENTRIES) {
+      Cache.m_Index.erase(Cache.m_Entries.back().EntryKey);
+      Cache.m_Entries.pop_back();
+   }
+   return Cache.m_Entries.front().Layout;
+}
+
+void TextLayoutCache::Clear() {
+   GetInstance().m_Index.clear();
+   GetInstance().m_Entries.clear();
+}
+
+} // namespace Echo2D
@@ -1,7 +1,14 @@
 #include <core/core.h>
 #include "external/stb_image.h"
+#include <engine/AssetArchive.h>
+#include <engine/AssetWatcher.h>
+#include <engine/Log.h>
+#include <engine/RenderThread.h>
 #include <engine/Texture.h>
-#include "external/easylogging++.h"
+#include <engine/TextureLoader.h>
+#include <engine/TextureResidency.h>
+
+#include <vector>
 
 namespace Echo2D {
 
@@ -10,65 +17,93 @@ namespace Echo2D {
  * 
  * This constructor loads the texture from the specified file using stb_image,
  * generates an OpenGL texture, and uploads the texture data to the GPU.
+ * When a mounted AssetArchive holds the path, its pre-decoded pixels are
+ * uploaded straight from the mapping instead.
  * The texture is configured with basic parameters (e.g., wrapping, filtering).
  * 
  * @param FilePath The path to the texture image file.
  */
 Texture::Texture(const char* FilePath) {
    if (!FilePath) {
-      LOG(ERROR) << "[Texture] File path for texture is null.";
+      ECHO2D_LOG(ERROR) << "[Texture] File path for texture is null.";
       return;
    }
 
-   // Load the image with stb_image. Force 4 channels (RGBA).
-   unsigned char* Pixels = stbi_load(FilePath, &m_Width, &m_Height, &m_Bits, 4);
+   const unsigned char* Pixels = nullptr;
+   unsigned char* Decoded = nullptr;
+   std::vector<unsigned char> Scratch;
+
+   const AssetArchive::Entry* Packed = AssetArchive::FindMounted(FilePath);
+   if (Packed && Packed->Type == ArchiveEntryType::Texture) {
+      Pixels = AssetArchive::View(*Packed, Scratch);
+      m_Width = Packed->Width;
+      m_Height = Packed->Height;
+      m_Bits = 4;
+   } else {
+      // Load the image with stb_image. Force 4 channels (RGBA).
+      Decoded = stbi_load(FilePath, &m_Width, &m_Height, &m_Bits, 4);
+      Pixels = Decoded;
+   }
 
    if (!Pixels) {
-      LOG(ERROR) << "[Texture] Could not load texture from file: " << FilePath;
+      ECHO2D_LOG(ERROR) << "[Texture] Could not load texture from file: " << FilePath;
       return;
    }
 
-   LOG(INFO) << "[Texture] Loaded texture from " << FilePath << " with dimensions: "
+   ECHO2D_LOG(INFO) << "[Texture] Loaded texture from " << FilePath << " with dimensions: "
              << m_Width << "x" << m_Height << " and " << m_Bits << " bits per channel.";
 
    // Generate an OpenGL texture object
    glGenTextures(1, &m_ID);
-   LOG(INFO) << "[Texture] glCreateTextures returned ID: " << m_ID;
+   ECHO2D_LOG(INFO) << "[Texture] glCreateTextures returned ID: " << m_ID;
 
    // Bind the texture to the 2D texture target
    glBindTexture(GL_TEXTURE_2D, m_ID);
-   LOG(INFO) << "[Texture] Bound texture ID: " << m_ID << " to GL_TEXTURE_2D.";
+   ECHO2D_LOG(INFO) << "[Texture] Bound texture ID: " << m_ID << " to GL_TEXTURE_2D.";
 
    // Set texture filtering and wrapping parameters
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-   LOG(INFO) << "[Texture] Texture parameters (MIN_FILTER, MAG_FILTER, WRAP_S, WRAP_T) set to GL_NEAREST and GL_CLAMP_TO_EDGE.";
+   ECHO2D_LOG(INFO) << "[Texture] Texture parameters (MIN_FILTER, MAG_FILTER, WRAP_S, WRAP_T) set to GL_NEAREST and GL_CLAMP_TO_EDGE.";
 
    // Upload the image data to the GPU
    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, Pixels);
-   LOG(INFO) << "[Texture] Texture image uploaded to GPU with dimensions: "
+   ECHO2D_LOG(INFO) << "[Texture] Texture image uploaded to GPU with dimensions: "
              << m_Width << "x" << m_Height;
 
    // Generate mipmaps for the texture
    glGenerateMipmap(GL_TEXTURE_2D);
-   LOG(INFO) << "[Texture] Mipmaps generated.";
+   ECHO2D_LOG(INFO) << "[Texture] Mipmaps generated.";
 
    // Free the image data after it's been uploaded to the GPU
-   stbi_image_free(Pixels);
-   LOG(INFO) << "[Texture] Image data freed from memory after upload.";
+   stbi_image_free(Decoded);
+   ECHO2D_LOG(INFO) << "[Texture] Image data freed from memory after upload.";
+
+   m_SourcePath = FilePath;
+   TextureResidency::Track(*this);
+   if (!Packed) {
+      WatchSource();
+   }
+}
+
+void Texture::WatchSource() {
+   // Nothing to do off the GL thread here: the loader's workers decode the new file
+   m_WatchID = AssetWatcher::Watch(m_SourcePath, [this]() -> AssetWatcher::Apply {
+      return [this] { TextureLoader::Refresh(*this); };
+   });
 }
 
-Texture::Texture(int width, int height, unsigned char* data) 
-    : m_Width(width), m_Height(height) {
+Texture::Texture(int width, int height, unsigned char* data, GLint filter) 
+    : m_Width(width), m_Height(height), m_Bits(1), m_Format(GL_RED) {
     
    glGenTextures(1, &m_ID);
    glBindTexture(GL_TEXTURE_2D, m_ID);
    glTexImage2D(
       GL_TEXTURE_2D,
       0,
-      GL_RGBA,
+      GL_R8,
       width,
       height,
       0,
@@ -83,14 +118,32 @@ Texture::Texture(int width, int height, unsigned char* data)
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+
+   TextureResidency::Track(*this);
+}
+
+void Texture::Update(int x, int y, int width, int height, const unsigned char* data, int rowLength) {
+   glBindTexture(GL_TEXTURE_2D, m_ID);
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+   glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, m_Format, GL_UNSIGNED_BYTE, data);
+   glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 }
 
 Texture::~Texture() {
-   LOG(INFO) << "[Texture] Deleting texture ID: " << m_ID;
-   glDeleteTextures(1, &m_ID);
-   LOG(INFO) << "[Texture] Texture ID: " << m_ID << " deleted from GPU memory.";
+   AssetWatcher::Unwatch(m_WatchID);
+   if (m_LoadID != 0) {
+      TextureLoader::Cancel(*this);
+   }
+   TextureResidency::Untrack(*this);
+   ECHO2D_LOG(INFO) << "[Texture] Deleting texture ID: " << m_ID;
+   // The render thread deletes it only once the frames that may still draw it are submitted
+   const bool Deferred = RenderThread::IsActive();
+   RenderThread::ReleaseTexture(m_ID);
+   ECHO2D_LOG(INFO) << "[Texture] Texture ID: " << m_ID
+                    << (Deferred ? " queued for deletion after in-flight frames." : " deleted from GPU memory.");
 }
 
 void Texture::Bind(GLuint slot) const {
@@ -98,7 +151,7 @@ void Texture::Bind(GLuint slot) const {
       glActiveTexture(GL_TEXTURE0 + slot);
       glBindTexture(GL_TEXTURE_2D, m_ID);
    } else {
-      LOG(WARNING) << "[Texture] Texture ID: " << m_ID << " is not a valid OpenGL texture.";
+      ECHO2D_LOG(WARNING) << "[Texture] Texture ID: " << m_ID << " is not a valid OpenGL texture.";
    }
 }
 
@@ -107,7 +160,7 @@ void Texture::Unbind(GLuint slot) const {
       glActiveTexture(GL_TEXTURE0 + slot);
       glBindTexture(GL_TEXTURE_2D, 0);
    } else {
-      LOG(WARNING) << "[Texture] Texture ID: " << m_ID << " is not a valid OpenGL texture.";
+      ECHO2D_LOG(WARNING) << "[Texture] Texture ID: " << m_ID << " is not a valid OpenGL texture.";
    }
 }
 
@@ -116,12 +169,16 @@ GLuint Texture::GetID() const {
 }
 
 int Texture::GetHeight() const { 
-   LOG(TRACE) << "[Texture] GetHeight called, returning height: " << m_Height;
+   ECHO2D_LOG(TRACE) << "[Texture] GetHeight called, returning height: " << m_Height;
    return m_Height; 
 }
 
+bool Texture::IsReady() const {
+   return m_Ready;
+}
+
 int Texture::GetWidth() const { 
-   LOG(TRACE) << "[Texture] GetWidth called, returning width: " << m_Width;
+   ECHO2D_LOG(TRACE) << "[Texture] GetWidth called, returning width: " << m_Width;
    return m_Width; 
 }
 
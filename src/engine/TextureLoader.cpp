@@ -0,0 +1,261 @@
+#include <core/core.h>
+#include "external/stb_image.h"
+#include <engine/AssetArchive.h>
+#include <engine/Log.h>
+#include <engine/RenderThread.h>
+#include <engine/TextureLoader.h>
+#include <engine/TextureResidency.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace Echo2D {
+
+Texture* TextureLoader::Load(const char* FilePath) {
+   Texture* Tex = new Texture();
+
+   if (!FilePath) {
+      ECHO2D_LOG(ERROR) << "[TextureLoader] File path for texture is null.";
+      return Tex;
+   }
+
+   Tex->m_SourcePath = FilePath;
+   GetInstance().Enqueue(*Tex);
+   Tex->WatchSource();
+   return Tex;
+}
+
+void TextureLoader::Reload(Texture& Tex) {
+   if (Tex.m_SourcePath.empty() || !Tex.m_Ready || Tex.m_LoadID != 0) return;
+   TextureResidency::Untrack(Tex);
+   RenderThread::ReleaseTexture(Tex.m_ID);
+   GetInstance().Enqueue(Tex);
+}
+
+void TextureLoader::Refresh(Texture& Tex) {
+   if (Tex.m_SourcePath.empty() || !Tex.m_Ready || Tex.m_LoadID != 0 || Tex.m_ID == 0) return;
+   GetInstance().Queue(Tex);
+}
+
+/**
+ * @brief Gives a texture its placeholder storage and queues its source file for decoding.
+ */
+void TextureLoader::Enqueue(Texture& Tex) {
+   // The placeholder is the texture itself at 1x1, so the renderer needs no special case
+   Tex.m_Ready = false;
+   Tex.m_Width = 1;
+   Tex.m_Height = 1;
+   Tex.m_Bits = 4;
+   glGenTextures(1, &Tex.m_ID);
+   glBindTexture(GL_TEXTURE_2D, Tex.m_ID);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_Placeholder);
+
+   Queue(Tex);
+}
+
+/**
+ * @brief Queues a texture's source file for decoding; the upload replaces its current storage.
+ */
+void TextureLoader::Queue(Texture& Tex) {
+   Tex.m_LoadID = m_NextID++;
+   m_Pending.emplace(Tex.m_LoadID, &Tex);
+
+   bool Spawn = false;
+   {
+      std::lock_guard<std::mutex> Lock(m_Mutex);
+      m_Requests.push_back({Tex.m_LoadID, Tex.m_SourcePath});
+      if (m_ActiveJobs < MAX_DECODE_JOBS) {
+         m_ActiveJobs++;
+         Spawn = true;
+      }
+   }
+   if (Spawn) {
+      JobSystem::Run([this]() { DecodeJob(); }, &m_DecodeJobs);
+   }
+}
+
+void TextureLoader::Update() {
+   Update(GetInstance().m_UploadBudget);
+}
+
+void TextureLoader::Update(double BudgetSeconds) {
+   auto& Loader = GetInstance();
+   using Clock = std::chrono::steady_clock;
+   const Clock::time_point Start = Clock::now();
+   bool Uploaded = false;
+
+   while (!Uploaded || std::chrono::duration<double>(Clock::now() - Start).count() < BudgetSeconds) {
+      Decoded Image;
+      {
+         std::lock_guard<std::mutex> Lock(Loader.m_Mutex);
+         if (Loader.m_Decoded.empty()) break;
+         Image = std::move(Loader.m_Decoded.front());
+         Loader.m_Decoded.pop_front();
+      }
+
+      auto It = Loader.m_Pending.find(Image.ID);
+      if (It != Loader.m_Pending.end()) {
+         Texture* Tex = It->second;
+         Loader.m_Pending.erase(It);
+         if (Image.Pixels) {
+            Loader.Upload(*Tex, Image);
+            Uploaded = true;
+         } else {
+            // A failed refresh leaves the texture showing its previous image
+            Tex->m_LoadID = 0;
+            ECHO2D_LOG(ERROR) << "[TextureLoader] Could not load texture from file: " << Image.FilePath;
+         }
+      }
+      stbi_image_free(Image.Owned);
+   }
+}
+
+/**
+ * @brief Streams one decoded image into its texture through the pixel buffer object.
+ *
+ * The buffer is orphaned before mapping, so the driver hands out fresh memory
+ * instead of waiting for the previous upload to finish, and the texture
+ * upload itself becomes an asynchronous copy out of the buffer.
+ */
+void TextureLoader::Upload(Texture& Tex, const Decoded& Image) {
+   const size_t Size = static_cast<size_t>(Image.Width) * Image.Height * 4;
+
+   if (m_PBO == 0) {
+      glGenBuffers(1, &m_PBO);
+   }
+   glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBO);
+   m_PBOSize = std::max(m_PBOSize, Size);
+   glBufferData(GL_PIXEL_UNPACK_BUFFER, m_PBOSize, nullptr, GL_STREAM_DRAW);
+
+   void* Mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, Size,
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+   const void* Source = nullptr; // offset 0 into the bound buffer
+   if (Mapped) {
+      std::memcpy(Mapped, Image.Pixels, Size);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+   } else {
+      // Mapping failed; fall back to a plain client-memory upload
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+      Source = Image.Pixels;
+   }
+
+   glBindTexture(GL_TEXTURE_2D, Tex.m_ID);
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, Image.Width, Image.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, Source);
+   glGenerateMipmap(GL_TEXTURE_2D);
+   glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+   Tex.m_Width = Image.Width;
+   Tex.m_Height = Image.Height;
+   Tex.m_Ready = true;
+   Tex.m_LoadID = 0;
+   TextureResidency::Track(Tex);
+
+   ECHO2D_LOG(INFO) << "[TextureLoader] Uploaded " << Image.FilePath << " (" << Image.Width << "x"
+             << Image.Height << ") to texture ID: " << Tex.m_ID;
+}
+
+void TextureLoader::SetUploadBudget(double Seconds) {
+   GetInstance().m_UploadBudget = std::max(0.0, Seconds);
+}
+
+void TextureLoader::SetPlaceholderColor(glm::vec4 Color) {
+   auto& Loader = GetInstance();
+   for (int i = 0; i < 4; i++) {
+      Loader.m_Placeholder[i] = static_cast<unsigned char>(std::clamp(Color[i], 0.0f, 255.0f));
+   }
+}
+
+size_t TextureLoader::GetPendingCount() {
+   return GetInstance().m_Pending.size();
+}
+
+void TextureLoader::Cancel(Texture& Tex) {
+   auto& Loader = GetInstance();
+   Loader.m_Pending.erase(Tex.m_LoadID);
+
+   // Skip the decode if no job picked it up yet; otherwise Update drops the result
+   std::lock_guard<std::mutex> Lock(Loader.m_Mutex);
+   std::erase_if(Loader.m_Requests, [&Tex](const Request& R) { return R.ID == Tex.m_LoadID; });
+}
+
+void TextureLoader::Shutdown() {
+   auto& Loader = GetInstance();
+   Loader.StopDecoding();
+
+   for (auto& [ID, Tex] : Loader.m_Pending) {
+      Tex->m_LoadID = 0;
+   }
+   Loader.m_Pending.clear();
+
+   if (Loader.m_PBO != 0) {
+      glDeleteBuffers(1, &Loader.m_PBO);
+      Loader.m_PBO = 0;
+      Loader.m_PBOSize = 0;
+   }
+}
+
+/**
+ * @brief Drops queued requests, waits for running decode jobs and frees their results.
+ */
+void TextureLoader::StopDecoding() {
+   {
+      std::lock_guard<std::mutex> Lock(m_Mutex);
+      m_Requests.clear();
+   }
+   if (!m_DecodeJobs.IsDone()) {
+      JobSystem::Wait(m_DecodeJobs);
+   }
+
+   for (Decoded& Image : m_Decoded) {
+      stbi_image_free(Image.Owned);
+   }
+   m_Decoded.clear();
+}
+
+/**
+ * @brief Decodes queued requests until none are left; runs on the JobSystem.
+ */
+void TextureLoader::DecodeJob() {
+   while (true) {
+      Request Job;
+      {
+         std::lock_guard<std::mutex> Lock(m_Mutex);
+         if (m_Requests.empty()) {
+            m_ActiveJobs--;
+            return;
+         }
+         Job = std::move(m_Requests.front());
+         m_Requests.pop_front();
+      }
+
+      Decoded Image = {Job.ID, std::move(Job.FilePath), nullptr, nullptr, {}, 0, 0};
+      const AssetArchive::Entry* Packed = AssetArchive::FindMounted(Image.FilePath);
+      if (Packed && Packed->Type == ArchiveEntryType::Texture) {
+         Image.Pixels = AssetArchive::View(*Packed, Image.Scratch);
+         Image.Width = Packed->Width;
+         Image.Height = Packed->Height;
+      } else {
+         // Force 4 channels (RGBA), like Texture(const char*)
+         int Channels = 0;
+         Image.Owned = stbi_load(Image.FilePath.c_str(), &Image.Width, &Image.Height, &Channels, 4);
+         Image.Pixels = Image.Owned;
+      }
+
+      std::lock_guard<std::mutex> Lock(m_Mutex);
+      m_Decoded.push_back(std::move(Image));
+   }
+}
+
+TextureLoader::~TextureLoader() {
+   // GL objects are left to the context if Shutdown() was never called
+   StopDecoding();
+}
+
+} // namespace Echo2D
@@ -0,0 +1,95 @@
+#include <core/core.h>
+#include <engine/RenderThread.h>
+#include <engine/Log.h>
+#include <engine/TextureLoader.h>
+#include <engine/TextureResidency.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Echo2D {
+
+void TextureResidency::SetBudget(size_t Bytes) {
+   GetInstance().m_Budget = Bytes;
+   ECHO2D_LOG(INFO) << "[TextureResidency] Budget set to " << (Bytes >> 20) << " MiB";
+}
+
+size_t TextureResidency::GetBudget() {
+   return GetInstance().m_Budget;
+}
+
+size_t TextureResidency::GetResidentBytes() {
+   return GetInstance().m_ResidentBytes;
+}
+
+uint64_t TextureResidency::GetFrame() {
+   return GetInstance().m_Frame;
+}
+
+void TextureResidency::Touch(Texture& Tex) {
+   Tex.m_LastUsedFrame = GetInstance().m_Frame;
+   if (Tex.m_ID == 0 && !Tex.m_SourcePath.empty()) {
+      ECHO2D_LOG(INFO) << "[TextureResidency] Restoring " << Tex.m_SourcePath;
+      TextureLoader::Reload(Tex);
+   }
+}
+
+void TextureResidency::Track(Texture& Tex) {
+   auto& Residency = GetInstance();
+   Untrack(Tex);
+
+   // File textures carry a full mip chain, which adds a third on top of level 0
+   size_t Bytes = static_cast<size_t>(Tex.m_Width) * Tex.m_Height * (Tex.m_Format == GL_RED ? 1 : 4);
+   if (!Tex.m_SourcePath.empty()) {
+      Bytes += Bytes / 3;
+      Residency.m_Evictable.insert(&Tex);
+   }
+   Tex.m_Bytes = Bytes;
+   Residency.m_ResidentBytes += Bytes;
+}
+
+void TextureResidency::Untrack(Texture& Tex) {
+   auto& Residency = GetInstance();
+   Residency.m_ResidentBytes -= Tex.m_Bytes;
+   Tex.m_Bytes = 0;
+   Residency.m_Evictable.erase(&Tex);
+}
+
+void TextureResidency::EndFrame() {
+   auto& Residency = GetInstance();
+
+   if (Residency.m_Budget != 0 && Residency.m_ResidentBytes > Residency.m_Budget) {
+      std::vector<Texture*> Candidates;
+      for (Texture* Tex : Residency.m_Evictable) {
+         if (Tex->m_Ready && Tex->m_LoadID == 0 && Tex->m_LastUsedFrame < Residency.m_Frame) {
+            Candidates.push_back(Tex);
+         }
+      }
+      std::sort(Candidates.begin(), Candidates.end(), [](const Texture* A, const Texture* B) {
+         return A->m_LastUsedFrame < B->m_LastUsedFrame;
+      });
+
+      for (Texture* Tex : Candidates) {
+         if (Residency.m_ResidentBytes <= Residency.m_Budget) break;
+         Residency.Evict(*Tex);
+      }
+
+      if (Residency.m_ResidentBytes > Residency.m_Budget && !Residency.m_OverBudget) {
+         ECHO2D_LOG(WARNING) << "[TextureResidency] Textures drawn this frame exceed the budget: "
+                      << (Residency.m_ResidentBytes >> 20) << " of " << (Residency.m_Budget >> 20) << " MiB";
+      }
+   }
+   Residency.m_OverBudget = Residency.m_Budget != 0 && Residency.m_ResidentBytes > Residency.m_Budget;
+
+   Residency.m_Frame++;
+}
+
+void TextureResidency::Evict(Texture& Tex) {
+   ECHO2D_LOG(INFO) << "[TextureResidency] Evicting " << Tex.m_SourcePath << " (" << (Tex.m_Bytes >> 10)
+             << " KiB, last drawn in frame " << Tex.m_LastUsedFrame << ")";
+   Untrack(Tex);
+   RenderThread::ReleaseTexture(Tex.m_ID);
+   Tex.m_ID = 0;
+}
+
+} // namespace Echo2D
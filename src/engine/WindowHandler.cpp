@@ -1,13 +1,14 @@
 #include "core/core.h"
 #include <engine/WindowHandler.h>
 #include <engine/InputHandler.h>
+#include <engine/Log.h>
+#include <engine/RenderThread.h>
 
 #include <cstdlib>
 
 #include "external/imgui.h"
 #include "external/imgui_impl_glfw.h"
 #include "external/imgui_impl_opengl3.h"
-#include "external/easylogging++.h"
 
 namespace Echo2D {
 
@@ -26,13 +27,13 @@ WindowHandler::~WindowHandler() {
    ImGui_ImplGlfw_Shutdown();
    ImGui::DestroyContext();
 
-   LOG(INFO) << "[WindowHandler] GLFW window destroyed and resources cleaned up.";
+   ECHO2D_LOG(INFO) << "[WindowHandler] GLFW window destroyed and resources cleaned up.";
 }
 
 void WindowHandler::Init() {
    // Initialize GLFW
    if (!glfwInit()) {
-      LOG(ERROR) << "[WindowHandler] Failed to initialize GLFW!";
+      ECHO2D_LOG(ERROR) << "[WindowHandler] Failed to initialize GLFW!";
       std::exit(EXIT_FAILURE);  ///< Exit if GLFW initialization fails
    }
 
@@ -45,21 +46,22 @@ void WindowHandler::Init() {
    glfwWindowHint(GLFW_POSITION_X, 0);  ///< Set window position
    glfwWindowHint(GLFW_POSITION_Y, 0);  ///< Set window position
 
-   glfwSwapInterval(0);  ///< Disable V-Sync
-
    // Create the GLFW window
    m_Window = glfwCreateWindow(m_Width, m_Height, m_Title, nullptr, nullptr);
    if (!m_Window) {
-      LOG(ERROR) << "[WindowHandler] Failed to create window!";
+      ECHO2D_LOG(ERROR) << "[WindowHandler] Failed to create window!";
       glfwTerminate();
       std::exit(EXIT_FAILURE);  ///< Exit if window creation fails
    }
 
-   LOG(INFO) << "[WindowHandler] Window created with dimensions: " << m_Width << "x" << m_Height;
+   ECHO2D_LOG(INFO) << "[WindowHandler] Window created with dimensions: " << m_Width << "x" << m_Height;
 
    // Make OpenGL context current for this window
    glfwMakeContextCurrent(m_Window);
 
+   // The swap interval belongs to the current context, so it can only be set now
+   SetVSync(VSyncMode::Off);
+
    // Initialize input handling (keyboard, mouse, etc.)
    InputHandler::Init(m_Window);
 
@@ -68,11 +70,11 @@ void WindowHandler::Init() {
 
    // Initialize GLAD to manage OpenGL function loading
    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-      LOG(ERROR) << "[WindowHandler] Failed to initialize GLAD!";
+      ECHO2D_LOG(ERROR) << "[WindowHandler] Failed to initialize GLAD!";
       std::exit(EXIT_FAILURE);  ///< Exit if GLAD initialization fails
    }
 
-   LOG(INFO) << "[WindowHandler] GLAD initialized successfully.";
+   ECHO2D_LOG(INFO) << "[WindowHandler] GLAD initialized successfully.";
 
    // Set the initial OpenGL viewport size
    glViewport(0, 0, m_Width, m_Height);
@@ -85,7 +87,7 @@ void WindowHandler::Init() {
    ImGui_ImplGlfw_InitForOpenGL(m_Window, true);
    ImGui_ImplOpenGL3_Init();
 
-   LOG(INFO) << "[WindowHandler] ImGui initialized successfully.";
+   ECHO2D_LOG(INFO) << "[WindowHandler] ImGui initialized successfully.";
 }
 
 void WindowHandler::ClearColor() {
@@ -100,6 +102,29 @@ void WindowHandler::SwapBuffers() {
    glfwSwapBuffers(m_Window);
 }
 
+void WindowHandler::SetVSync(VSyncMode Mode) {
+   int Interval = Mode == VSyncMode::Off ? 0 : 1;
+   if (Mode == VSyncMode::Adaptive) {
+      // Negative intervals tear instead of waiting a whole extra refresh when a frame is late
+      if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+         Interval = -1;
+      } else {
+         ECHO2D_LOG(WARNING) << "[WindowHandler] Adaptive V-Sync not supported; using V-Sync.";
+      }
+   }
+
+   if (RenderThread::IsActive()) {
+      RenderThread::SetSwapInterval(Interval);
+   } else {
+      glfwSwapInterval(Interval);
+   }
+   ECHO2D_LOG(INFO) << "[WindowHandler] Swap interval set to " << Interval;
+}
+
+GLFWwindow* WindowHandler::GetHandle() {
+   return m_Window;
+}
+
 bool WindowHandler::ShouldWindowClose() {
    bool shouldClose = glfwWindowShouldClose(m_Window);
    return shouldClose;
@@ -0,0 +1,249 @@
+#include <core/core.h>
+#include <engine/World.h>
+#include <engine/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Echo2D {
+
+/// Alignment of chunk allocations, so any component array can start on a cache line.
+static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+static size_t AlignUp(size_t Value, size_t Alignment) {
+   return (Value + Alignment - 1) / Alignment * Alignment;
+}
+
+std::vector<ComponentInfo>& ComponentRegistry::Infos() {
+   static std::vector<ComponentInfo> infos;
+   return infos;
+}
+
+ComponentID ComponentRegistry::Register(const ComponentInfo& Info) {
+   auto& Registered = Infos();
+   if (Registered.size() >= MAX_COMPONENTS) {
+      ECHO2D_LOG(FATAL) << "[World] More than " << MAX_COMPONENTS << " component types registered.";
+   }
+   Registered.push_back(Info);
+   return static_cast<ComponentID>(Registered.size() - 1);
+}
+
+const ComponentInfo& ComponentRegistry::Get(ComponentID ID) {
+   return Infos()[ID];
+}
+
+World::World() {
+   GetArchetype(0);
+}
+
+World::~World() {
+   Clear();
+}
+
+/**
+ * @brief Returns the archetype of a component set, creating it and laying out its chunks on first use.
+ */
+World::Archetype* World::GetArchetype(ComponentMask Mask) {
+   auto It = m_ArchetypeIndex.find(Mask);
+   if (It != m_ArchetypeIndex.end()) return It->second;
+
+   auto Type = std::make_unique<Archetype>();
+   Type->Mask = Mask;
+   std::fill(std::begin(Type->Column), std::end(Type->Column), UINT32_MAX);
+   size_t RowBytes = sizeof(Entity);
+   for (ComponentID ID = 0; ID < MAX_COMPONENTS; ID++) {
+      if (!(Mask & (ComponentMask(1) << ID))) continue;
+      Type->Column[ID] = static_cast<uint32_t>(Type->Types.size());
+      Type->Types.push_back(ID);
+      RowBytes += ComponentRegistry::Get(ID).Size;
+   }
+
+   // As many rows as fit a chunk once every array is aligned; big rows get a bigger chunk
+   uint32_t Capacity = static_cast<uint32_t>(std::max<size_t>(1, CHUNK_SIZE / RowBytes));
+   while (true) {
+      size_t Offset = AlignUp(sizeof(Entity) * Capacity, CHUNK_ALIGNMENT);
+      Type->Offsets.clear();
+      for (ComponentID ID : Type->Types) {
+         const ComponentInfo& Info = ComponentRegistry::Get(ID);
+         Offset = AlignUp(Offset, Info.Alignment);
+         Type->Offsets.push_back(Offset);
+         Offset += Info.Size * Capacity;
+      }
+      if (Offset <= CHUNK_SIZE || Capacity == 1) {
+         Type->ChunkBytes = std::max(Offset, sizeof(Entity));
+         break;
+      }
+      Capacity--;
+   }
+   Type->Capacity = Capacity;
+
+   Archetype* Created = Type.get();
+   m_Archetypes.push_back(std::move(Type));
+   m_ArchetypeIndex.emplace(Mask, Created);
+   return Created;
+}
+
+void* World::Slot(Archetype& Type, uint32_t Row, size_t ColumnIndex) const {
+   unsigned char* Chunk = Type.Chunks[Row / Type.Capacity];
+   const size_t Size = ComponentRegistry::Get(Type.Types[ColumnIndex]).Size;
+   return Chunk + Type.Offsets[ColumnIndex] + Size * (Row % Type.Capacity);
+}
+
+void* World::Column(const void* Type, unsigned char* Chunk, ComponentID ID) const {
+   const Archetype& Owner = *static_cast<const Archetype*>(Type);
+   if (ID >= MAX_COMPONENTS || Owner.Column[ID] == UINT32_MAX) return nullptr;
+   return Chunk + Owner.Offsets[Owner.Column[ID]];
+}
+
+void* World::Find(Entity Target, ComponentID ID) const {
+   if (!IsAlive(Target) || ID >= MAX_COMPONENTS) return nullptr;
+   const Record& Location = m_Records[Target.Index];
+   const uint32_t ColumnIndex = Location.Type->Column[ID];
+   if (ColumnIndex == UINT32_MAX) return nullptr;
+   return Slot(*Location.Type, Location.Row, ColumnIndex);
+}
+
+/**
+ * @brief Appends a row to an archetype, allocating a chunk when the last one is full.
+ */
+uint32_t World::AllocateRow(Archetype& Type, Entity Owner) {
+   const uint32_t Row = Type.Count++;
+   if (Row / Type.Capacity >= Type.Chunks.size()) {
+      Type.Chunks.push_back(
+         static_cast<unsigned char*>(::operator new(Type.ChunkBytes, std::align_val_t(CHUNK_ALIGNMENT))));
+   }
+   unsigned char* Chunk = Type.Chunks[Row / Type.Capacity];
+   std::memcpy(Chunk + sizeof(Entity) * (Row % Type.Capacity), &Owner, sizeof(Entity));
+   return Row;
+}
+
+/**
+ * @brief Removes a row whose components were already destroyed or moved out.
+ *
+ * The archetype's last row is moved into the hole, so its entity's record is
+ * updated; a chunk left empty is freed.
+ */
+void World::FreeRow(Archetype& Type, uint32_t Row) {
+   const uint32_t Last = --Type.Count;
+   if (Row != Last) {
+      for (size_t i = 0; i < Type.Types.size(); i++) {
+         const ComponentInfo& Info = ComponentRegistry::Get(Type.Types[i]);
+         void* From = Slot(Type, Last, i);
+         Info.MoveConstruct(Slot(Type, Row, i), From);
+         Info.Destroy(From);
+      }
+
+      Entity Moved;
+      std::memcpy(&Moved, Type.Chunks[Last / Type.Capacity] + sizeof(Entity) * (Last % Type.Capacity), sizeof(Entity));
+      std::memcpy(Type.Chunks[Row / Type.Capacity] + sizeof(Entity) * (Row % Type.Capacity), &Moved, sizeof(Entity));
+      m_Records[Moved.Index].Row = Row;
+   }
+
+   if (Type.Count <= (Type.Chunks.size() - 1) * Type.Capacity) {
+      ::operator delete(Type.Chunks.back(), std::align_val_t(CHUNK_ALIGNMENT));
+      Type.Chunks.pop_back();
+   }
+}
+
+void* World::MoveEntity(Entity Target, ComponentID ID, bool Add) {
+   if (!IsAlive(Target)) {
+      ECHO2D_LOG(FATAL) << "[World] Component change on a destroyed entity.";
+   }
+
+   Record& Location = m_Records[Target.Index];
+   Archetype& From = *Location.Type;
+   Archetype*& Edge = From.Edges[Add][ID];
+   if (!Edge) {
+      const ComponentMask Bit = ComponentMask(1) << ID;
+      Edge = GetArchetype(Add ? (From.Mask | Bit) : (From.Mask & ~Bit));
+   }
+   Archetype& To = *Edge;
+
+   const uint32_t OldRow = Location.Row;
+   const uint32_t NewRow = AllocateRow(To, Target);
+
+   // Components present in both archetypes move; a removed one is destroyed
+   for (size_t i = 0; i < From.Types.size(); i++) {
+      const ComponentInfo& Info = ComponentRegistry::Get(From.Types[i]);
+      void* Source = Slot(From, OldRow, i);
+      const uint32_t Destination = To.Column[From.Types[i]];
+      if (Destination != UINT32_MAX) Info.MoveConstruct(Slot(To, NewRow, Destination), Source);
+      Info.Destroy(Source);
+   }
+
+   FreeRow(From, OldRow);
+   Location.Type = &To;
+   Location.Row = NewRow;
+   return Add ? Slot(To, NewRow, To.Column[ID]) : nullptr;
+}
+
+Entity World::Create() {
+   uint32_t Index;
+   if (!m_FreeIndices.empty()) {
+      Index = m_FreeIndices.back();
+      m_FreeIndices.pop_back();
+   } else {
+      Index = static_cast<uint32_t>(m_Records.size());
+      m_Records.emplace_back();
+   }
+
+   Entity Created{Index, m_Records[Index].Generation};
+   Archetype& Empty = *m_ArchetypeIndex.at(0);
+   m_Records[Index].Type = &Empty;
+   m_Records[Index].Row = AllocateRow(Empty, Created);
+   m_Alive++;
+   return Created;
+}
+
+void World::Destroy(Entity Target) {
+   if (!IsAlive(Target)) return;
+
+   Record& Location = m_Records[Target.Index];
+   Archetype& Type = *Location.Type;
+   for (size_t i = 0; i < Type.Types.size(); i++) {
+      ComponentRegistry::Get(Type.Types[i]).Destroy(Slot(Type, Location.Row, i));
+   }
+   FreeRow(Type, Location.Row);
+
+   Location.Type = nullptr;
+   if (++Location.Generation == 0) Location.Generation = 1;
+   m_FreeIndices.push_back(Target.Index);
+   m_Alive--;
+}
+
+bool World::IsAlive(Entity Target) const {
+   return Target.Index < m_Records.size() && m_Records[Target.Index].Type != nullptr &&
+          m_Records[Target.Index].Generation == Target.Generation;
+}
+
+void World::Clear() {
+   for (const auto& Type : m_Archetypes) {
+      for (uint32_t Row = 0; Row < Type->Count; Row++) {
+         for (size_t i = 0; i < Type->Types.size(); i++) {
+            ComponentRegistry::Get(Type->Types[i]).Destroy(Slot(*Type, Row, i));
+         }
+      }
+      for (unsigned char* Chunk : Type->Chunks) ::operator delete(Chunk, std::align_val_t(CHUNK_ALIGNMENT));
+      Type->Chunks.clear();
+      Type->Count = 0;
+   }
+
+   m_FreeIndices.clear();
+   for (uint32_t i = 0; i < m_Records.size(); i++) {
+      Record& Location = m_Records[i];
+      if (Location.Type && ++Location.Generation == 0) Location.Generation = 1;
+      Location.Type = nullptr;
+      m_FreeIndices.push_back(static_cast<uint32_t>(m_Records.size()) - 1 - i);
+   }
+   m_Alive = 0;
+}
+
+size_t World::GetEntityCount() const {
+   return m_Alive;
+}
+
+size_t World::GetArchetypeCount() const {
+   return m_Archetypes.size();
+}
+
+} // namespace Echo2D
@@ -0,0 +1,253 @@
+#include <utils/Json.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace Utils {
+
+/**
+ * @brief Recursive-descent parser over a document held in memory.
+ */
+class JsonParser {
+public:
+   explicit JsonParser(const std::string& Text) : m_Text(Text) {}
+
+   bool ParseDocument(JsonValue& Out) {
+      if (!ParseValue(Out, 0)) return false;
+      SkipWhitespace();
+      return m_Pos == m_Text.size() || Fail("trailing characters");
+   }
+
+   std::string m_Error;
+
+private:
+   /// Nesting limit, so hostile input cannot overflow the stack.
+   static constexpr int MAX_DEPTH = 128;
+
+   const std::string& m_Text;
+   size_t m_Pos = 0;
+
+   bool Fail(const char* What) {
+      if (m_Error.empty()) m_Error = std::string(What) + " at offset " + std::to_string(m_Pos);
+      return false;
+   }
+
+   void SkipWhitespace() {
+      while (m_Pos < m_Text.size() &&
+             (m_Text[m_Pos] == ' ' || m_Text[m_Pos] == '\t' || m_Text[m_Pos] == '\n' || m_Text[m_Pos] == '\r')) {
+         m_Pos++;
+      }
+   }
+
+   bool Consume(const char* Literal) {
+      const size_t Length = std::strlen(Literal);
+      if (m_Text.compare(m_Pos, Length, Literal) != 0) return false;
+      m_Pos += Length;
+      return true;
+   }
+
+   bool ParseValue(JsonValue& Out, int Depth) {
+      if (Depth > MAX_DEPTH) return Fail("nesting too deep");
+      SkipWhitespace();
+      if (m_Pos >= m_Text.size()) return Fail("unexpected end");
+
+      switch (m_Text[m_Pos]) {
+      case '{': return ParseObject(Out, Depth);
+      case '[': return ParseArray(Out, Depth);
+      case '"':
+         Out.m_Type = JsonValue::Type::String;
+         return ParseString(Out.m_String);
+      case 't':
+      case 'f':
+         Out.m_Type = JsonValue::Type::Bool;
+         Out.m_Bool = m_Text[m_Pos] == 't';
+         return Consume(Out.m_Bool ? "true" : "false") || Fail("invalid literal");
+      case 'n':
+         Out.m_Type = JsonValue::Type::Null;
+         return Consume("null") || Fail("invalid literal");
+      default:
+         return ParseNumber(Out);
+      }
+   }
+
+   bool ParseObject(JsonValue& Out, int Depth) {
+      Out.m_Type = JsonValue::Type::Object;
+      m_Pos++;
+      SkipWhitespace();
+      if (m_Pos < m_Text.size() && m_Text[m_Pos] == '}') {
+         m_Pos++;
+         return true;
+      }
+
+      while (true) {
+         SkipWhitespace();
+         if (m_Pos >= m_Text.size() || m_Text[m_Pos] != '"') return Fail("expected member name");
+         Out.m_Members.emplace_back();
+         if (!ParseString(Out.m_Members.back().first)) return false;
+
+         SkipWhitespace();
+         if (m_Pos >= m_Text.size() || m_Text[m_Pos] != ':') return Fail("expected ':'");
+         m_Pos++;
+         if (!ParseValue(Out.m_Members.back().second, Depth + 1)) return false;
+
+         SkipWhitespace();
+         if (m_Pos >= m_Text.size()) return Fail("unterminated object");
+         if (m_Text[m_Pos] == '}') {
+            m_Pos++;
+            return true;
+         }
+         if (m_Text[m_Pos] != ',') return Fail("expected ',' or '}'");
+         m_Pos++;
+      }
+   }
+
+   bool ParseArray(JsonValue& Out, int Depth) {
+      Out.m_Type = JsonValue::Type::Array;
+      m_Pos++;
+      SkipWhitespace();
+      if (m_Pos < m_Text.size() && m_Text[m_Pos] == ']') {
+         m_Pos++;
+         return true;
+      }
+
+      while (true) {
+         Out.m_Elements.emplace_back();
+         if (!ParseValue(Out.m_Elements.back(), Depth + 1)) return false;
+
+         SkipWhitespace();
+         if (m_Pos >= m_Text.size()) return Fail("unterminated array");
+         if (m_Text[m_Pos] == ']') {
+            m_Pos++;
+            return true;
+         }
+         if (m_Text[m_Pos] != ',') return Fail("expected ',' or ']'");
+         m_Pos++;
+      }
+   }
+
+   bool ParseHex4(uint32_t& Out) {
+      if (m_Pos + 4 > m_Text.size()) return Fail("truncated escape");
+      Out = 0;
+      for (int i = 0; i < 4; i++) {
+         const char c = m_Text[m_Pos++];
+         Out <<= 4;
+         if (c >= '0' && c <= '9') Out |= c - '0';
+         else if (c >= 'a' && c <= 'f') Out |= c - 'a' + 10;
+         else if (c >= 'A' && c <= 'F') Out |= c - 'A' + 10;
+         else return Fail("invalid escape");
+      }
+      return true;
+   }
+
+   static void AppendUtf8(std::string& Out, uint32_t Codepoint) {
+      if (Codepoint < 0x80) {
+         Out += static_cast<char>(Codepoint);
+      } else if (Codepoint < 0x800) {
+         Out += static_cast<char>(0xC0 | (Codepoint >> 6));
+         Out += static_cast<char>(0x80 | (Codepoint & 0x3F));
+      } else if (Codepoint < 0x10000) {
+         Out += static_cast<char>(0xE0 | (Codepoint >> 12));
+         Out += static_cast<char>(0x80 | ((Codepoint >> 6) & 0x3F));
+         Out += static_cast<char>(0x80 | (Codepoint & 0x3F));
+      } else {
+         Out += static_cast<char>(0xF0 | (Codepoint >> 18));
+         Out += static_cast<char>(0x80 | ((Codepoint >> 12) & 0x3F));
+         Out += static_cast<char>(0x80 | ((Codepoint >> 6) & 0x3F));
+         Out += static_cast<char>(0x80 | (Codepoint & 0x3F));
+      }
+   }
+
+   bool ParseString(std::string& Out) {
+      m_Pos++; // Opening quote
+      while (m_Pos < m_Text.size()) {
+         const char c = m_Text[m_Pos++];
+         if (c == '"') return true;
+         if (static_cast<unsigned char>(c) < 0x20) return Fail("control character in string");
+         if (c != '\\') {
+            Out += c;
+            continue;
+         }
+
+         if (m_Pos >= m_Text.size()) break;
+         switch (m_Text[m_Pos++]) {
+         case '"': Out += '"'; break;
+         case '\\': Out += '\\'; break;
+         case '/': Out += '/'; break;
+         case 'b': Out += '\b'; break;
+         case 'f': Out += '\f'; break;
+         case 'n': Out += '\n'; break;
+         case 'r': Out += '\r'; break;
+         case 't': Out += '\t'; break;
+         case 'u': {
+            uint32_t Codepoint;
+            if (!ParseHex4(Codepoint)) return false;
+            // Surrogate pair
+            if (Codepoint >= 0xD800 && Codepoint <= 0xDBFF && Consume("\\u")) {
+               uint32_t Low;
+               if (!ParseHex4(Low)) return false;
+               Codepoint = Low >= 0xDC00 && Low <= 0xDFFF ? 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00)
+                                                          : 0xFFFD;
+            } else if (Codepoint >= 0xD800 && Codepoint <= 0xDFFF) {
+               Codepoint = 0xFFFD;
+            }
+            AppendUtf8(Out, Codepoint);
+            break;
+         }
+         default:
+            return Fail("invalid escape");
+         }
+      }
+      return Fail("unterminated string");
+   }
+
+   bool ParseNumber(JsonValue& Out) {
+      const char* Start = m_Text.c_str() + m_Pos;
+      if (*Start != '-' && (*Start < '0' || *Start > '9')) return Fail("unexpected character");
+
+      char* End = nullptr;
+      Out.m_Number = std::strtod(Start, &End);
+      if (End == Start) return Fail("invalid number");
+      Out.m_Type = JsonValue::Type::Number;
+      m_Pos += static_cast<size_t>(End - Start);
+      return true;
+   }
+};
+
+static const JsonValue& Null() {
+   static const JsonValue null;
+   return null;
+}
+
+bool JsonValue::Parse(const std::string& Text, JsonValue& Out, std::string* Error) {
+   Out = JsonValue();
+   JsonParser Parser(Text);
+   if (Parser.ParseDocument(Out)) return true;
+   if (Error) *Error = Parser.m_Error;
+   Out = JsonValue();
+   return false;
+}
+
+const std::string& JsonValue::AsString() const {
+   static const std::string empty;
+   return m_Type == Type::String ? m_String : empty;
+}
+
+size_t JsonValue::Size() const {
+   if (m_Type == Type::Array) return m_Elements.size();
+   if (m_Type == Type::Object) return m_Members.size();
+   return 0;
+}
+
+const JsonValue& JsonValue::operator[](size_t Index) const {
+   return m_Type == Type::Array && Index < m_Elements.size() ? m_Elements[Index] : Null();
+}
+
+const JsonValue& JsonValue::operator[](const std::string& Key) const {
+   for (const auto& [Name, Value] : m_Members) {
+      if (Name == Key) return Value;
+   }
+   return Null();
+}
+
+}
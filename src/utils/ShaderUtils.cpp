@@ -1,72 +1,278 @@
 #include "core/core.h"
 #include "external/glad.h"
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <utils/ShaderUtils.h>
+#include <engine/AssetArchive.h>
+#include <engine/AssetWatcher.h>
+#include <utils/Utils.h>
+#include "EmbeddedShaders.h"
 namespace Utils {
 
-Shader::Shader(const char *VertexPath, const char *FragmentPath) {
-   // 1. retrieve the vertex/fragment source code from filePath
+/// Directory linked program binaries are cached in; empty disables the cache.
+static std::string &CacheDirectory() {
+   static std::string directory = ".echo2d_cache";
+   return directory;
+}
+
+static constexpr char BINARY_MAGIC[8] = {'E', '2', 'D', 'P', 'R', 'O', 'G', '\0'};
+static constexpr uint32_t BINARY_VERSION = 1;
+
+/**
+ * @brief Finds a shader source: mounted archives first, then the file system,
+ * then the sources embedded into the library at build time.
+ *
+ * @param FromDisk Set when the source came from a loose file (and can be watched).
+ * @return false if no source exists under Path.
+ */
+static bool ReadSource(const char *Path, std::string &Source, bool &FromDisk) {
+   FromDisk = false;
+
+   if (const Echo2D::AssetArchive::Entry *Packed = Echo2D::AssetArchive::FindMounted(Path)) {
+      std::vector<unsigned char> Scratch;
+      const unsigned char *Data = Echo2D::AssetArchive::View(*Packed, Scratch);
+      if (!Data) return false;
+      Source.assign(reinterpret_cast<const char *>(Data), Packed->Size);
+      return true;
+   }
+
+   std::ifstream file(Path);
+   if (file) {
+      std::stringstream stream;
+      stream << file.rdbuf();
+      Source = stream.str();
+      FromDisk = true;
+      return true;
+   }
+
+   const std::string name = Echo2D::AssetArchive::NormalizeName(Path);
+   for (const Embedded::ShaderSource &embedded : Embedded::SHADERS) {
+      if (name == embedded.Path) {
+         Source = embedded.Source;
+         return true;
+      }
+   }
+   return false;
+}
+
+Shader::Shader(const char *VertexPath, const char *FragmentPath)
+   : m_VertexPath(VertexPath), m_FragmentPath(FragmentPath) {
+   // 1. retrieve the vertex/fragment source code
    std::string vertexCode;
    std::string fragmentCode;
-   std::ifstream vShaderFile;
-   std::ifstream fShaderFile;
-   // ensure ifstream objects can throw exceptions:
-   vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-   fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-   try {
-      // open files
-      vShaderFile.open(VertexPath);
-      fShaderFile.open(FragmentPath);
-      std::stringstream vShaderStream, fShaderStream;
-      // read file's buffer contents into streams
-      vShaderStream << vShaderFile.rdbuf();
-      fShaderStream << fShaderFile.rdbuf();
-      // close file handlers
-      vShaderFile.close();
-      fShaderFile.close();
-      // convert stream into string
-      vertexCode = vShaderStream.str();
-      fragmentCode = fShaderStream.str();
-   } catch (std::ifstream::failure &e) {
-      std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what()
+   bool vertexOnDisk = false;
+   bool fragmentOnDisk = false;
+   if (!ReadSource(VertexPath, vertexCode, vertexOnDisk) ||
+       !ReadSource(FragmentPath, fragmentCode, fragmentOnDisk)) {
+      std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << VertexPath << " / " << FragmentPath
          << std::endl;
    }
-   const char *vShaderCode = vertexCode.c_str();
-   const char *fShaderCode = fragmentCode.c_str();
-   // 2. compile shaders
+
+   // 2. recompile whenever either file changes on disk
+   if (vertexOnDisk && fragmentOnDisk) {
+      WatchSources();
+   }
+   // 3. compile shaders, or load the program linked by a previous run
+   Build(vertexCode, fragmentCode, ID);
+}
+
+void Shader::SetCacheDirectory(const std::string &Directory) {
+   CacheDirectory() = Directory;
+}
+
+/**
+ * @brief Compiles and links a program from vertex and fragment source.
+ *
+ * Linked programs are cached with glGetProgramBinary, keyed by both sources
+ * and the driver's vendor, renderer and version strings, so later runs on
+ * the same machine skip compilation entirely.
+ *
+ * @param Program Receives the program object, even if it failed to link.
+ * @return true if both stages compiled and the program linked.
+ */
+bool Shader::Build(const std::string &VertexCode, const std::string &FragmentCode, GLuint &Program) {
+   const std::string cachePath = BinaryCachePath(VertexCode, FragmentCode);
+   if (!cachePath.empty() && LoadBinary(cachePath, Program)) {
+      return true;
+   }
+
+   const char *vShaderCode = VertexCode.c_str();
+   const char *fShaderCode = FragmentCode.c_str();
    unsigned int vertex, fragment;
    // vertex shader
    vertex = glCreateShader(GL_VERTEX_SHADER);
    glShaderSource(vertex, 1, &vShaderCode, NULL);
    glCompileShader(vertex);
-   CheckCompileErrors(vertex, "VERTEX");
+   bool success = CheckCompileErrors(vertex, "VERTEX");
    // fragment Shader
    fragment = glCreateShader(GL_FRAGMENT_SHADER);
    glShaderSource(fragment, 1, &fShaderCode, NULL);
    glCompileShader(fragment);
-   CheckCompileErrors(fragment, "FRAGMENT");
+   success = CheckCompileErrors(fragment, "FRAGMENT") && success;
    // shader Program
-   ID = glCreateProgram();
-   glAttachShader(ID, vertex);
-   glAttachShader(ID, fragment);
-   glLinkProgram(ID);
-   CheckCompileErrors(ID, "PROGRAM");
+   Program = glCreateProgram();
+   if (!cachePath.empty()) {
+      glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+   }
+   glAttachShader(Program, vertex);
+   glAttachShader(Program, fragment);
+   glLinkProgram(Program);
+   success = CheckCompileErrors(Program, "PROGRAM") && success;
    // delete the shaders as they're linked into our program now and no longer
    // necessary
    glDeleteShader(vertex);
    glDeleteShader(fragment);
+
+   if (success && !cachePath.empty()) {
+      SaveBinary(cachePath, Program);
+   }
+   return success;
 }
 
-Shader::~Shader() {
+/**
+ * @brief Path of the cached binary for a pair of sources on the current driver.
+ * @return Empty when caching is disabled or the driver offers no binary formats.
+ */
+std::string Shader::BinaryCachePath(const std::string &VertexCode, const std::string &FragmentCode) {
+   if (CacheDirectory().empty()) return "";
+
+   GLint formats = 0;
+   glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+   if (formats <= 0) return "";
 
+   uint64_t hash = HashBytes(VertexCode.data(), VertexCode.size() + 1);
+   hash = HashBytes(FragmentCode.data(), FragmentCode.size() + 1, hash);
+   for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+      const char *value = reinterpret_cast<const char *>(glGetString(name));
+      if (value) hash = HashBytes(value, std::strlen(value) + 1, hash);
+   }
+
+   std::ostringstream file;
+   file << std::hex << hash << ".e2dprog";
+   return (std::filesystem::path(CacheDirectory()) / file.str()).string();
+}
+
+/**
+ * @brief Creates Program from a cached binary.
+ *
+ * A binary the driver rejects (e.g. after a driver update that kept its
+ * version string) is deleted, and the caller compiles from source.
+ */
+bool Shader::LoadBinary(const std::string &Path, GLuint &Program) {
+   std::ifstream file(Path, std::ios::binary | std::ios::ate);
+   if (!file) return false;
+   std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+   file.seekg(0);
+   if (!file.read(buffer.data(), buffer.size())) return false;
+
+   const size_t headerSize = sizeof(BINARY_MAGIC) + 3 * sizeof(uint32_t);
+   uint32_t version, format, length;
+   if (buffer.size() < headerSize || std::memcmp(buffer.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+      return false;
+   }
+   std::memcpy(&version, buffer.data() + sizeof(BINARY_MAGIC), sizeof(version));
+   std::memcpy(&format, buffer.data() + sizeof(BINARY_MAGIC) + 4, sizeof(format));
+   std::memcpy(&length, buffer.data() + sizeof(BINARY_MAGIC) + 8, sizeof(length));
+   if (version != BINARY_VERSION || length != buffer.size() - headerSize) return false;
+
+   Program = glCreateProgram();
+   glProgramBinary(Program, format, buffer.data() + headerSize, static_cast<GLsizei>(length));
+   GLint linked = GL_FALSE;
+   glGetProgramiv(Program, GL_LINK_STATUS, &linked);
+   if (!linked) {
+      glDeleteProgram(Program);
+      Program = 0;
+      std::error_code error;
+      std::filesystem::remove(Path, error);
+      return false;
+   }
+   return true;
+}
+
+/**
+ * @brief Writes a linked program's binary to the cache, through a temporary file.
+ */
+void Shader::SaveBinary(const std::string &Path, GLuint Program) {
+   GLint length = 0;
+   glGetProgramiv(Program, GL_PROGRAM_BINARY_LENGTH, &length);
+   if (length <= 0) return;
+
+   std::vector<char> binary(length);
+   GLenum format = 0;
+   glGetProgramBinary(Program, length, &length, &format, binary.data());
+
+   std::error_code error;
+   std::filesystem::create_directories(CacheDirectory(), error);
+   const std::string temporary = Path + ".tmp";
+   {
+      std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+      const uint32_t header[3] = {BINARY_VERSION, static_cast<uint32_t>(format), static_cast<uint32_t>(length)};
+      file.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+      file.write(reinterpret_cast<const char *>(header), sizeof(header));
+      file.write(binary.data(), length);
+      if (!file) return;
+   }
+   std::filesystem::rename(temporary, Path, error);
+}
+
+/**
+ * @brief Registers both source files with the AssetWatcher.
+ *
+ * The sources are read on the watcher thread; compiling needs the GL context,
+ * so it happens at the frame boundary, and a program that fails to build is
+ * discarded while the previous one stays in use.
+ */
+void Shader::WatchSources() {
+   const std::string vertexPath = m_VertexPath;
+   const std::string fragmentPath = m_FragmentPath;
+   auto onChange = [this, vertexPath, fragmentPath]() -> Echo2D::AssetWatcher::Apply {
+      std::ifstream vShaderFile(vertexPath);
+      std::ifstream fShaderFile(fragmentPath);
+      if (!vShaderFile || !fShaderFile) return {};
+      std::stringstream vShaderStream, fShaderStream;
+      vShaderStream << vShaderFile.rdbuf();
+      fShaderStream << fShaderFile.rdbuf();
+
+      return [this, vertexCode = vShaderStream.str(), fragmentCode = fShaderStream.str()] {
+         Reload(vertexCode, fragmentCode);
+      };
+   };
+   m_WatchIDs[0] = Echo2D::AssetWatcher::Watch(vertexPath, onChange);
+   m_WatchIDs[1] = Echo2D::AssetWatcher::Watch(fragmentPath, onChange);
+}
+
+bool Shader::Reload(const std::string &VertexCode, const std::string &FragmentCode) {
+   GLuint program;
+   if (!Build(VertexCode, FragmentCode, program)) {
+      glDeleteProgram(program);
+      std::cout << "ERROR::SHADER::RELOAD_FAILED: keeping the previous program of "
+         << m_VertexPath << " / " << m_FragmentPath << std::endl;
+      return false;
+   }
+
+   glDeleteProgram(ID);
+   ID = program;
+   m_Generation++;
+   std::cout << "Shader reloaded: " << m_VertexPath << " / " << m_FragmentPath << std::endl;
+   return true;
+}
+
+uint32_t Shader::GetGeneration() const { return m_Generation; }
+
+Shader::~Shader() {
+   Echo2D::AssetWatcher::Unwatch(m_WatchIDs[0]);
+   Echo2D::AssetWatcher::Unwatch(m_WatchIDs[1]);
+   glDeleteProgram(ID);
 }
 
-void Shader::CheckCompileErrors(GLuint Shader, std::string Type) {
+bool Shader::CheckCompileErrors(GLuint Shader, std::string Type) {
    int success;
    char infoLog[1024];
    if (Type != "PROGRAM") {
@@ -90,6 +296,7 @@ void Shader::CheckCompileErrors(GLuint Shader, std::string Type) {
             << std::endl;
       }
    }
+   return success != 0;
 }
 
 void Shader::Use() { glUseProgram(this->ID); }
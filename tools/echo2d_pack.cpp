@@ -0,0 +1,282 @@
+/**
+ * @file echo2d_pack.cpp
+ * @brief Offline tool that bakes a directory of loose assets into an Echo2D asset archive.
+ *
+ * Usage: echo2d_pack <input-dir> <output.e2dpak> [--lz4] [--font <path>:<size>[:sdf]]...
+ *
+ * Images are decoded to RGBA8 so the game uploads them without running
+ * stb_image, shaders and other files are stored verbatim, and every --font
+ * adds a pre-rasterized printable ASCII atlas for that font, size and mode.
+ * Entry names are the file paths relative to the input directory, so running
+ * the game from that directory with the archive mounted finds the same assets
+ * it would have loaded from disk.
+ */
+
+#include <engine/AssetArchive.h>
+#include <engine/Font.h>
+#include "external/easylogging++.h"
+#include "external/stb_image.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef ECHO2D_WITH_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+
+using namespace Echo2D;
+namespace fs = std::filesystem;
+
+struct PackedEntry {
+   std::string Name;
+   ArchiveEntryType Type;
+   std::vector<unsigned char> Bytes;
+   uint32_t Width = 0;
+   uint32_t Height = 0;
+   bool Compressible = true;
+};
+
+struct FontRequest {
+   std::string Path;
+   GLuint Size;
+   FontMode Mode;
+};
+
+static std::string Lowercase(std::string Text) {
+   std::transform(Text.begin(), Text.end(), Text.begin(), [](unsigned char c) { return std::tolower(c); });
+   return Text;
+}
+
+static bool ReadFile(const fs::path& Path, std::vector<unsigned char>& Bytes) {
+   std::ifstream File(Path, std::ios::binary | std::ios::ate);
+   if (!File) return false;
+   Bytes.resize(static_cast<size_t>(File.tellg()));
+   File.seekg(0);
+   return static_cast<bool>(File.read(reinterpret_cast<char*>(Bytes.data()), Bytes.size()));
+}
+
+static bool ParseFont(const std::string& Argument, FontRequest& Request) {
+   size_t First = Argument.find(':');
+   if (First == std::string::npos) return false;
+   size_t Second = Argument.find(':', First + 1);
+
+   Request.Path = Argument.substr(0, First);
+   Request.Size = static_cast<GLuint>(std::atoi(Argument.substr(First + 1, Second - First - 1).c_str()));
+   Request.Mode = FontMode::Bitmap;
+   if (Second != std::string::npos) {
+      std::string Mode = Lowercase(Argument.substr(Second + 1));
+      if (Mode == "sdf") Request.Mode = FontMode::SDF;
+      else if (Mode != "bitmap") return false;
+   }
+   return Request.Size > 0;
+}
+
+/**
+ * @brief Loads one file into an entry of the type its extension calls for.
+ */
+static bool PackFile(const fs::path& Path, const std::string& Name, PackedEntry& Entry) {
+   std::string Extension = Lowercase(Path.extension().string());
+   Entry.Name = Name;
+
+   if (Extension == ".png" || Extension == ".jpg" || Extension == ".jpeg" || Extension == ".bmp" ||
+       Extension == ".tga") {
+      int Width, Height, Channels;
+      unsigned char* Pixels = stbi_load(Path.string().c_str(), &Width, &Height, &Channels, STBI_rgb_alpha);
+      if (!Pixels) {
+         std::cerr << "echo2d_pack: could not decode " << Path << ": " << stbi_failure_reason() << "\n";
+         return false;
+      }
+      Entry.Type = ArchiveEntryType::Texture;
+      Entry.Width = static_cast<uint32_t>(Width);
+      Entry.Height = static_cast<uint32_t>(Height);
+      Entry.Bytes.assign(Pixels, Pixels + static_cast<size_t>(Width) * Height * 4);
+      stbi_image_free(Pixels);
+      return true;
+   }
+
+   if (!ReadFile(Path, Entry.Bytes)) {
+      std::cerr << "echo2d_pack: could not read " << Path << "\n";
+      return false;
+   }
+   if (Extension == ".glsl" || Extension == ".vert" || Extension == ".frag") {
+      Entry.Type = ArchiveEntryType::Shader;
+   } else {
+      Entry.Type = ArchiveEntryType::Raw;
+      // Fonts are handed to FreeType straight from the mapping, so keep them uncompressed
+      Entry.Compressible = Extension != ".ttf" && Extension != ".otf";
+   }
+   return true;
+}
+
+/**
+ * @brief Compresses an entry with LZ4 HC, keeping the result only if it is smaller.
+ * @return Whether the stored bytes were replaced by an LZ4 block.
+ */
+static bool Compress(std::vector<unsigned char>& Bytes) {
+#ifdef ECHO2D_WITH_LZ4
+   if (Bytes.empty() || Bytes.size() > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) return false;
+   std::vector<unsigned char> Compressed(LZ4_compressBound(static_cast<int>(Bytes.size())));
+   int Written = LZ4_compress_HC(reinterpret_cast<const char*>(Bytes.data()), reinterpret_cast<char*>(Compressed.data()),
+                                 static_cast<int>(Bytes.size()), static_cast<int>(Compressed.size()), LZ4HC_CLEVEL_MAX);
+   if (Written <= 0 || static_cast<size_t>(Written) >= Bytes.size()) return false;
+   Compressed.resize(Written);
+   Bytes.swap(Compressed);
+   return true;
+#else
+   (void)Bytes;
+   return false;
+#endif
+}
+
+static void Pad(std::ofstream& Out, uint64_t& Offset) {
+   static const char Zeros[AssetArchive::DATA_ALIGNMENT] = {};
+   uint64_t Padding = (AssetArchive::DATA_ALIGNMENT - Offset % AssetArchive::DATA_ALIGNMENT) % AssetArchive::DATA_ALIGNMENT;
+   Out.write(Zeros, static_cast<std::streamsize>(Padding));
+   Offset += Padding;
+}
+
+int main(int argc, char** argv) {
+   el::Loggers::reconfigureAllLoggers(el::ConfigurationType::ToFile, "false");
+
+   if (argc < 3) {
+      std::cerr << "usage: echo2d_pack <input-dir> <output.e2dpak> [--lz4] [--font <path>:<size>[:sdf]]...\n";
+      return 1;
+   }
+
+   fs::path Input = argv[1];
+   fs::path Output = argv[2];
+   bool UseLZ4 = false;
+   std::vector<FontRequest> Fonts;
+   for (int i = 3; i < argc; i++) {
+      std::string Argument = argv[i];
+      FontRequest Request;
+      if (Argument == "--lz4") {
+         UseLZ4 = true;
+      } else if (Argument == "--font" && i + 1 < argc && ParseFont(argv[i + 1], Request)) {
+         Fonts.push_back(Request);
+         i++;
+      } else {
+         std::cerr << "echo2d_pack: bad argument " << Argument << "\n";
+         return 1;
+      }
+   }
+#ifndef ECHO2D_WITH_LZ4
+   if (UseLZ4) {
+      std::cerr << "echo2d_pack: built without LZ4, writing uncompressed entries\n";
+      UseLZ4 = false;
+   }
+#endif
+
+   if (!fs::is_directory(Input)) {
+      std::cerr << "echo2d_pack: " << Input << " is not a directory\n";
+      return 1;
+   }
+
+   // Sorted, so the same input always produces the same archive
+   std::vector<fs::path> Files;
+   for (auto It = fs::recursive_directory_iterator(Input); It != fs::recursive_directory_iterator(); ++It) {
+      if (It->path().filename().string().front() == '.') {
+         if (It->is_directory()) It.disable_recursion_pending();
+         continue;
+      }
+      if (It->is_regular_file() && fs::absolute(It->path()) != fs::absolute(Output)) Files.push_back(It->path());
+   }
+   std::sort(Files.begin(), Files.end());
+
+   std::vector<PackedEntry> Entries;
+   for (const fs::path& File : Files) {
+      PackedEntry Entry;
+      if (!PackFile(File, AssetArchive::NormalizeName(fs::relative(File, Input).generic_string()), Entry)) return 1;
+      Entries.push_back(std::move(Entry));
+   }
+
+   std::string Ascii;
+   for (char c = 32; c < 127; c++) Ascii.push_back(c);
+   for (const FontRequest& Request : Fonts) {
+      std::vector<unsigned char> FontData;
+      if (!ReadFile(Input / Request.Path, FontData)) {
+         std::cerr << "echo2d_pack: could not read font " << Request.Path << "\n";
+         return 1;
+      }
+      std::string Blob;
+      if (!Font::Bake(FontData.data(), FontData.size(), Request.Size, Request.Mode, Ascii, Blob)) {
+         std::cerr << "echo2d_pack: could not bake font " << Request.Path << "\n";
+         return 1;
+      }
+      PackedEntry Entry;
+      Entry.Name = Font::GetArchiveEntryName(Request.Path, Request.Size, Request.Mode);
+      Entry.Type = ArchiveEntryType::FontAtlas;
+      Entry.Bytes.assign(Blob.begin(), Blob.end());
+      Entries.push_back(std::move(Entry));
+   }
+
+   std::ofstream Out(Output, std::ios::binary | std::ios::trunc);
+   if (!Out) {
+      std::cerr << "echo2d_pack: could not write " << Output << "\n";
+      return 1;
+   }
+
+   AssetArchive::Header Head = {};
+   std::memcpy(Head.Magic, AssetArchive::MAGIC, sizeof(Head.Magic));
+   Head.Version = AssetArchive::VERSION;
+   Head.EntryCount = static_cast<uint32_t>(Entries.size());
+   Out.write(reinterpret_cast<const char*>(&Head), sizeof(Head));
+   uint64_t Offset = sizeof(Head);
+
+   std::vector<AssetArchive::TocEntry> Toc;
+   std::string Names;
+   uint64_t RawBytes = 0;
+   for (PackedEntry& Entry : Entries) {
+      AssetArchive::TocEntry Record = {};
+      Record.Type = static_cast<uint32_t>(Entry.Type);
+      Record.Size = Entry.Bytes.size();
+      Record.Width = Entry.Width;
+      Record.Height = Entry.Height;
+      Record.NameOffset = Names.size();
+      Record.NameLength = Entry.Name.size();
+      Names += Entry.Name;
+      RawBytes += Entry.Bytes.size();
+
+      if (UseLZ4 && Entry.Compressible && Compress(Entry.Bytes)) Record.Flags |= AssetArchive::FLAG_LZ4;
+      Record.StoredSize = Entry.Bytes.size();
+
+      Pad(Out, Offset);
+      Record.DataOffset = Offset;
+      Out.write(reinterpret_cast<const char*>(Entry.Bytes.data()), static_cast<std::streamsize>(Entry.Bytes.size()));
+      Offset += Entry.Bytes.size();
+      Toc.push_back(Record);
+   }
+
+   Pad(Out, Offset);
+   Head.TocOffset = Offset;
+   Out.write(reinterpret_cast<const char*>(Toc.data()), static_cast<std::streamsize>(Toc.size() * sizeof(Toc[0])));
+   Offset += Toc.size() * sizeof(Toc[0]);
+   Head.NamesOffset = Offset;
+   Head.NamesSize = Names.size();
+   Out.write(Names.data(), static_cast<std::streamsize>(Names.size()));
+   Offset += Names.size();
+
+   Out.seekp(0);
+   Out.write(reinterpret_cast<const char*>(&Head), sizeof(Head));
+   if (!Out.flush()) {
+      std::cerr << "echo2d_pack: failed writing " << Output << "\n";
+      return 1;
+   }
+
+   for (size_t i = 0; i < Entries.size(); i++) {
+      std::printf("  %-48s %8llu -> %8llu bytes%s\n", Entries[i].Name.c_str(),
+                  static_cast<unsigned long long>(Toc[i].Size), static_cast<unsigned long long>(Toc[i].StoredSize),
+                  (Toc[i].Flags & AssetArchive::FLAG_LZ4) ? " (lz4)" : "");
+   }
+   std::printf("echo2d_pack: wrote %zu entries, %llu bytes (%llu before compression) to %s\n", Entries.size(),
+               static_cast<unsigned long long>(Offset), static_cast<unsigned long long>(RawBytes),
+               Output.string().c_str());
+   return 0;
+}